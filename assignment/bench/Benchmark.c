@@ -0,0 +1,353 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/time.h>
+#include <sys/wait.h>
+#include <z3.h>
+#include <Graph.h>
+#include <Parsing.h>
+#include <Solving.h>
+#include <Preprocessing.h>
+#include <Bounds.h>
+#include <Z3Tools.h>
+#include <Batch.h>
+
+/**
+ * @brief A way of solving measured by the benchmark, as chosen by the options of equalPath.
+ */
+typedef struct {
+    const char *name;   ///< The name of the mode in the results.
+    bool byDepth;       ///< Tells if the lengths are checked one by one (-s) instead of with the global formula.
+    bool decreasing;    ///< Tells if the lengths are checked in decreasing order (-d).
+    bool all;           ///< Tells if every length is checked (-a) instead of stopping at the first satisfiable one.
+} BenchMode;
+
+static const BenchMode benchModes[] = {
+    {"global", false, false, false},
+    {"s", true, false, false},
+    {"s-d", true, true, false},
+    {"s-a", true, false, true}
+};
+
+#define NUM_BENCH_MODES (int)(sizeof(benchModes)/sizeof(benchModes[0]))
+
+/**
+ * @brief The measures of a run, sent by the process which ran it.
+ */
+typedef struct {
+    int answer;             ///< 1 if the graphs have a common path, 0 if they have none, -1 if the solver could not decide.
+    int pathLength;         ///< The length found, the smallest one with -a, -1 if none.
+    int numChecks;          ///< The number of calls to the solver.
+    long numNodes;          ///< The total number of nodes of the graphs.
+    long numEdges;          ///< The total number of edges of the graphs.
+    long formulaNodes;      ///< The number of distinct terms of the formulae solved.
+    double parseSeconds;    ///< The time spent reading the graph files.
+    double encodeSeconds;   ///< The time spent building the formulae.
+    double solveSeconds;    ///< The time spent in the solver.
+    double decodeSeconds;   ///< The time spent reading the paths in the models.
+} BenchRecord;
+
+void usage(){
+    printf("Usage: benchmark [-o PREFIX] [-T SECONDS] [-m MODE]... DIR...\n");
+    printf(" Solves every instance under each DIR (each folder holding .dot files) with each mode, each run in its own process.\n");
+    printf(" Writes the times of each phase, the size of the formulae and the peak memory of each run in PREFIX.csv and PREFIX.json [default: bench/results].\n");
+    printf(" The answer of an instance found under a folder 'positive-instances' or 'negative-instances' is checked against it.\n");
+    printf(" -T SECONDS Stops a run after SECONDS seconds [default: 60].\n");
+    printf(" -m MODE Only runs MODE, among global, s (-s), s-d (-s -d) and s-a (-s -a) [default: all of them].\n");
+}
+
+/**
+ * @brief Small function returning the time of a monotonic clock in seconds.
+ */
+static double getSeconds(void){
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec+now.tv_nsec/1e9;
+}
+
+/**
+ * @brief Checks a formula and reads the paths of its model if it is satisfiable, counting the time of each phase.
+ *
+ * @param ctx The context.
+ * @param formula The formula.
+ * @param graphs An array of graphs.
+ * @param numGraphs The number of graphs in @p graphs.
+ * @param pathLength The length checked by @p formula, or ANY_LENGTH if it is the global formula.
+ * @param record The measures, updated.
+ * @return int 1 if @p formula is satisfiable, 0 if not, -1 if the solver could not decide.
+ */
+static int checkFormula(Z3_context ctx, Z3_ast formula, Graph *graphs, int numGraphs, int pathLength, BenchRecord *record){
+    record->formulaNodes += countFormulaNodes(ctx, formula, NULL);
+    double start = getSeconds();
+    Z3_solver solver = makeSolver(ctx);
+    Z3_solver_assert(ctx, solver, formula);
+    Z3_lbool res = Z3_solver_check(ctx, solver);
+    record->numChecks++;
+    record->solveSeconds += getSeconds()-start;
+    if(res == Z3_L_TRUE){
+        start = getSeconds();
+        Z3_model model = getModelFromSolver(ctx, solver);
+        if(pathLength == ANY_LENGTH){
+            pathLength = getSolutionLengthFromModel(ctx, model, graphs);
+        }
+        free(getPathsFromModel(ctx, model, graphs, numGraphs, pathLength));
+        Z3_model_dec_ref(ctx, model);
+        record->decodeSeconds += getSeconds()-start;
+        if(record->pathLength < 0 || pathLength < record->pathLength){
+            record->pathLength = pathLength;
+        }
+    }
+    deleteSolver(ctx, solver);
+    return res == Z3_L_TRUE ? 1 : res == Z3_L_FALSE ? 0 : -1;
+}
+
+/**
+ * @brief Solves an instance with a mode, as equalPath would with the same options, and measures it.
+ *
+ * @param instance The instance.
+ * @param mode The mode.
+ * @return BenchRecord The measures.
+ */
+static BenchRecord runBenchmark(BatchInstance *instance, const BenchMode *mode){
+    BenchRecord record;
+    memset(&record, 0, sizeof(record));
+    record.pathLength = -1;
+    int numGraphs = instance->numFiles;
+    Graph graphs[numGraphs];
+    double start = getSeconds();
+    for(int i = 0 ; i < numGraphs ; i++){
+        graphs[i] = getGraphFromFile(instance->files[i]);
+    }
+    record.parseSeconds = getSeconds()-start;
+    int maxK = orderG(graphs[0]);
+    for(int i = 0 ; i < numGraphs ; i++){
+        record.numNodes += orderG(graphs[i]);
+        record.numEdges += sizeG(graphs[i]);
+        if(orderG(graphs[i]) < maxK){
+            maxK = orderG(graphs[i]);
+        }
+    }
+
+    start = getSeconds();
+    Z3_context ctx = makeContext();
+    initNodeVariables(ctx, graphs, numGraphs);
+    record.encodeSeconds = getSeconds()-start;
+    if(!mode->byDepth){
+        start = getSeconds();
+        Z3_ast formula = graphsToFullFormula(ctx, graphs, numGraphs);
+        record.encodeSeconds += getSeconds()-start;
+        record.answer = formula == NULL ? 0 : checkFormula(ctx, formula, graphs, numGraphs, ANY_LENGTH, &record);
+    }else{
+        bool *lengths = computeCandidateLengths(graphs, numGraphs, maxK-1, getPruning(), NULL);
+        bool unknown = false;
+        for(int j = 0 ; j < maxK && (record.answer != 1 || mode->all) ; j++){
+            int k = mode->decreasing ? maxK-1-j : j;
+            if(lengths != NULL && !lengths[k]){
+                continue;
+            }
+            start = getSeconds();
+            Z3_ast formula = graphsToPathFormula(ctx, graphs, numGraphs, k);
+            record.encodeSeconds += getSeconds()-start;
+            int res = formula == NULL ? 0 : checkFormula(ctx, formula, graphs, numGraphs, k, &record);
+            if(res == 1){
+                record.answer = 1;
+            }
+            unknown = unknown || res < 0;
+        }
+        if(record.answer != 1 && unknown){
+            record.answer = -1;
+        }
+        free(lengths);
+    }
+    deleteNodeVariables();
+    Z3_del_context(ctx);
+    for(int i = 0 ; i < numGraphs ; i++){
+        deleteGraph(graphs[i]);
+    }
+    return record;
+}
+
+/**
+ * @brief Runs runBenchmark in a child process, stopped after @p timeout seconds, so that each run has its own peak memory.
+ *
+ * @param instance The instance.
+ * @param mode The mode.
+ * @param timeout The largest number of seconds of the run.
+ * @param record Receives the measures.
+ * @param peakRss Receives the peak resident memory of the run in kilobytes.
+ * @return const char* The status of the run: "ok", "timeout" or "crash".
+ */
+static const char *forkBenchmark(BatchInstance *instance, const BenchMode *mode, int timeout, BenchRecord *record, long *peakRss){
+    int channel[2];
+    fflush(stdout);
+    if(pipe(channel) != 0){
+        printf("Could not create a pipe in forkBenchmark\n");
+        exit(EXIT_FAILURE);
+    }
+    pid_t pid = fork();
+    if(pid < 0){
+        printf("Could not create a process in forkBenchmark\n");
+        exit(EXIT_FAILURE);
+    }
+    if(pid == 0){
+        close(channel[0]);
+        alarm(timeout);
+        BenchRecord measures = runBenchmark(instance, mode);
+        ssize_t written = write(channel[1], &measures, sizeof(measures));
+        _exit(written == (ssize_t)sizeof(measures) ? EXIT_SUCCESS : EXIT_FAILURE);
+    }
+    close(channel[1]);
+    memset(record, 0, sizeof(*record));
+    record->answer = -1;
+    record->pathLength = -1;
+    ssize_t received = 0;
+    while(received < (ssize_t)sizeof(*record)){
+        ssize_t size = read(channel[0], (char*)record+received, sizeof(*record)-received);
+        if(size <= 0){
+            break;
+        }
+        received += size;
+    }
+    close(channel[0]);
+    int status;
+    struct rusage usage;
+    wait4(pid, &status, 0, &usage);
+    *peakRss = usage.ru_maxrss;
+    if(received == (ssize_t)sizeof(*record) && WIFEXITED(status) && WEXITSTATUS(status) == EXIT_SUCCESS){
+        return "ok";
+    }
+    memset(record, 0, sizeof(*record));
+    record->answer = -1;
+    record->pathLength = -1;
+    return WIFSIGNALED(status) && WTERMSIG(status) == SIGALRM ? "timeout" : "crash";
+}
+
+/**
+ * @brief Small function returning the answer expected for an instance from the folders above it: 1 under "positive-instances", 0 under
+ *        "negative-instances", -1 otherwise.
+ */
+static int getExpectedAnswer(const char *folder){
+    if(strstr(folder, "positive-instances") != NULL){
+        return 1;
+    }
+    if(strstr(folder, "negative-instances") != NULL){
+        return 0;
+    }
+    return -1;
+}
+
+/**
+ * @brief Small function writing @p text as a JSON string.
+ */
+static void writeJsonString(FILE *file, const char *text){
+    fputc('"', file);
+    for(const char *c = text ; *c != '\0' ; c++){
+        if(*c == '"' || *c == '\\'){
+            fputc('\\', file);
+        }
+        fputc(*c, file);
+    }
+    fputc('"', file);
+}
+
+int main(int argc, char* argv[]){
+    const char *prefix = "bench/results";
+    int timeout = 60;
+    bool modes[NUM_BENCH_MODES];
+    bool modeChosen = false;
+    int numFolders = 0;
+    char *folders[argc];
+    for(int m = 0 ; m < NUM_BENCH_MODES ; m++){
+        modes[m] = false;
+    }
+    for(int i = 1 ; i < argc ; i++){
+        if(strcmp(argv[i],"-h") == 0){
+            usage();
+            return EXIT_SUCCESS;
+        }else if(strcmp(argv[i],"-o") == 0 && i+1 < argc){
+            prefix = argv[++i];
+        }else if(strcmp(argv[i],"-T") == 0 && i+1 < argc){
+            timeout = atoi(argv[++i]);
+        }else if(strcmp(argv[i],"-m") == 0 && i+1 < argc){
+            i++;
+            int m = 0;
+            while(m < NUM_BENCH_MODES && strcmp(argv[i],benchModes[m].name) != 0){
+                m++;
+            }
+            if(m == NUM_BENCH_MODES){
+                printf("Unknown mode %s, see -h for the available ones.\n",argv[i]);
+                return EXIT_FAILURE;
+            }
+            modes[m] = true;
+            modeChosen = true;
+        }else{
+            folders[numFolders++] = argv[i];
+        }
+    }
+    if(numFolders == 0){
+        usage();
+        return EXIT_SUCCESS;
+    }
+    for(int m = 0 ; m < NUM_BENCH_MODES && !modeChosen ; m++){
+        modes[m] = true;
+    }
+
+    size_t length = strlen(prefix)+8;
+    char csvName[length], jsonName[length];
+    snprintf(csvName, length, "%s.csv", prefix);
+    snprintf(jsonName, length, "%s.json", prefix);
+    FILE *csv = fopen(csvName, "w");
+    FILE *json = fopen(jsonName, "w");
+    if(csv == NULL || json == NULL){
+        printf("Could not write %s and %s.\n",csvName,jsonName);
+        return EXIT_FAILURE;
+    }
+    fprintf(csv, "instance,mode,status,expected,answer,check,length,graphs,nodes,edges,formula_nodes,checks,parse_s,encode_s,solve_s,decode_s,peak_rss_kb\n");
+    fprintf(json, "[");
+
+    int numRuns = 0, numWrong = 0, numTimeouts = 0;
+    for(int f = 0 ; f < numFolders ; f++){
+        int numInstances;
+        BatchInstance *instances = findBatchInstances(folders[f], &numInstances);
+        for(int i = 0 ; i < numInstances ; i++){
+            int expected = getExpectedAnswer(instances[i].folder);
+            for(int m = 0 ; m < NUM_BENCH_MODES ; m++){
+                if(!modes[m]){
+                    continue;
+                }
+                BenchRecord record;
+                long peakRss;
+                const char *status = forkBenchmark(&instances[i], &benchModes[m], timeout, &record, &peakRss);
+                const char *check = expected < 0 || record.answer < 0 ? "-" : expected == record.answer ? "ok" : "wrong";
+                numRuns++;
+                numWrong += strcmp(check, "wrong") == 0;
+                numTimeouts += strcmp(status, "timeout") == 0;
+                printf("%s %s: %s, answer %d, check %s (%.3f s)\n", instances[i].folder, benchModes[m].name, status, record.answer, check,
+                       record.parseSeconds+record.encodeSeconds+record.solveSeconds+record.decodeSeconds);
+
+                fprintf(csv, "%s,%s,%s,%d,%d,%s,%d,%d,%ld,%ld,%ld,%d,%.6f,%.6f,%.6f,%.6f,%ld\n", instances[i].folder, benchModes[m].name, status,
+                        expected, record.answer, check, record.pathLength, instances[i].numFiles, record.numNodes, record.numEdges, record.formulaNodes,
+                        record.numChecks, record.parseSeconds, record.encodeSeconds, record.solveSeconds, record.decodeSeconds, peakRss);
+                fprintf(json, numRuns == 1 ? "\n  {\"instance\": " : ",\n  {\"instance\": ");
+                writeJsonString(json, instances[i].folder);
+                fprintf(json, ", \"mode\": \"%s\", \"status\": \"%s\", \"expected\": %d, \"answer\": %d, \"check\": \"%s\", \"length\": %d, \"graphs\": %d,"
+                        " \"nodes\": %ld, \"edges\": %ld, \"formula_nodes\": %ld, \"checks\": %d, \"parse_s\": %.6f, \"encode_s\": %.6f, \"solve_s\": %.6f,"
+                        " \"decode_s\": %.6f, \"peak_rss_kb\": %ld}", benchModes[m].name, status, expected, record.answer, check, record.pathLength,
+                        instances[i].numFiles, record.numNodes, record.numEdges, record.formulaNodes, record.numChecks, record.parseSeconds,
+                        record.encodeSeconds, record.solveSeconds, record.decodeSeconds, peakRss);
+                fflush(csv);
+                fflush(json);
+            }
+        }
+        deleteBatchInstances(instances, numInstances);
+    }
+    fprintf(json, "\n]\n");
+    fclose(csv);
+    fclose(json);
+    printf("%d runs, %d wrong answers, %d timeouts. Results written in %s and %s.\n", numRuns, numWrong, numTimeouts, csvName, jsonName);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,92 @@
+#!/bin/sh
+# Regression check of equalPath: every instance of graphs/generic-instances up to a given size is solved with every engine, node encoding and
+# "at most one" encoding, in the main modes, and each answer is checked against the positive/negative folder of the instance.
+# Usage: bench/check.sh [-b BINARY] [-m MAX_SIZE] [-t TIMEOUT_S]
+#   -b BINARY    The program checked (default: ./equalPath).
+#   -m MAX_SIZE  Only the folders TailleNN with NN <= MAX_SIZE are solved (default: 20).
+#   -t TIMEOUT_S Each run is stopped after TIMEOUT_S seconds and counted as a failure (default: 60).
+# Exits with 0 iff every answer is the expected one.
+
+BIN=./equalPath
+MAX_SIZE=20
+RUN_TIMEOUT=60
+while getopts "b:m:t:" opt; do
+    case $opt in
+        b) BIN=$OPTARG ;;
+        m) MAX_SIZE=$OPTARG ;;
+        t) RUN_TIMEOUT=$OPTARG ;;
+        *) sed -n '4,7p' "$0"; exit 2 ;;
+    esac
+done
+
+# The instances under negative-instances whose graphs do have a common path, as every engine finds.
+KNOWN_POSITIVE="negative-instances/Taille10_neg/instance8"
+
+ENCODINGS="onehot binary"
+AMOS="pairwise sequential commander product"
+# The modes of Z3, of the embedded solver, and of the search without solver.
+Z3_MODES="global|-s|-s -i|-s -d|-s -d -i|--separate|-s --separate"
+CDCL_MODES="global|-s"
+NATIVE_MODES="global|-s|-s -a"
+
+checked=0
+failed=0
+
+# Runs BIN with the options $2 on the instance $1 and checks its answer against $3 (Oui or Non).
+check_run() {
+    out=$(timeout "$RUN_TIMEOUT" $BIN $2 "$1"/*.dot 2>&1)
+    if [ $? -ne 0 ]; then
+        got="error"
+    elif echo "$out" | grep -q "^We don't know"; then
+        got="unknown"
+    elif echo "$out" | grep -q "^Oui"; then
+        got="Oui"
+    else
+        got="Non"
+    fi
+    checked=$((checked+1))
+    if [ "$got" != "$3" ]; then
+        failed=$((failed+1))
+        echo "FAILED $1 [$2]: expected $3, got $got"
+    fi
+}
+
+# Runs every mode of the list $3 (separated by |) with the options $2 on the instance $1, expecting $4.
+check_modes() {
+    modes=$3
+    while [ -n "$modes" ]; do
+        mode=${modes%%|*}
+        case $modes in
+            *"|"*) modes=${modes#*|} ;;
+            *) modes="" ;;
+        esac
+        [ "$mode" = "global" ] && mode=""
+        check_run "$1" "$2 $mode" "$4"
+    done
+}
+
+for folder in graphs/generic-instances/positive-instances/Taille*_pos/instance* graphs/generic-instances/negative-instances/Taille*_neg/instance*; do
+    [ -d "$folder" ] || continue
+    size=$(echo "$folder" | sed 's/.*Taille\([0-9]*\)_.*/\1/')
+    [ "$size" -gt "$MAX_SIZE" ] && continue
+    case $folder in
+        *positive-instances*) expected=Oui ;;
+        *) expected=Non ;;
+    esac
+    for known in $KNOWN_POSITIVE; do
+        case $folder in
+            *"$known") expected=Oui ;;
+        esac
+    done
+    for encoding in $ENCODINGS; do
+        for amo in $AMOS; do
+            check_modes "$folder" "--engine=z3 --encoding=$encoding --amo=$amo" "$Z3_MODES" $expected
+            check_modes "$folder" "--engine=cdcl --encoding=$encoding --amo=$amo" "$CDCL_MODES" $expected
+        done
+    done
+    check_modes "$folder" "--engine=native" "$NATIVE_MODES" $expected
+    check_run "$folder" "--portfolio" $expected
+done
+
+echo "checked $checked runs, $failed failed"
+[ $failed -eq 0 ]
@@ -0,0 +1,73 @@
+/**
+ * @file Batch.h
+ * @brief Solving of whole trees of instances in a single process: every folder holding graph files is an instance, whose graphs are its .dot files.
+ *        The instances are spread over a pool of threads, the largest first, and each thread keeps its Z3 context from one instance to the next,
+ *        so that neither a process nor a context is created per instance. A line is printed for each instance as soon as it is answered.
+ * @version 1
+ *
+ * @copyright Creative Commons.
+ *
+ */
+
+#ifndef COCA_BATCH_H_
+#define COCA_BATCH_H_
+
+/**
+ * @brief The way the instances are decided.
+ */
+typedef enum {
+    BATCH_Z3,       ///< The global formula, solved by Z3.
+    BATCH_NATIVE,   ///< The depth first search of the simple paths of each graph.
+    BATCH_CDCL      ///< The clauses of the formula given to the embedded solver.
+} BatchEngine;
+
+/**
+ * @brief An instance: a folder and its graph files.
+ */
+typedef struct {
+    char *folder;   ///< The folder of the instance.
+    char **files;   ///< The paths of its graph files, sorted by name.
+    int numFiles;   ///< The number of graph files.
+    long size;      ///< The total size of the graph files in bytes.
+} BatchInstance;
+
+/**
+ * @brief Finds the instances under @p folder, @p folder included: the folders holding at least one .dot file, whose graphs are these files.
+ *
+ * @param folder The root of the tree.
+ * @param numInstances Receives the number of instances found.
+ * @return BatchInstance* The instances, ordered by folder, to be freed with deleteBatchInstances.
+ */
+BatchInstance *findBatchInstances(const char *folder, int *numInstances);
+
+/**
+ * @brief Frees the memory occupied by @p instances.
+ *
+ * @param instances The instances given by findBatchInstances.
+ * @param numInstances The number of instances.
+ */
+void deleteBatchInstances(BatchInstance *instances, int numInstances);
+
+/**
+ * @brief The number of instances answered by a batch.
+ */
+typedef struct {
+    int numInstances;   ///< The number of instances found.
+    int numSat;         ///< The number of instances whose graphs have a common path.
+    int numUnsat;       ///< The number of instances whose graphs have no common path.
+    int numUnknown;     ///< The number of instances the solver could not decide.
+} BatchSummary;
+
+/**
+ * @brief Finds the instances under @p folder with findBatchInstances and tells for each one, like the global formula, if its graphs have an
+ *        accepting path of a common length. The settings of the current thread (encodings and pruning) are used by all threads. For each instance, a line "FOLDER : ANSWER (TIME s)" is printed once it is answered.
+ *        The budget of the query (see Budget.h) covers the whole batch: the instances answered after it ran out are unknown.
+ *
+ * @param folder The root of the tree.
+ * @param engine The way the instances are decided.
+ * @param numThreads The number of instances solved at the same time.
+ * @return BatchSummary The number of instances and of each answer.
+ */
+BatchSummary solveBatch(const char *folder, BatchEngine engine, int numThreads);
+
+#endif
@@ -0,0 +1,135 @@
+/**
+ * @file Bitset.h
+ * @brief Fixed-size sets of small integers (typically nodes of a graph) stored as arrays of 64-bit words, so that unions and intersections handle
+ *        64 elements at once.
+ * @version 1
+ * 
+ * @copyright Creative Commons.
+ * 
+ */
+
+#ifndef COCA_BITSET_H_
+#define COCA_BITSET_H_
+
+#include <stdint.h>
+
+/** @brief A word of a bitset. */
+typedef uint64_t BitsetWord;
+
+/** @brief The number of bits of a word of a bitset. */
+#define BITSET_WORD_BITS 64
+
+/**
+ * @brief A set of integers between 0 and numBits-1. Bit b is bit b%64 of word b/64.
+ */
+typedef struct {
+    int numBits;        ///< The number of elements the set can hold.
+    int numWords;       ///< The number of words of @p words.
+    BitsetWord *words;  ///< The words of the set.
+} Bitset;
+
+/**
+ * @brief Creates an empty set of integers between 0 and @p numBits-1.
+ * 
+ * @param numBits The number of elements the set can hold.
+ * @return Bitset The set, to be freed with deleteBitset.
+ */
+Bitset makeBitset(int numBits);
+
+/**
+ * @brief Frees the memory occupied by @p set.
+ * 
+ * @param set A set.
+ */
+void deleteBitset(Bitset set);
+
+/**
+ * @brief Removes every element of @p set.
+ * 
+ * @param set A set.
+ */
+void clearBitset(Bitset set);
+
+/**
+ * @brief Adds @p bit to @p set.
+ * 
+ * @param set A set.
+ * @param bit An element.
+ */
+void setBit(Bitset set, int bit);
+
+/**
+ * @brief Removes @p bit from @p set.
+ * 
+ * @param set A set.
+ * @param bit An element.
+ */
+void resetBit(Bitset set, int bit);
+
+/**
+ * @brief Tells if @p bit is in @p set.
+ * 
+ * @param set A set.
+ * @param bit An element.
+ * @return true iff @p bit is in @p set.
+ */
+bool testBit(Bitset set, int bit);
+
+/**
+ * @brief Copies @p source into @p destination, which must have the same size.
+ * 
+ * @param destination The set overwritten.
+ * @param source The set copied.
+ */
+void copyBitset(Bitset destination, Bitset source);
+
+/**
+ * @brief Adds the elements of @p source to @p destination, which must have the same size.
+ * 
+ * @param destination The set modified.
+ * @param source Another set.
+ */
+void unionBitset(Bitset destination, Bitset source);
+
+/**
+ * @brief Removes from @p destination the elements which are not in @p source, which must have the same size.
+ * 
+ * @param destination The set modified.
+ * @param source Another set.
+ */
+void intersectBitset(Bitset destination, Bitset source);
+
+/**
+ * @brief Removes from @p destination the elements of @p source, which must have the same size.
+ * 
+ * @param destination The set modified.
+ * @param source Another set.
+ */
+void differenceBitset(Bitset destination, Bitset source);
+
+/**
+ * @brief Returns the number of elements of @p set.
+ * 
+ * @param set A set.
+ * @return int Its number of elements.
+ */
+int countBitset(Bitset set);
+
+/**
+ * @brief Tells if @p set is empty.
+ * 
+ * @param set A set.
+ * @return true iff @p set has no element.
+ */
+bool isBitsetEmpty(Bitset set);
+
+/**
+ * @brief Returns the smallest element of @p set greater than or equal to @p from, to iterate over a set.
+ * 
+ * @param set A set.
+ * @param from The first element considered.
+ * @return int The element, or -1 if there is none.
+ */
+int nextSetBit(Bitset set, int from);
+
+#endif
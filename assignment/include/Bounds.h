@@ -0,0 +1,76 @@
+/**
+ * @file Bounds.h
+ * @brief Bounds on the lengths of the simple accepting paths of a graph: such a path is at least as long as a shortest path from the source to the
+ *        target, and it visits distinct nodes which are all reachable from the source and reach the target, so it is shorter than their number.
+ *        The bounds hold with or without the pruning: the lengths outside the bounds of every graph are never checked, and the formula shared by
+ *        all lengths only covers the common range.
+ * @version 1
+ * 
+ * @copyright Creative Commons.
+ * 
+ */
+
+#ifndef COCA_BOUNDS_H_
+#define COCA_BOUNDS_H_
+
+#include "Graph.h"
+#include "Preprocessing.h"
+
+/**
+ * @brief A range of lengths, empty when @p lowest is larger than @p highest.
+ */
+typedef struct {
+    int lowest;     ///< The smallest length of the range.
+    int highest;    ///< The largest length of the range.
+} LengthBounds;
+
+/**
+ * @brief Computes the bounds of the lengths of the simple paths from the source to the target of a graph from its distances: the distance from the
+ *        source to the target, and the number of nodes both reachable from the source and reaching the target, minus one.
+ * 
+ * @param distances The distances of the graph, given by computeDistances.
+ * @return LengthBounds The bounds, empty if the target is not reachable from the source.
+ */
+LengthBounds computeLengthBoundsFromDistances(Distances distances);
+
+/**
+ * @brief Computes the bounds of computeLengthBoundsFromDistances of @p graph, whose distances are computed and freed on the way.
+ * 
+ * @param graph A graph.
+ * @return LengthBounds The bounds, empty if the target is not reachable from the source.
+ */
+LengthBounds computeLengthBounds(Graph graph);
+
+/**
+ * @brief Computes the intersection of the bounds of the graphs of @p graphs, i.e. the only lengths at which they may all have a simple accepting path.
+ * 
+ * @param graphs An array of graphs.
+ * @param numGraphs The number of graphs in @p graphs.
+ * @param distances The distances of each graph if they are already computed, else NULL.
+ * @return LengthBounds The common bounds.
+ */
+LengthBounds computeCommonLengthBounds(Graph *graphs, int numGraphs, Distances *distances);
+
+/**
+ * @brief Sets to false the lengths of @p lengths outside @p bounds.
+ * 
+ * @param lengths An array of @p maxLength+1 booleans indexed by length.
+ * @param maxLength The largest length of @p lengths.
+ * @param bounds The bounds.
+ */
+void restrictLengthsToBounds(bool *lengths, int maxLength, LengthBounds bounds);
+
+/**
+ * @brief Computes the lengths up to @p maxLength which may have a common accepting path in the graphs of @p graphs: the ones within their common
+ *        bounds and, if @p walks is true, of a walk in every graph (computeCommonWalkLengths). This is where the range of lengths checked is chosen.
+ * 
+ * @param graphs An array of graphs.
+ * @param numGraphs The number of graphs in @p graphs.
+ * @param maxLength The largest length, at least 0.
+ * @param walks Tells if the lengths of a common walk are computed too, which is part of the pruning.
+ * @param distances The distances of each graph if they are already computed, else NULL.
+ * @return bool* An array of @p maxLength+1 booleans indexed by length, to be freed.
+ */
+bool *computeCandidateLengths(Graph *graphs, int numGraphs, int maxLength, bool walks, Distances *distances);
+
+#endif
@@ -0,0 +1,50 @@
+/**
+ * @file Budget.h
+ * @brief The time budget of a whole query, given by --budget: unlike the limits of each check given by setSolverLimits, it bounds the sum of all the
+ *        checks of the query, whatever the engine. Each check of Z3 is stopped when the budget runs out, the embedded solver and the depth first
+ *        search give up, and the explorations leave the lengths not decided yet unknown. It is shared by all threads.
+ * @version 1
+ *
+ * @copyright Creative Commons.
+ *
+ */
+
+#ifndef COCA_BUDGET_H_
+#define COCA_BUDGET_H_
+
+#include <stdbool.h>
+
+/**
+ * @brief The reason given for the checks answered unknown because the budget ran out.
+ */
+#define BUDGET_EXHAUSTED_REASON "query budget exhausted"
+
+/**
+ * @brief Starts the budget of the query: it runs out @p budget milliseconds from now. Must be called before any thread is started.
+ *
+ * @param budget The time of the whole query in milliseconds, 0 for no budget.
+ */
+void startQueryBudget(unsigned int budget);
+
+/**
+ * @brief Tells if a budget was started by startQueryBudget.
+ *
+ * @return true iff the query has a budget.
+ */
+bool hasQueryBudget(void);
+
+/**
+ * @brief Tells if the budget of the query has run out. Always false without a budget.
+ *
+ * @return true iff the query has a budget and it has run out.
+ */
+bool isQueryBudgetExhausted(void);
+
+/**
+ * @brief Gives the time left in the budget of the query, rounded up so that it is only 0 once the budget has run out.
+ *
+ * @return unsigned int The time left in milliseconds, 0 if the budget has run out or if there is none.
+ */
+unsigned int getRemainingQueryBudget(void);
+
+#endif
@@ -0,0 +1,56 @@
+/**
+ * @file Cardinality.h
+ * @brief Encodings of the "at most one of these literals is true" constraint, used by the formulae saying that a path visits a single node at each
+ *        position and each node at most once.
+ * @version 1
+ * 
+ * @copyright Creative Commons.
+ * 
+ */
+
+#ifndef COCA_CARDINALITY_H_
+#define COCA_CARDINALITY_H_
+
+#include <z3.h>
+
+/**
+ * @brief The available encodings of the at-most-one constraint over n literals.
+ */
+typedef enum {
+    AMO_PAIRWISE,   ///< One binary clause per pair of literals: n(n-1)/2 clauses, no auxiliary variable.
+    AMO_SEQUENTIAL, ///< Sequential counter: n-1 auxiliary variables and 3n clauses.
+    AMO_COMMANDER,  ///< Commander encoding: groups of 3 literals with a commander variable each, applied recursively on the commanders.
+    AMO_PRODUCT     ///< Product encoding: the literals are laid out on a grid of about sqrt(n) rows and columns, applied recursively on them.
+} AmoEncoding;
+
+/**
+ * @brief Generates a formula true if and only if at most one of @p literals is true (up to auxiliary variables, which are fresh for each call).
+ * 
+ * @param ctx The solver context.
+ * @param literals The literals.
+ * @param negLiterals The negations of @p literals, or NULL to build them.
+ * @param numLiterals The number of literals.
+ * @param encoding The encoding to use.
+ * @return Z3_ast The formula.
+ */
+Z3_ast atMostOne(Z3_context ctx, Z3_ast *literals, Z3_ast *negLiterals, int numLiterals, AmoEncoding encoding);
+
+/**
+ * @brief Gives the encoding called @p name ("pairwise", "sequential", "commander" or "product").
+ * 
+ * @param name The name of an encoding.
+ * @param encoding Where the encoding is written if @p name is valid.
+ * @return true If @p name is the name of an encoding.
+ * @return false Otherwise.
+ */
+bool getAmoEncodingFromName(const char *name, AmoEncoding *encoding);
+
+/**
+ * @brief Gives the name of @p encoding.
+ * 
+ * @param encoding An encoding.
+ * @return const char* Its name.
+ */
+const char *getAmoEncodingName(AmoEncoding encoding);
+
+#endif
@@ -0,0 +1,128 @@
+/**
+ * @file Cdcl.h
+ * @brief A small conflict driven clause learning SAT solver, fed with clauses and "at most one" groups directly instead of Z3 terms. The groups are
+ *        propagated natively: once a literal of a group is true, the other ones are set to false without any clause, so the one-hot constraints of
+ *        the formulae cost neither auxiliary variables nor a quadratic number of clauses.
+ * @version 1
+ *
+ * @copyright Creative Commons.
+ *
+ */
+
+#ifndef COCA_CDCL_H_
+#define COCA_CDCL_H_
+
+/**
+ * @brief The answer of the solver.
+ */
+typedef enum {
+    CDCL_SAT,      ///< The clauses and groups have a model.
+    CDCL_UNSAT,    ///< The clauses and groups have no model.
+    CDCL_UNKNOWN   ///< The budget of the query ran out before an answer.
+} CdclResult;
+
+/**
+ * @brief A growable array of integers.
+ */
+typedef struct {
+    int size;      ///< The number of integers stored.
+    int capacity;  ///< The number of integers @p data can hold.
+    int *data;     ///< The integers.
+} CdclVector;
+
+/**
+ * @brief The state of the solver. The variables are numbered from 1 to numVariables, a literal is a variable or its opposite, as in DIMACS.
+ *        Internally, literal 2v is variable v and literal 2v+1 its negation.
+ */
+typedef struct {
+    int numVariables;         ///< The number of variables.
+    bool unsatisfiable;       ///< True once a conflict without decision was found.
+    signed char *values;      ///< The value of each variable: 1 true, -1 false, 0 unassigned.
+    int *levels;              ///< The decision level at which each variable was assigned.
+    int *reasons;             ///< The clause which implied each variable, -1 if none.
+    int *reasonLiterals;      ///< For a variable set by a group, the false literal of the binary clause which implied it, -1 if none.
+    bool *phases;             ///< The last value of each variable, reused by the next decisions.
+    char *seen;               ///< The marks of the conflict analysis.
+    int *trail;               ///< The literals assigned, in order.
+    int trailSize;            ///< The number of literals in @p trail.
+    int propagated;           ///< The number of literals of @p trail already propagated.
+    CdclVector levelStarts;   ///< The position in @p trail of the first literal of each decision level.
+    CdclVector clauses;       ///< The clauses one after the other: size, flags, glue, then the literals. A clause is known by its position.
+    CdclVector *watches;      ///< For each literal, the clauses watching it, visited when it becomes false.
+    CdclVector groupLiterals; ///< The literals of the groups, one group after the other.
+    CdclVector groupStarts;   ///< The position in @p groupLiterals of each group, then its end.
+    CdclVector *occurrences;  ///< For each literal, the groups it belongs to.
+    CdclVector learnts;       ///< The positions of the learnt clauses.
+    CdclVector learnt;        ///< The clause being learnt.
+    int wasted;               ///< The number of integers of @p clauses occupied by forgotten clauses.
+    int conflictPair[2];      ///< The two true literals of a group in conflict.
+    double *activities;       ///< The activity of each variable, bumped when it takes part in a conflict.
+    double increment;         ///< The current bump of the activities.
+    int *heap;                ///< The unassigned variables (and some assigned ones) by decreasing activity.
+    int *heapIndices;         ///< The position of each variable in @p heap, -1 if it is not in it.
+    int heapSize;             ///< The number of variables in @p heap.
+    int *levelStamps;         ///< For each level, the last conflict in which it was counted, used to compute the glue of a learnt clause.
+    long conflicts;           ///< The number of conflicts met so far.
+    long maxLearnts;          ///< The number of learnt clauses over which half of them are forgotten.
+} CdclSolver;
+
+/**
+ * @brief Creates a solver with @p numVariables variables and no clause.
+ *
+ * @param numVariables The number of variables.
+ * @return CdclSolver* The solver, to be freed with deleteCdclSolver.
+ */
+CdclSolver *makeCdclSolver(int numVariables);
+
+/**
+ * @brief Frees the memory occupied by @p solver.
+ *
+ * @param solver The solver to delete.
+ */
+void deleteCdclSolver(CdclSolver *solver);
+
+/**
+ * @brief Adds the disjunction of @p literals to @p solver. Must be called before solveCdcl.
+ *
+ * @param solver A solver.
+ * @param literals The literals, v or -v for a variable v.
+ * @param numLiterals The number of literals.
+ */
+void addCdclClause(CdclSolver *solver, int *literals, int numLiterals);
+
+/**
+ * @brief Adds to @p solver the constraint that at most one of @p literals is true. Must be called before solveCdcl.
+ *
+ * @param solver A solver.
+ * @param literals The literals, v or -v for a variable v.
+ * @param numLiterals The number of literals.
+ */
+void addCdclAtMostOne(CdclSolver *solver, int *literals, int numLiterals);
+
+/**
+ * @brief Adds to @p solver the constraint that exactly one of @p literals is true, i.e. their disjunction and an "at most one" group.
+ *
+ * @param solver A solver.
+ * @param literals The literals, v or -v for a variable v.
+ * @param numLiterals The number of literals.
+ */
+void addCdclExactlyOne(CdclSolver *solver, int *literals, int numLiterals);
+
+/**
+ * @brief Searches a model of the clauses and groups of @p solver, until the budget of the query runs out (see Budget.h).
+ *
+ * @param solver A solver.
+ * @return CdclResult CDCL_SAT, CDCL_UNSAT, or CDCL_UNKNOWN if the budget ran out.
+ */
+CdclResult solveCdcl(CdclSolver *solver);
+
+/**
+ * @brief Gives the value of @p variable in the model found by the last solveCdcl.
+ *
+ * @param solver A solver whose last answer is CDCL_SAT.
+ * @param variable A variable.
+ * @return true iff @p variable is true in the model.
+ */
+bool getCdclValue(CdclSolver *solver, int variable);
+
+#endif
@@ -0,0 +1,30 @@
+/**
+ * @file CdclSolving.h
+ * @brief Decision of the path problem with the solver of Cdcl.h: the clauses mirror the formulae ɸ1 to ɸ6 of the one-hot encoding, the "exactly one
+ *        node per position" and "at most one position per node" constraints being given to the solver as groups instead of clauses, and no Z3 term
+ *        is ever built.
+ * @version 1
+ * 
+ * @copyright Creative Commons.
+ * 
+ */
+
+#ifndef COCA_CDCL_SOLVING_H_
+#define COCA_CDCL_SOLVING_H_
+
+#include "Graph.h"
+
+/**
+ * @brief Decides with the embedded solver if every graph of @p graphs has a simple path of length @p pathLength from its source to its target. The
+ *        graphs share no variable, so each one is solved alone and the search stops at the first graph without such a path. The pairs (node, position)
+ *        are pruned as for the formulae of Solving.h.
+ * 
+ * @param graphs An array of graphs.
+ * @param numGraphs The number of graphs in @p graphs.
+ * @param pathLength The length of the paths.
+ * @param paths If not NULL, the array of size @p numGraphs*(@p pathLength+1) whose block i receives the path of graph i when true is returned.
+ * @return true iff every graph has such a path, false if the budget of the query runs out first (see Budget.h).
+ */
+bool cdclGraphsHavePath(Graph *graphs, unsigned int numGraphs, int pathLength, int *paths);
+
+#endif
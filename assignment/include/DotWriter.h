@@ -0,0 +1,91 @@
+/**
+ * @file DotWriter.h
+ * @brief Writing of the solutions in .dot files without redirecting the standard output: the section of each graph is formatted in its own buffer,
+ *        possibly by several threads at once, then the sections are written one after the other in the file. Nothing is shared between two writes,
+ *        so several files can be written at the same time.
+ * @version 1
+ *
+ * @copyright Creative Commons.
+ *
+ */
+
+#ifndef COCA_DOTWRITER_H_
+#define COCA_DOTWRITER_H_
+
+#include <stddef.h>
+#include "Graph.h"
+
+/** @brief The folder in which the .dot files are written. */
+#define DOT_FOLDER "./sol"
+
+/**
+ * @brief A growable character string.
+ */
+typedef struct {
+    char *data;       ///< The characters, followed by a null character.
+    size_t size;      ///< The number of characters.
+    size_t capacity;  ///< The number of characters @p data can hold, the null character included.
+} DotBuffer;
+
+/**
+ * @brief Creates an empty buffer.
+ *
+ * @return DotBuffer The buffer, to be freed with deleteDotBuffer.
+ */
+DotBuffer makeDotBuffer(void);
+
+/**
+ * @brief Frees the memory occupied by @p buffer.
+ *
+ * @param buffer The buffer to delete.
+ */
+void deleteDotBuffer(DotBuffer buffer);
+
+/**
+ * @brief Appends to @p buffer the text formatted as printf would.
+ *
+ * @param buffer A buffer.
+ * @param format The format, followed by its arguments.
+ */
+void appendToDotBuffer(DotBuffer *buffer, const char *format, ...);
+
+/**
+ * @brief Formats in @p buffer the section of graph @p graphNumber: its source and target, its nodes and its edges, those of @p path in blue.
+ *
+ * @param buffer A buffer.
+ * @param graph A graph.
+ * @param graphNumber The index of @p graph, prefixed to the names of its nodes.
+ * @param pathLength The length of @p path.
+ * @param path The nodes of the path of @p graph.
+ */
+void appendGraphToDotBuffer(DotBuffer *buffer, Graph graph, int graphNumber, int pathLength, int *path);
+
+/**
+ * @brief Writes the paths @p paths of length @p pathLength in the file "DOT_FOLDER/NAME-lLENGTH.dot". The sections of the graphs are formatted by at
+ *        most @p numThreads threads.
+ *
+ * @param graphs An array of graphs.
+ * @param numGraphs The number of graphs in @p graphs.
+ * @param pathLength The length of the paths.
+ * @param paths The paths, the one of graph i starting at index i*(@p pathLength+1).
+ * @param name The name of the solution.
+ * @param numThreads The largest number of threads formatting the sections.
+ * @return true iff the file was written.
+ */
+bool writeDotFile(Graph *graphs, int numGraphs, int pathLength, int *paths, const char *name, int numThreads);
+
+/**
+ * @brief Writes one file per length, as writeDotFile, @p numThreads files at the same time.
+ *
+ * @param graphs An array of graphs.
+ * @param numGraphs The number of graphs in @p graphs.
+ * @param numFiles The number of files.
+ * @param pathLengths The length of the paths of each file.
+ * @param paths The paths of each file, as given to writeDotFile.
+ * @param name The name of the solution.
+ * @param numThreads The largest number of files written at the same time.
+ * @return int The number of files written.
+ */
+int writeDotFiles(Graph *graphs, int numGraphs, int numFiles, int *pathLengths, int **paths, const char *name, int numThreads);
+
+#endif
@@ -14,18 +14,26 @@
 #ifndef COCA_GRAPH_H_
 #define COCA_GRAPH_H_
 
+#include <stddef.h>
 
 
-/** @brief: the graph type. The first four fields are needed to represent a directed graph. The rest depends on needs. Here, the rest represents initial and final states of an automaton.*/
+/** @brief: the graph type. The first seven fields are needed to represent a directed graph. The rest depends on needs. Here, the rest represents initial and final states of an automaton.
+ *  The edges are stored in compressed sparse rows, both forwards and backwards: the successors of node u are successors[successorIndex[u]] to successors[successorIndex[u+1]-1], sorted by increasing number, and likewise for its predecessors. The memory used is linear in the number of nodes and edges.*/
 typedef struct {
 	int numNodes; ///< The number of nodes of the graph.
 	int numEdges; ///< The number of edges of the graph.
 	char** nodes; ///< The names of nodes of the graphs.
-	int* edges;	  ///< The edges of the graph.
+	int* successorIndex;	///< For each node, the index of its first successor in successors, plus numEdges at index numNodes.
+	int* successors;		///< The successors of every node, grouped by node.
+	int* predecessorIndex;	///< For each node, the index of its first predecessor in predecessors, plus numEdges at index numNodes.
+	int* predecessors;		///< The predecessors of every node, grouped by node.
 
 //This is only for dealing with automata. May be changed according to needs.
 	bool *initial;	///< Array of source nodes.
 	bool *final;	///< Array of target nodes.
+
+	void *mapping;		///< The compiled file the edges and names point into (see GraphCache.h), or NULL if the graph owns them.
+	size_t mappingSize;	///< The size of mapping.
 } Graph;
 
 /**
@@ -36,7 +44,7 @@ typedef struct {
 void printGraph(Graph graph);
 
 /**
- * @brief Frees all memory occupied by a graph.
+ * @brief Frees all memory occupied by a graph, or unmaps the compiled file it was loaded from.
  * 
  * @param graph The graph to delete.
  */
@@ -59,7 +67,17 @@ int orderG(Graph graph);
 int sizeG(Graph graph);
 
 /**
- * @brief Tells if (@p source, @p target) is an edge in @p graph.
+ * @brief Fills the edges of @p graph from a list of edges, given as two arrays. The duplicated edges are kept once.
+ * 
+ * @param graph A graph whose number of nodes is set.
+ * @param numEdges The number of edges in the list.
+ * @param sources The sources of the edges.
+ * @param targets The targets of the edges.
+ */
+void setEdges(Graph *graph, int numEdges, int *sources, int *targets);
+
+/**
+ * @brief Tells if (@p source, @p target) is an edge in @p graph. Searches the successors of @p source by dichotomy.
  * 
  * @param graph A graph.
  * @param source The source of the edge.
@@ -69,6 +87,43 @@ int sizeG(Graph graph);
  */
 bool isEdge(Graph graph, int source, int target);
 
+/**
+ * @brief Returns the number of successors of @p node in @p graph.
+ * 
+ * @param graph A graph.
+ * @param node A node.
+ * @return int The number of successors of @p node.
+ */
+int getNumSuccessors(Graph graph, int node);
+
+/**
+ * @brief Returns the successors of @p node in @p graph, sorted by increasing number. Iterate with getNumSuccessors:
+ *        for(int e = 0 ; e < getNumSuccessors(graph,u) ; e++) uses getSuccessors(graph,u)[e].
+ * 
+ * @param graph A graph.
+ * @param node A node.
+ * @return int* The array of the successors of @p node. Must not be modified nor freed.
+ */
+int* getSuccessors(Graph graph, int node);
+
+/**
+ * @brief Returns the number of predecessors of @p node in @p graph.
+ * 
+ * @param graph A graph.
+ * @param node A node.
+ * @return int The number of predecessors of @p node.
+ */
+int getNumPredecessors(Graph graph, int node);
+
+/**
+ * @brief Returns the predecessors of @p node in @p graph, sorted by increasing number.
+ * 
+ * @param graph A graph.
+ * @param node A node.
+ * @return int* The array of the predecessors of @p node. Must not be modified nor freed.
+ */
+int* getPredecessors(Graph graph, int node);
+
 /**
  * @brief Tells if @p node is source in @p graph.
  * 
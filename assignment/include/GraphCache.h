@@ -0,0 +1,66 @@
+/**
+ * @file GraphCache.h
+ * @brief Compiled binary format of a graph, so that a graph file is parsed once and then loaded by mapping the compiled file in memory.
+ *        The file holds a versioned header, the forward and reverse compressed sparse rows of the edges, the source and target nodes as bitsets and a
+ *        string table with the names of the nodes. The loaded graph points into the mapping and must not be modified.
+ * @version 1
+ * 
+ * @copyright Creative Commons.
+ * 
+ */
+
+#ifndef COCA_GRAPHCACHE_H_
+#define COCA_GRAPHCACHE_H_
+
+#include "Graph.h"
+
+/** @brief The version of the format, changed whenever the layout changes. */
+#define GRAPH_CACHE_VERSION 1
+
+/** @brief The extension of the compiled files, which replaces ".dot". */
+#define GRAPH_CACHE_EXTENSION ".cgr"
+
+/**
+ * @brief Returns the name of the compiled file of @p fileName: its name with ".dot" replaced by GRAPH_CACHE_EXTENSION (or with it appended).
+ * 
+ * @param fileName The name of a graph file.
+ * @return char* The name of the compiled file, to be freed.
+ */
+char *getGraphCacheName(const char *fileName);
+
+/**
+ * @brief Tells if @p fileName is the name of a compiled file.
+ * 
+ * @param fileName The name of a file.
+ * @return true iff it ends with GRAPH_CACHE_EXTENSION.
+ */
+bool isGraphCacheName(const char *fileName);
+
+/**
+ * @brief Tells if the compiled file of @p fileName exists and is not older than it.
+ * 
+ * @param fileName The name of a graph file.
+ * @return true iff its compiled file can be used instead of it.
+ */
+bool isGraphCacheFresh(const char *fileName);
+
+/**
+ * @brief Writes @p graph in the compiled format.
+ * 
+ * @param graph A graph.
+ * @param cacheName The name of the compiled file.
+ * @return true if the file was written, false otherwise.
+ */
+bool writeGraphCache(Graph graph, const char *cacheName);
+
+/**
+ * @brief Loads a compiled file by mapping it in memory. The edges and the names of the graph point into the mapping, which is released by deleteGraph.
+ * 
+ * @param cacheName The name of the compiled file.
+ * @param graph The Graph in which the loaded graph is written.
+ * @return true if the graph was loaded, false if the file cannot be mapped, does not have the right header and size, or holds edges or names
+ *         out of bounds.
+ */
+bool loadGraphCache(const char *cacheName, Graph *graph);
+
+#endif
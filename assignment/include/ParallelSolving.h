@@ -0,0 +1,122 @@
+/**
+ * @file ParallelSolving.h
+ * @brief Solving spread over several threads, each with its own Z3 context while the graphs are shared and only read. The exploration by depth
+ *        (-s) checks several lengths at the same time, and the portfolio races several ways of solving the same question. The threads whose work
+ *        is not needed any more are interrupted.
+ * @version 1
+ * 
+ * @copyright Creative Commons.
+ * 
+ */
+
+#ifndef COCA_PARALLELSOLVING_H_
+#define COCA_PARALLELSOLVING_H_
+
+#include "Graph.h"
+
+/**
+ * @brief The answer for a length of the exploration.
+ */
+typedef enum {
+    LENGTH_UNKNOWN,     ///< The length has not been checked.
+    LENGTH_SAT,         ///< Every graph has an accepting path of this length.
+    LENGTH_UNSAT,       ///< A graph has no accepting path of this length.
+    LENGTH_UNDEF,       ///< The solver could not decide.
+    LENGTH_CANCELLED    ///< The check was interrupted since a length earlier in the exploration is satisfiable.
+} LengthResult;
+
+/**
+ * @brief The answers of an exploration by depth, indexed by length.
+ */
+typedef struct {
+    int maxLength;          ///< The largest length.
+    LengthResult *results;  ///< The answer for each length from 0 to @p maxLength.
+    int **paths;            ///< For each satisfiable length k, the paths of every graph (the one of graph i from index i*(k+1)) if they were asked for, else NULL.
+} SweepResults;
+
+/**
+ * @brief Checks the lengths from 0 to @p maxLength with @p numThreads threads, in increasing order or in decreasing order. The settings of the current
+ *        thread (encodings and pruning) are used by all threads.
+ * 
+ * @param graphs An array of graphs.
+ * @param numGraphs The number of graphs in @p graphs.
+ * @param maxLength The largest length.
+ * @param decreasing Tells if the lengths are explored in decreasing order.
+ * @param all Tells if every length is wanted, instead of the first satisfiable one in the order of the exploration.
+ * @param incremental Tells if each thread keeps an incremental solver for the lengths it checks, over windows of lengths given by getLengthWindowSolver.
+ * @param wantPaths Tells if the paths of the satisfiable lengths are wanted.
+ * @param numThreads The number of threads.
+ * @return SweepResults The answers, to be freed with deleteSweepResults. The lengths after the first satisfiable one may be unknown or cancelled.
+ */
+SweepResults parallelSweep(Graph *graphs, int numGraphs, int maxLength, bool decreasing, bool all, bool incremental, bool wantPaths, int numThreads);
+
+/**
+ * @brief Frees the memory occupied by @p results.
+ * 
+ * @param results The answers of parallelSweep.
+ */
+void deleteSweepResults(SweepResults results);
+
+/**
+ * @brief The answer of a portfolio.
+ */
+typedef struct {
+    LengthResult result;    ///< LENGTH_SAT if all graphs have an accepting path of a common length, LENGTH_UNSAT if they have none, else LENGTH_UNDEF.
+    int pathLength;         ///< The common length found, if any.
+    int *paths;             ///< The paths of this length if they were asked for (the one of graph i from index i*(pathLength+1)), else NULL.
+    int winner;             ///< The number of the configuration which answered first, -1 if none did.
+} PortfolioResult;
+
+/**
+ * @brief Returns the number of configurations raced by portfolioSolve.
+ * 
+ * @return int The number of configurations.
+ */
+int getNumPortfolioConfigurations(void);
+
+/**
+ * @brief Returns the name of the configuration number @p configuration of the portfolio, e.g. "global/onehot" or "decreasing/binary".
+ * 
+ * @param configuration The number of a configuration.
+ * @return const char* Its name.
+ */
+const char *getPortfolioConfigurationName(int configuration);
+
+/**
+ * @brief Tells if all graphs of @p graphs have an accepting path of a common length between 1 and the smallest order minus one, like the global
+ *        formula, by racing one thread per configuration: the global formula and the explorations by increasing or decreasing length, with
+ *        different encodings. The first definitive answer is kept and the other threads are interrupted. The pruning of the current thread is used.
+ * 
+ * @param graphs An array of graphs.
+ * @param numGraphs The number of graphs in @p graphs.
+ * @param wantPaths Tells if the paths are wanted.
+ * @return PortfolioResult The answer, whose paths are to be freed with free.
+ */
+PortfolioResult portfolioSolve(Graph *graphs, int numGraphs, bool wantPaths);
+
+/**
+ * @brief Computes, for each graph of @p graphs alone, the lengths between @p minLength and @p maxLength of its simple accepting paths, then
+ *        intersects them. The formula of a graph shares no variable with the others, so each graph gets its own context and incremental solver,
+ *        which enumerates its lengths by excluding each length found. The graphs are spread over @p numThreads threads. The lengths ruled out by a
+ *        graph are excluded from the others, and once no common length is left, or unless @p all is true once a length is found in every graph,
+ *        the remaining threads are interrupted. The settings of the current thread (encodings and pruning) are used by all threads.
+ * 
+ * @param graphs An array of graphs.
+ * @param numGraphs The number of graphs in @p graphs.
+ * @param minLength The smallest length.
+ * @param maxLength The largest length.
+ * @param all Tells if every length is wanted. Otherwise the lengths not decided when a common length is found are left unknown.
+ * @param wantPaths Tells if the paths of the common lengths are wanted.
+ * @param numThreads The number of threads.
+ * @return SweepResults The answer for each length, to be freed with deleteSweepResults. The lengths below @p minLength are unknown.
+ */
+SweepResults separableSolve(Graph *graphs, int numGraphs, int minLength, int maxLength, bool all, bool wantPaths, int numThreads);
+
+/**
+ * @brief Returns the number of processors available.
+ * 
+ * @return int The number of processors, at least 1.
+ */
+int getNumProcessors(void);
+
+#endif
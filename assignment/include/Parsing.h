@@ -19,11 +19,23 @@
 
 /**
  * @brief Parses a file and return the Graph described by it. If the file with the name given in argument does not exists, it displays an error message and exits the program.
+ *        The file is first loaded with getGraphFromMappedFile, then with flex and bison if it fails.
  * 
  * @param toRead the name of a file in graphviz format.
  * @return GraphList The parsed GraphList.
  */
 Graph getGraphFromFile(char *toRead);
 
+/**
+ * @brief Parses a file by mapping it in memory and scanning the mapping directly, without copying the names before the graph is built. Used first by
+ *        getGraphFromFile, which falls back to the flex and bison parser when this one fails.
+ * 
+ * @param toRead the name of a file in graphviz format.
+ * @param graph the Graph in which the parsed graph is written.
+ * @return true if the graph was parsed.
+ * @return false if the file cannot be mapped or is not in the syntax handled (then nothing is printed).
+ */
+bool getGraphFromMappedFile(char *toRead, Graph *graph);
+
 
 #endif
\ No newline at end of file
@@ -0,0 +1,99 @@
+/**
+ * @file Preprocessing.h
+ * @brief Analysis of a graph done before encoding it: the distances from the source and to the target tell which node can be at which position of
+ *        an accepting path, so that the variables of the other pairs (node, position) are never generated, and the lengths of the walks from the
+ *        source to the target tell which lengths are worth checking at all.
+ * @version 1
+ * 
+ * @copyright Creative Commons.
+ * 
+ */
+
+#ifndef COCA_PREPROCESSING_H_
+#define COCA_PREPROCESSING_H_
+
+#include <limits.h>
+#include "Graph.h"
+
+/** @brief The distance of a node which is not reachable. */
+#define UNREACHABLE INT_MAX
+
+/**
+ * @brief The distances of the nodes of a graph from its source and to its target, i.e. the ones used by the formulae (the first of each).
+ */
+typedef struct {
+    int numNodes;    ///< The number of nodes of the graph.
+    int source;      ///< The source, -1 if there is none.
+    int target;      ///< The target, -1 if there is none.
+    int *fromSource; ///< The number of edges of a shortest path from the source to each node, UNREACHABLE if there is none.
+    int *toTarget;   ///< The number of edges of a shortest path from each node to the target, UNREACHABLE if there is none.
+} Distances;
+
+/**
+ * @brief Computes the distances of the nodes of @p graph with a breadth first search from its source, and one from its target following the edges
+ *        backwards.
+ * 
+ * @param graph A graph.
+ * @return Distances Its distances, to be freed with deleteDistances.
+ */
+Distances computeDistances(Graph graph);
+
+/**
+ * @brief Frees the memory occupied by @p distances.
+ * 
+ * @param distances The distances to delete.
+ */
+void deleteDistances(Distances distances);
+
+/**
+ * @brief Tells if @p node lies on a path from the source to the target. The other nodes are never in an accepting path.
+ * 
+ * @param distances The distances of a graph.
+ * @param node A node of the graph.
+ * @return true iff @p node is reachable from the source and reaches the target.
+ */
+bool isNodeUseful(Distances distances, int node);
+
+/**
+ * @brief Tells if @p node may be at position @p position of an accepting path of length @p pathLength, i.e. if it is reachable in at most
+ *        @p position steps and reaches the target in at most @p pathLength - @p position steps.
+ * 
+ * @param distances The distances of a graph.
+ * @param node A node of the graph.
+ * @param position The position in the path.
+ * @param pathLength The length of the path.
+ * @return false if no accepting path of length @p pathLength has @p node at position @p position.
+ */
+bool isNodeFeasible(Distances distances, int node, int position, int pathLength);
+
+/**
+ * @brief Computes the lengths of the walks (paths which may repeat nodes) from the source to the target of @p graph, by propagating the set of nodes
+ *        reachable in exactly k steps for each k up to @p maxLength. Since every simple path is a walk, a length missing here has no accepting path.
+ * 
+ * @param graph A graph.
+ * @param maxLength The largest length considered.
+ * @return bool* An array of @p maxLength+1 booleans, true at index k iff there is a walk of length k, to be freed with free.
+ */
+bool *computeWalkLengths(Graph graph, int maxLength);
+
+/**
+ * @brief Computes the lengths up to @p maxLength of a walk from the source to the target in every graph of @p graphs, i.e. the intersection of
+ *        their computeWalkLengths. Only these lengths can have a common accepting path.
+ * 
+ * @param graphs An array of graphs.
+ * @param numGraphs The number of graphs in @p graphs.
+ * @param maxLength The largest length considered.
+ * @return bool* An array of @p maxLength+1 booleans, to be freed with free.
+ */
+bool *computeCommonWalkLengths(Graph *graphs, int numGraphs, int maxLength);
+
+/**
+ * @brief Tells if at least one length is true in @p lengths.
+ * 
+ * @param lengths An array given by computeCommonWalkLengths.
+ * @param maxLength The largest length of @p lengths.
+ * @return true iff one of the lengths between 0 and @p maxLength is possible.
+ */
+bool hasCandidateLength(bool *lengths, int maxLength);
+
+#endif
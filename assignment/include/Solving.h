@@ -15,6 +15,13 @@
 
 #include "Graph.h"
 #include <z3.h>
+#include "Cardinality.h"
+#include "Preprocessing.h"
+
+/**
+ * @brief The value of k given to getNodeVariable to get the variables shared by all lengths, used by graphsToUnifiedFormula.
+ */
+#define ANY_LENGTH -1
 
 /**
  * @brief Generates a formula consisting of a variable representing the fact that @p node of graph number @p number is at position @p position of an accepting path.
@@ -23,12 +30,120 @@
  * @param ctx, The solver context. Le contexte du solveur.
  * @param number, The number of the graph. Le numéro du graphe.
  * @param position, The position in the path. La position du chemin.
- * @param k, The mysterious k from the subject of this assignment. Le k dans x_i,j,k,q.
+ * @param k, The mysterious k from the subject of this assignment, or ANY_LENGTH. Le k dans x_i,j,k,q, ou ANY_LENGTH.
  * @param node, The node identifier. L'identifiant du noeud.
  * @return Z3_ast, The formula. La formule.
  */
 Z3_ast getNodeVariable(Z3_context ctx, int number, int position, int k, int node);
 
+/**
+ * @brief Generates the negation of the variable given by getNodeVariable. The negation is only built once when the table of variables is set.
+ * Génère la négation de la variable donnée par getNodeVariable. La négation n'est construite qu'une fois quand la table des variables est en place.
+ * 
+ * @param ctx, The solver context. Le contexte du solveur.
+ * @param number, The number of the graph. Le numéro du graphe.
+ * @param position, The position in the path. La position du chemin.
+ * @param k, The length of the path. La longueur du chemin.
+ * @param node, The node identifier. L'identifiant du noeud.
+ * @return Z3_ast, The formula. La formule.
+ */
+Z3_ast getNegNodeVariable(Z3_context ctx, int number, int position, int k, int node);
+
+/**
+ * @brief Chooses the encoding of the at-most-one constraints of the formulae built by the current thread afterwards (one node per position, and
+ *        each node at most once in the path). The default is the sequential counter.
+ * Choisit l'encodage des contraintes « au plus un » des formules construites ensuite par le thread courant (un noeud par position, et chaque noeud au
+ * plus une fois dans le chemin). Par défaut, le compteur séquentiel.
+ * 
+ * @param encoding, The encoding. L'encodage.
+ */
+void setAmoEncoding(AmoEncoding encoding);
+
+/**
+ * @brief Returns the encoding of the at-most-one constraints used by the current thread.
+ * Renvoie l'encodage des contraintes « au plus un » utilisé par le thread courant.
+ * 
+ * @return AmoEncoding, The encoding. L'encodage.
+ */
+AmoEncoding getAmoEncoding(void);
+
+/**
+ * @brief The ways of encoding the node at each position of a path.
+ */
+typedef enum {
+    NODE_ONEHOT,    ///< One variable X_i,j,k,q per node q and position j, true if q is at position j.
+    NODE_BINARY     ///< The identifier of the node at position j is written on ceil(log2(n)) variables B_i,j,k,b.
+} NodeEncoding;
+
+/**
+ * @brief Chooses the encoding of the nodes of the paths in the formulae built by the current thread afterwards, and in the models read by it.
+ *        The default is NODE_ONEHOT.
+ * Choisit l'encodage des noeuds des chemins dans les formules construites ensuite par le thread courant, et dans les modèles qu'il lit.
+ * Par défaut, NODE_ONEHOT.
+ * 
+ * @param encoding, The encoding. L'encodage.
+ */
+void setNodeEncoding(NodeEncoding encoding);
+
+/**
+ * @brief Returns the encoding of the nodes of the paths used by the current thread.
+ * Renvoie l'encodage des noeuds des chemins utilisé par le thread courant.
+ * 
+ * @return NodeEncoding, The encoding. L'encodage.
+ */
+NodeEncoding getNodeEncoding(void);
+
+/**
+ * @brief Enables or disables, for the formulae built by the current thread afterwards, the pruning of the pairs (node, position) that no accepting
+ *        path can use, given the distances of the nodes from the source and to the target. Their variables are then never generated. Enabled by default.
+ * Active ou désactive, pour les formules construites ensuite par le thread courant, l'élagage des couples (noeud, position) qu'aucun chemin acceptant ne
+ * peut utiliser, d'après les distances des noeuds depuis la source et vers la cible. Leurs variables ne sont alors jamais générées. Activé par défaut.
+ * 
+ * @param enabled, Tells if the pruning is enabled. Indique si l'élagage est activé.
+ */
+void setPruning(bool enabled);
+
+/**
+ * @brief Tells if the current thread prunes the impossible pairs (node, position).
+ * Indique si le thread courant élague les couples (noeud, position) impossibles.
+ * 
+ * @return bool, true iff the pruning is enabled. true ssi l'élagage est activé.
+ */
+bool getPruning(void);
+
+/**
+ * @brief Tells if the variable of @p node at position @p position is generated for a path of length @p pathLength.
+ * Indique si la variable du noeud node à la position position est générée pour un chemin de longueur pathLength.
+ * 
+ * @param distances, The distances of the graph, or NULL if the pruning is disabled. Les distances du graphe, ou NULL si l'élagage est désactivé.
+ * @param node, The node identifier. L'identifiant du noeud.
+ * @param position, The position in the path. La position dans le chemin.
+ * @param pathLength, The length of the path, or the largest one for the formula shared by all lengths. La longueur du chemin, ou la plus grande pour
+ * la formule commune à toutes les longueurs.
+ * @return bool, true iff the pair is not pruned. true ssi le couple n'est pas élagué.
+ */
+bool isNodeAllowed(Distances *distances, int node, int position, int pathLength);
+
+/**
+ * @brief Sets the table of node variables of @p graphs for the current thread. From then on, getNodeVariable and getNegNodeVariable create each
+ *        variable of these graphs once and store it in a dense array, instead of naming it on every call, and so do the bits of the binary encoding.
+ *        Must be freed with deleteNodeVariables.
+ * Met en place la table des variables de noeuds de graphs pour le thread courant. Dès lors, getNodeVariable et getNegNodeVariable créent chaque variable
+ * de ces graphes une seule fois et la rangent dans un tableau dense, au lieu de la nommer à chaque appel, de même que les bits de l'encodage binaire.
+ * Doit être libérée avec deleteNodeVariables.
+ * 
+ * @param ctx, The solver context. Le contexte du solveur.
+ * @param graphs, An array of graphs. Une suite de graphes.
+ * @param numGraphs, The number of graphs in @p graphs. Le nombre de graphes dans graphs.
+ */
+void initNodeVariables(Z3_context ctx, Graph *graphs, unsigned int numGraphs);
+
+/**
+ * @brief Frees the table of node variables of the current thread, if there is one.
+ * Libère la table des variables de noeuds du thread courant, s'il y en a une.
+ */
+void deleteNodeVariables(void);
+
 /**
  * @brief Generates a SAT formula satisfiable if and only if all graphs of @p graphs contain an accepting path of length @p pathLength.
  * Génère une formule SAT satisfaisable si et seulement si tous les graphes de graphs contiennent un chemin acceptant de longueur pathLength.
@@ -41,6 +156,120 @@ Z3_ast getNodeVariable(Z3_context ctx, int number, int position, int k, int node
  */
 Z3_ast graphsToPathFormula( Z3_context ctx, Graph *graphs,unsigned int numGraphs, int pathLength);
 
+/**
+ * @brief Generates the selector variable stating that the common path has length @p pathLength, in the formulae shared by all lengths.
+ * Génère la variable sélecteur indiquant que le chemin commun est de longueur pathLength, dans les formules communes à toutes les longueurs.
+ * 
+ * @param ctx, The solver context. Le contexte du solveur.
+ * @param pathLength, The length of the path. La longueur du chemin.
+ * @return Z3_ast, The selector variable. La variable sélecteur.
+ */
+Z3_ast getLengthSelector(Z3_context ctx, int pathLength);
+
+/**
+ * @brief Generates a SAT formula satisfiable if and only if all graphs of @p graphs contain an accepting path of a common length between @p minLength
+ *        and @p maxLength. Its variables are those of getNodeVariable with k = ANY_LENGTH, and exactly one selector of getLengthSelector is true in its
+ *        models: the one of the length of the paths.
+ * Génère une formule SAT satisfaisable si et seulement si tous les graphes de graphs contiennent un chemin acceptant d'une longueur commune entre
+ * minLength et maxLength. Ses variables sont celles de getNodeVariable avec k = ANY_LENGTH, et exactement un sélecteur de getLengthSelector est vrai dans
+ * ses modèles : celui de la longueur des chemins.
+ * 
+ * @param ctx, The solver context. Le contexte du solveur.
+ * @param graphs, An array of graphs. Une suite de graphes.
+ * @param numGraphs, The number of graphs in @p graphs. Le nombre de graphes dans graphs.
+ * @param minLength, The smallest length. La plus petite longueur.
+ * @param maxLength, The largest length. La plus grande longueur.
+ * @return Z3_ast, The formula. La formule.
+ */
+Z3_ast graphsToUnifiedFormula(Z3_context ctx, Graph *graphs, unsigned int numGraphs, int minLength, int maxLength);
+
+/**
+ * @brief Adds the formula of graphsToUnifiedFormula to @p solver. Each length can then be checked with isPathLengthSat, and everything the solver
+ *        learns on a length is kept for the other ones since they share their variables.
+ * Ajoute la formule de graphsToUnifiedFormula à solver. Chaque longueur peut ensuite être vérifiée avec isPathLengthSat, et tout ce que le solveur
+ * apprend sur une longueur est conservé pour les autres puisqu'elles partagent leurs variables.
+ * 
+ * @param ctx, The solver context. Le contexte du solveur.
+ * @param solver, A solver created by makeSolver. Un solveur créé par makeSolver.
+ * @param graphs, An array of graphs. Une suite de graphes.
+ * @param numGraphs, The number of graphs in @p graphs. Le nombre de graphes dans graphs.
+ * @param minLength, The smallest length. La plus petite longueur.
+ * @param maxLength, The largest length. La plus grande longueur.
+ * @return Z3_ast, The formula added. La formule ajoutée.
+ */
+Z3_ast addUnifiedFormulaToSolver(Z3_context ctx, Z3_solver solver, Graph *graphs, unsigned int numGraphs, int minLength, int maxLength);
+
+/**
+ * @brief Tells if all graphs contain an accepting path of length @p pathLength, using the formula added to @p solver by addUnifiedFormulaToSolver.
+ * Dit si tous les graphes contiennent un chemin acceptant de longueur pathLength, en utilisant la formule ajoutée à solver par addUnifiedFormulaToSolver.
+ * 
+ * @param ctx, The solver context. Le contexte du solveur.
+ * @param solver, A solver created by makeSolver. Un solveur créé par makeSolver.
+ * @param pathLength, The length of the path to check. La longueur du chemin à vérifier.
+ * @return Z3_lbool, The answer of the solver. La réponse du solveur.
+ */
+Z3_lbool isPathLengthSat(Z3_context ctx, Z3_solver solver, int pathLength);
+
+/**
+ * @brief Definitely excludes the length @p pathLength from the next checks of @p solver, once it has been decided.
+ * Exclut définitivement la longueur pathLength des vérifications suivantes de solver, une fois qu'elle a été décidée.
+ * 
+ * @param ctx, The solver context. Le contexte du solveur.
+ * @param solver, A solver created by makeSolver. Un solveur créé par makeSolver.
+ * @param pathLength, The length excluded. La longueur exclue.
+ */
+void retractPathFormulaFromSolver(Z3_context ctx, Z3_solver solver, int pathLength);
+
+/**
+ * @brief The incremental solver of an exploration by depth, whose formula only covers a window of lengths: the first check does not pay for the
+ *        formula of every length. Once the exploration leaves the window, the next one is twice as wide.
+ * Le solveur incrémental d'une exploration en profondeur, dont la formule ne couvre qu'une fenêtre de longueurs : la première vérification ne paie pas
+ * la formule de toutes les longueurs. Une fois que l'exploration sort de la fenêtre, la suivante est deux fois plus large.
+ */
+typedef struct {
+    Z3_solver solver;   ///< The solver of the window, NULL before the first length. Le solveur de la fenêtre.
+    Z3_ast formula;     ///< The formula added to the solver. La formule ajoutée au solveur.
+    int first;          ///< The smallest length of the window. La plus petite longueur de la fenêtre.
+    int last;           ///< The largest length of the window. La plus grande longueur de la fenêtre.
+    int width;          ///< The number of lengths of the next window. Le nombre de longueurs de la prochaine fenêtre.
+} LengthWindow;
+
+/**
+ * @brief Initializes an empty window.
+ * Initialise une fenêtre vide.
+ * 
+ * @param window, The window. La fenêtre.
+ */
+void initLengthWindow(LengthWindow *window);
+
+/**
+ * @brief Gives the solver of @p window, replaced by the one of the next window if @p pathLength is not in it. The next window starts at
+ *        @p pathLength and goes in the order of the exploration, within [@p minLength, @p maxLength]. The length checked must then be retracted with
+ *        retractPathFormulaFromSolver.
+ * Donne le solveur de window, remplacé par celui de la fenêtre suivante si pathLength n'en fait pas partie. La fenêtre suivante commence à pathLength
+ * et va dans l'ordre de l'exploration, dans [minLength, maxLength]. La longueur vérifiée doit ensuite être exclue avec retractPathFormulaFromSolver.
+ * 
+ * @param ctx, The solver context. Le contexte du solveur.
+ * @param window, The window. La fenêtre.
+ * @param graphs, An array of graphs. Une suite de graphes.
+ * @param numGraphs, The number of graphs in @p graphs. Le nombre de graphes dans graphs.
+ * @param pathLength, The length to check. La longueur à vérifier.
+ * @param minLength, The smallest length of the exploration. La plus petite longueur de l'exploration.
+ * @param maxLength, The largest length of the exploration. La plus grande longueur de l'exploration.
+ * @param decreasing, Tells if the lengths are explored in decreasing order. Dit si les longueurs sont explorées par ordre décroissant.
+ * @return Z3_solver, The solver, whose formula covers @p pathLength. Le solveur, dont la formule couvre pathLength.
+ */
+Z3_solver getLengthWindowSolver(Z3_context ctx, LengthWindow *window, Graph *graphs, unsigned int numGraphs, int pathLength, int minLength, int maxLength, bool decreasing);
+
+/**
+ * @brief Frees the solver of @p window, if there is one.
+ * Libère le solveur de window, s'il y en a un.
+ * 
+ * @param ctx, The solver context. Le contexte du solveur.
+ * @param window, The window. La fenêtre.
+ */
+void deleteLengthWindow(Z3_context ctx, LengthWindow *window);
+
 /**
  * @brief Generates a SAT formula satisfiable if and only if all graphs of @p graphs contain an accepting path of common length.
  * Génère une formule SAT satisfaisable si et seulement si tous les graphes de graphs contiennent un chemin acceptant de longueur commune.
@@ -48,21 +277,98 @@ Z3_ast graphsToPathFormula( Z3_context ctx, Graph *graphs,unsigned int numGraphs
  * @param ctx, The solver context. Le contexte du solveur.
  * @param graphs, An array of graphs. Une suite de graphes.
  * @param numGraphs, The number of graphs in @p graphs. Le numéro (indice ?) du graphe dans graphs.
- * @return Z3_ast, The formula. La formule.
+ * @return Z3_ast, The formula, or NULL if the bounds or the pruning show that no length is possible. La formule, ou NULL si les bornes ou l'élagage
+ *         montrent qu'aucune longueur n'est possible.
  */
 Z3_ast graphsToFullFormula( Z3_context ctx, Graph *graphs,unsigned int numGraphs);
 
 /**
- * @brief Gets the length of the solution from a given model.
- * Obtient la longueur de la solution d'un modèle donné.
+ * @brief Gets the length of the solution from a model of a formula shared by all lengths, i.e. the length whose selector is true. It is read in
+ *        the binary register written by the formula for the selected length, in log2 n lookups, when the thread has a table of initNodeVariables.
+ *        A model of the formula of a single length has no selector: its length is the one checked.
+ * Obtient la longueur de la solution d'un modèle d'une formule commune à toutes les longueurs, c'est-à-dire la longueur dont le sélecteur est vrai. Elle
+ * est lue dans le registre binaire écrit par la formule pour la longueur choisie, en log2 n lectures, quand le thread a une table de initNodeVariables.
+ * Un modèle de la formule d'une seule longueur n'a pas de sélecteur : sa longueur est celle vérifiée.
  * 
  * @param ctx, The solver context. Le contexte du solveur.
  * @param model, A variable assignment. Une affectation de variables (exemple : x1 = Vrai, x2 = Faux, X3 = Vrai).
  * @param graphs, An array of graphs. Une liste de graphes.
- * @return int, The length of a common simple accepting path in all graphs from @p graphs. La longueur d'un chemin simple et acceptant dans tous les graphes de graphs.
- */ 
+ * @return int, The length of a common simple accepting path in all graphs from @p graphs, or -1 if no selector is true. La longueur d'un chemin
+ * simple et acceptant dans tous les graphes de graphs, ou -1 si aucun sélecteur n'est vrai.
+ */
 int getSolutionLengthFromModel(Z3_context ctx, Z3_model model, Graph *graphs);
 
+/**
+ * @brief Computes, without any solver, the lengths up to @p maxLength of a simple accepting path common to all graphs of @p graphs. Each graph is
+ *        explored by a depth first search of its simple paths, which gives up a path as soon as the lengths it can still reach are not wanted any
+ *        more: a length is only searched in a graph if the previous graphs have a path of this length. The search gives up once the budget of the
+ *        query runs out (see Budget.h), after which only the lengths found are known.
+ * Calcule, sans solveur, les longueurs jusqu'à maxLength d'un chemin simple acceptant commun à tous les graphes de graphs. Chaque graphe est exploré
+ * par un parcours en profondeur de ses chemins simples, qui abandonne un chemin dès que les longueurs qu'il peut encore atteindre ne sont plus
+ * recherchées : une longueur n'est cherchée dans un graphe que si les graphes précédents ont un chemin de cette longueur. La recherche abandonne
+ * quand le budget de la requête est épuisé (voir Budget.h), après quoi seules les longueurs trouvées sont connues.
+ * 
+ * @param graphs, An array of graphs. Une liste de graphes.
+ * @param numGraphs, The number of graphs in @p graphs. Le nombre de graphes dans graphs.
+ * @param maxLength, The largest length. La plus grande longueur.
+ * @return bool*, An array of @p maxLength+1 booleans, true at index k iff every graph has a simple accepting path of length k, to be freed with free.
+ *         Un tableau de maxLength+1 booléens, vrai à l'indice k ssi chaque graphe a un chemin simple acceptant de longueur k, à libérer avec free.
+ */
+bool *graphsToSimplePathLengths(Graph *graphs, unsigned int numGraphs, int maxLength);
+
+/**
+ * @brief Searches, without any solver, a simple accepting path of length @p pathLength in every graph of @p graphs, with the same depth first search
+ *        as graphsToSimplePathLengths. The search stops at the first graph without such a path.
+ * Cherche, sans solveur, un chemin simple acceptant de longueur pathLength dans chaque graphe de graphs, avec le même parcours en profondeur que
+ * graphsToSimplePathLengths. La recherche s'arrête au premier graphe sans un tel chemin.
+ * 
+ * @param graphs, An array of graphs. Une liste de graphes.
+ * @param numGraphs, The number of graphs in @p graphs. Le nombre de graphes dans graphs.
+ * @param pathLength, The length of the paths. La longueur des chemins.
+ * @param paths, NULL, or the array of size @p numGraphs*(@p pathLength+1) in which the path of graph i is written from index i*(@p pathLength+1).
+ *        NULL, ou le tableau dans lequel le chemin du graphe i est écrit à partir de l'indice i*(pathLength+1).
+ * @return bool, true iff every graph has such a path, false if the budget of the query runs out first. true ssi chaque graphe a un tel chemin, false
+ *         si le budget de la requête est épuisé avant.
+ */
+bool graphsHaveSimplePath(Graph *graphs, unsigned int numGraphs, int pathLength, int *paths);
+
+/**
+ * @brief Displays the paths of length @p pathLength of each graphs in @p graphs.
+ * Affiche les chemins de longueur pathLength de tous les graphes.
+ * 
+ * @param graphs, An array of graphs. Une liste de graphes.
+ * @param numGraph, The number of graphs in @p graphs. Le nombre de graphes dans graphs.
+ * @param pathLength, The length of path. La longueur du chemin.
+ * @param paths, The paths, the one of graph i starting at index i*(@p pathLength+1). Les chemins, celui du graphe i commençant à l'indice i*(pathLength+1).
+ */
+void printPaths(Graph *graphs, int numGraph, int pathLength, int *paths);
+
+/**
+ * @brief Creates the file ("%s-l%d.dot",name,pathLength) representing the paths @p paths.
+ * Crée le fichier représentant les chemins paths.
+ * 
+ * @param graphs, An array of graphs. Une liste de graphes.
+ * @param numGraph, The number of graphs in @p graphs. Le nombre de graphes dans graphs.
+ * @param pathLength, The length of path. La longueur du chemin.
+ * @param paths, The paths, the one of graph i starting at index i*(@p pathLength+1). Les chemins, celui du graphe i commençant à l'indice i*(pathLength+1).
+ * @param name, The name of the output file. Le nom du fichier en sortie.
+ */
+void createDotFromPaths(Graph *graphs, int numGraph, int pathLength, int *paths, char* name);
+
+/**
+ * @brief Reads in @p model the paths of length @p pathLength of every graph of @p graphs.
+ * Lit dans model les chemins de longueur pathLength de tous les graphes de graphs.
+ * 
+ * @param ctx, The solver context. Le contexte du solveur.
+ * @param model, A variable assignment. Une affectation de variables.
+ * @param graphs, An array of graphs. Une liste de graphes.
+ * @param numGraph, The number of graphs in @p graphs. Le nombre de graphes dans graphs.
+ * @param pathLength, The length of the paths. La longueur des chemins.
+ * @return int*, The array of size @p numGraph*(@p pathLength+1) whose block i holds the path of graph i, to be freed with free.
+ *         Le tableau dont le bloc i contient le chemin du graphe i, à libérer avec free.
+ */
+int *getPathsFromModel(Z3_context ctx, Z3_model model, Graph *graphs, int numGraph, int pathLength);
+
 /**
  * @brief Displays the paths of length @p pathLength of each graphs in @p graphs described by @p model.
  * Affiche les chemins de longueur pathLength pour tous les graphes décrits dans model.
@@ -0,0 +1,101 @@
+/**
+ * @file Statistics.h
+ * @brief Statistics of a run, gathered only once enableStatistics is called: the time spent in each phase (parsing, encoding, solving and reading
+ *        the models), the size of the formulae built, the number of solver calls and the statistics of the Z3 solvers. They are shared by all
+ *        threads and written as JSON by printStatistics.
+ * @version 1
+ *
+ * @copyright Creative Commons.
+ *
+ */
+
+#ifndef COCA_STATISTICS_H_
+#define COCA_STATISTICS_H_
+
+#include <stdio.h>
+#include <z3.h>
+
+/**
+ * @brief The phases of a run.
+ */
+typedef enum {
+    PHASE_PARSE,    ///< Reading the graph files.
+    PHASE_ENCODE,   ///< Building the formulae.
+    PHASE_SOLVE,    ///< Solving the formulae.
+    PHASE_DECODE,   ///< Reading the lengths and paths in the models.
+    NUM_PHASES      ///< The number of phases.
+} StatisticsPhase;
+
+/**
+ * @brief The kinds of formulae whose size is measured.
+ */
+typedef enum {
+    FORMULA_PHI1,       ///< ɸ1 of the formula of a length: the path starts at the source.
+    FORMULA_PHI2,       ///< ɸ2: the path ends at the target.
+    FORMULA_PHI3,       ///< ɸ3: each position holds a node.
+    FORMULA_PHI4,       ///< ɸ4: each position holds at most one node.
+    FORMULA_PHI5,       ///< ɸ5: each node is at most once in the path.
+    FORMULA_PHI6,       ///< ɸ6: consecutive nodes are linked by an edge.
+    FORMULA_PRUNING,    ///< The nodes ruled out by the distances, with the binary encoding.
+    FORMULA_UNIFIED,    ///< The formula shared by all lengths.
+    NUM_FORMULA_KINDS   ///< The number of kinds.
+} FormulaKind;
+
+/**
+ * @brief Starts gathering the statistics. Until then, the functions of this module do nothing. To be called before the threads are started.
+ */
+void enableStatistics(void);
+
+/**
+ * @brief Tells if the statistics are gathered.
+ *
+ * @return true iff enableStatistics was called.
+ */
+bool areStatisticsEnabled(void);
+
+/**
+ * @brief Returns the time of a monotonic clock, to be given to addPhaseTime at the end of the phase.
+ *
+ * @return double The time in seconds.
+ */
+double getStatisticsClock(void);
+
+/**
+ * @brief Adds to @p phase the time elapsed since @p start.
+ *
+ * @param phase A phase.
+ * @param start The time given by getStatisticsClock at the start of the phase.
+ */
+void addPhaseTime(StatisticsPhase phase, double start);
+
+/**
+ * @brief Counts a formula of kind @p kind, with its number of distinct terms and of variables.
+ *
+ * @param ctx The context of the formula.
+ * @param kind The kind of the formula.
+ * @param formula The formula.
+ */
+void addFormulaStatistics(Z3_context ctx, FormulaKind kind, Z3_ast formula);
+
+/**
+ * @brief Counts a call to the solver.
+ */
+void addSolverCall(void);
+
+/**
+ * @brief Adds the statistics of @p solver (conflicts, decisions, propagations, ...) to the ones of the solvers already deleted. To be called once,
+ *        before deleting it, since the statistics of a solver cover all its checks.
+ *
+ * @param ctx The context of the solver.
+ * @param solver A solver.
+ */
+void addSolverStatistics(Z3_context ctx, Z3_solver solver);
+
+/**
+ * @brief Writes the statistics gathered so far as a JSON object on a single line. To be called once enableStatistics was called.
+ *
+ * @param file The file written.
+ */
+void printStatistics(FILE *file);
+
+#endif
@@ -58,6 +58,87 @@ Z3_lbool isFormulaSat(Z3_context ctx, Z3_ast formula);
  */
 Z3_model getModelFromSatFormula(Z3_context ctx, Z3_ast formula);
 
+/**
+ * @brief Sets the limits of every check of the solvers created afterwards by makeSolver, in every thread. A check which reaches one of them answers
+ *        Z3_L_UNDEF, and getUnknownReason tells which one. Must be called before any thread is started, since the limits are read without a lock.
+ * Fixe les limites de chaque vérification des solveurs créés ensuite par makeSolver, dans tous les threads. Une vérification qui en atteint une répond
+ * Z3_L_UNDEF, et getUnknownReason dit laquelle. Doit être appelée avant de lancer un thread, car les limites sont lues sans verrou.
+ *
+ * @param timeout, The time of a check in milliseconds, 0 for no limit. It is lowered to the time left when the query has a budget (see Budget.h).
+ * La durée d'une vérification en millisecondes, 0 pour aucune limite. Elle est réduite au temps restant quand la requête a un budget (voir Budget.h).
+ * @param maxMemory, The memory of the solver in megabytes, 0 for no limit. La mémoire du solveur en mégaoctets, 0 pour aucune limite.
+ * @param maxConflicts, The number of conflicts of a check, 0 for no limit. Le nombre de conflits d'une vérification, 0 pour aucune limite.
+ */
+void setSolverLimits(unsigned int timeout, unsigned int maxMemory, unsigned int maxConflicts);
+
+/**
+ * @brief Creates a solver meant to be kept alive across several checks, so that the clauses it learns are reused from one check to the next.
+ *        Must be freed with deleteSolver.
+ * Crée un solveur destiné à être conservé entre plusieurs vérifications, pour que les clauses apprises soient réutilisées d'une vérification à l'autre.
+ * Doit être libéré avec deleteSolver.
+ *
+ * @param ctx, The context of the solver. Le contexte du solveur.
+ * @return Z3_solver, The created solver. Le solveur créé.
+ */
+Z3_solver makeSolver(Z3_context ctx);
+
+/**
+ * @brief Frees a solver created by makeSolver, after adding its statistics to the ones of the run.
+ * Libère un solveur créé par makeSolver, après avoir ajouté ses statistiques à celles de l'exécution.
+ *
+ * @param ctx, The context of the solver. Le contexte du solveur.
+ * @param solver, The solver to free. Le solveur à libérer.
+ */
+void deleteSolver(Z3_context ctx, Z3_solver solver);
+
+/**
+ * @brief Tells if the formulae asserted in @p solver are satisfiable. The time of the check is counted in the statistics.
+ * Dit si les formules ajoutées à solver sont satisfaisables. La durée de la vérification est comptée dans les statistiques.
+ *
+ * @param ctx, The context of the solver. Le contexte du solveur.
+ * @param solver, A solver created by makeSolver. Un solveur créé par makeSolver.
+ * @return Z3_lbool, Z3_L_FALSE if unsatisfiable, Z3_L_TRUE if satisfiable and Z3_L_UNDEF if the solver cannot decide.
+ * Renvoie Z3_L_FALSE si non-satisfaisable, Z3_L_TRUE si satisfaisable, et Z3_L_UNDEF si le solveur ne peut pas décider.
+ */
+Z3_lbool checkSolver(Z3_context ctx, Z3_solver solver);
+
+/**
+ * @brief Tells if the formulae asserted in @p solver are satisfiable when all formulae of @p assumptions are supposed true. The assumptions are only
+ *        valid for this check.
+ * Dit si les formules ajoutées à solver sont satisfaisables en supposant vraies toutes les formules de assumptions. Les hypothèses ne valent que pour
+ * cette vérification.
+ *
+ * @param ctx, The context of the solver. Le contexte du solveur.
+ * @param solver, A solver created by makeSolver. Un solveur créé par makeSolver.
+ * @param numAssumptions, The number of formulae in @p assumptions. Le nombre de formules dans assumptions.
+ * @param assumptions, An array of variables or negated variables. Un tableau de variables ou de négations de variables.
+ * @return Z3_lbool, Z3_L_FALSE if unsatisfiable, Z3_L_TRUE if satisfiable and Z3_L_UNDEF if the solver cannot decide.
+ * Renvoie Z3_L_FALSE si non-satisfaisable, Z3_L_TRUE si satisfaisable, et Z3_L_UNDEF si le solveur ne peut pas décider.
+ */
+Z3_lbool isSatUnderAssumptions(Z3_context ctx, Z3_solver solver, unsigned int numAssumptions, Z3_ast *assumptions);
+
+/**
+ * @brief Tells why the last check of the current thread answered Z3_L_UNDEF, for instance "timeout", "max. memory exceeded", "max. conflicts
+ *        reached", "canceled" or BUDGET_EXHAUSTED_REASON when the budget of the query had run out before the check.
+ * Dit pourquoi la dernière vérification du thread courant a répondu Z3_L_UNDEF, par exemple "timeout", "max. memory exceeded", "max. conflicts
+ * reached", "canceled" ou BUDGET_EXHAUSTED_REASON quand le budget de la requête était épuisé avant la vérification.
+ *
+ * @return const char*, The reason given by Z3, valid until the next check of the thread. La raison donnée par Z3, valide jusqu'à la prochaine vérification du thread.
+ */
+const char *getUnknownReason(void);
+
+/**
+ * @brief Returns the model found by the last check of @p solver. Must only be called after a check that did not answer Z3_L_FALSE.
+ *        The model must be freed with Z3_model_dec_ref.
+ * Renvoie le modèle trouvé par la dernière vérification de solver. Ne doit être appelée qu'après une vérification n'ayant pas répondu Z3_L_FALSE.
+ * Le modèle doit être libéré avec Z3_model_dec_ref.
+ *
+ * @param ctx, The context of the solver. Le contexte du solveur.
+ * @param solver, A solver created by makeSolver. Un solveur créé par makeSolver.
+ * @return Z3_model, The model of the last check. Le modèle de la dernière vérification.
+ */
+Z3_model getModelFromSolver(Z3_context ctx, Z3_solver solver);
+
 /**
  * @brief Returns the truth value of the formula @p variable in the variable assignment @p model. Very usefull if @p variable is a formula containing a single variable.
  * Renvoie la valeur de vérité de la formule nommée variable dans l'affectation model. Très utile si variable est une formule contenant une seule variable.
@@ -70,4 +151,30 @@ Z3_model getModelFromSatFormula(Z3_context ctx, Z3_ast formula);
  */
 bool valueOfVarInModel(Z3_context ctx, Z3_model model, Z3_ast variable);
 
+/**
+ * @brief Returns the value given by @p model to the variable @p variable, read directly in the assignment instead of evaluating a formula. A variable
+ *        absent from @p model is false, as with valueOfVarInModel.
+ * Renvoie la valeur donnée par model à la variable variable, lue directement dans l'affectation au lieu d'évaluer une formule. Une variable absente de
+ * model est fausse, comme avec valueOfVarInModel.
+ * 
+ * @param ctx, The context of the solver. Le contexte du solveur.
+ * @param model, A variable assignment. Une affectation de variables.
+ * @param variable, A boolean variable. Une variable booléenne.
+ * @return true iff @p variable is true in @p model. Vrai ssi variable est vraie dans model.
+ */
+bool isVariableTrueInModel(Z3_context ctx, Z3_model model, Z3_ast variable);
+
+/**
+ * @brief Counts the distinct terms of @p formula, a term shared by several subformulae being counted once. This is the size of the formula as
+ *        stored by Z3.
+ * Compte les termes distincts de formula, un terme partagé par plusieurs sous-formules n'étant compté qu'une fois. C'est la taille de la formule
+ * telle que Z3 la stocke.
+ * 
+ * @param ctx, The context of the solver. Le contexte du solveur.
+ * @param formula, A formula. Une formule.
+ * @param numVariables, If not NULL, receives the number of variables of @p formula. Si non NULL, reçoit le nombre de variables de formula.
+ * @return long, The number of distinct terms of @p formula. Le nombre de termes distincts de formula.
+ */
+long countFormulaNodes(Z3_context ctx, Z3_ast formula, long *numVariables);
+
 #endif
\ No newline at end of file
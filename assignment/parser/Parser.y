@@ -150,34 +150,31 @@ a_list : attr_assignment                { $$ = $1;}
                                           }}
     ;
 
-attr_assignment : idrhs T_EQ idrhs   { if (strcmp($1,"initial")==0) $$ = Init; else if(strcmp($1,"final")==0) $$ = Final; else $$ = None; free($1); free($3);}
+attr_assignment : idrhs T_EQ idrhs   { if (strcmp($1,"initial")==0) $$ = Init; else if(strcmp($1,"final")==0) $$ = Final; else $$ = None;}
     ;
 								
-idrhs : T_ID        { $$ = (char*)malloc((strlen($1)+1)*sizeof(char)); strcpy($$,$1);
+idrhs : T_ID        { $$ = copyStringInArena(&graph->arena,$1);
                     }
-    | T_STRING      { $$ = (char*)malloc((strlen($1)+1)*sizeof(char)); strcpy($$,$1);
+    | T_STRING      { $$ = copyStringInArena(&graph->arena,$1);
                     }
 		;        
 
 node_stmt : node_id 
     | node_id attr_list     {   switch($2)
                                 {
-                                    case Init: if(graph->nodes == NULL) graph->nodes = addNode($1,true,false,NULL); else addOrUpdateNode($1,true,false,graph->nodes); break;
-                                    case Final: if(graph->nodes == NULL) graph->nodes = addNode($1,false,true,NULL); else addOrUpdateNode($1,false,true,graph->nodes); break;
-                                    case InitFinal: if(graph->nodes == NULL) graph->nodes = addNode($1,true,true,NULL); else addOrUpdateNode($1,true,true,graph->nodes); break;
-                                    case None: if(graph->nodes == NULL) graph->nodes = addNode($1,false,false,NULL); else addOrUpdateNode($1,false,false,graph->nodes); break;
+                                    case Init: addOrUpdateGraphNode(graph,$1,true,false); break;
+                                    case Final: addOrUpdateGraphNode(graph,$1,false,true); break;
+                                    case InitFinal: addOrUpdateGraphNode(graph,$1,true,true); break;
+                                    case None: addOrUpdateGraphNode(graph,$1,false,false); break;
                                 }
-                                free($1);
                             }
     ;
 
 node_id : T_ID      { 
-                      $$ = (char*)malloc((strlen($1)+1)*sizeof(char)); strcpy($$,$1);
-                      if(graph->nodes == NULL) graph->nodes = addNode($1,false,false,NULL); else addOrUpdateNode($1,false,false,graph->nodes);
+                      $$ = addOrUpdateGraphNode(graph,$1,false,false)->node;
                     }
     | T_ID port     { 
-                      $$ = (char*)malloc((strlen($1)+1)*sizeof(char)); strcpy($$,$1);
-                      if(graph->nodes == NULL) graph->nodes = addNode($1,false,false,NULL); else addOrUpdateNode($1,false,false,graph->nodes);
+                      $$ = addOrUpdateGraphNode(graph,$1,false,false)->node;
                     }
     ;
 
@@ -195,12 +192,10 @@ port_angle : T_AT T_ID
     ;
 
 edge_stmt : node_id edgerhs         { //printf("edge seen: (%s,%s)\n",$1,$2);
-                                      graph->edges = addEdge($1,$2,graph->edges);
-                                      free($1); free($2);
+                                      addGraphEdge(graph,$1,$2);
                                     }
     | node_id edgerhs attr_list     { //printf("edge seen: (%s,%s)\n",$1,$2);
-                                      graph->edges = addEdge($1,$2,graph->edges);
-                                      free($1); free($2);
+                                      addGraphEdge(graph,$1,$2);
                                     }
     | subgraph edgerhs 
     | subgraph edgerhs attr_list 
@@ -210,8 +205,7 @@ edgerhs : edgeop node_id        { //printf("edge end seen\n");
                                   $$ = $2;
                                 }
     | edgeop node_id edgerhs    {
-                                  graph->edges = addEdge($2,$3,graph->edges);
-                                  free($3);
+                                  addGraphEdge(graph,$2,$3);
                                   $$ = $2;
                                 }
     ;
@@ -0,0 +1,67 @@
+/**
+ * @file Arena.h
+ * @brief  Region allocator for the temporary structures of a parse. The memory is taken from large blocks and is only freed all at once, when the
+ *         arena is deleted, which saves a call to malloc and free per node, edge and name.
+ * @version 1
+ * 
+ * @copyright Creative Commons.
+ * 
+ */
+
+#ifndef COCA_ARENA_H_
+#define COCA_ARENA_H_
+
+#include <stddef.h>
+
+/**
+ * @brief A block of an arena. Its memory follows the structure.
+ */
+typedef struct tagArenaBlock
+{
+    struct tagArenaBlock *next; ///< The previous block of the arena.
+    size_t size;                ///< The number of bytes of the block.
+    size_t used;                ///< The number of bytes already given.
+} ArenaBlock;
+
+/**
+ * @brief The Arena structure.
+ */
+typedef struct
+{
+    ArenaBlock *blocks;     ///< The current block, followed by the previous ones, or NULL.
+} Arena;
+
+/**
+ * @brief Creates an empty arena. No memory is taken before the first allocation.
+ * 
+ * @return Arena The arena, to be deleted with deleteArena.
+ */
+Arena makeArena(void);
+
+/**
+ * @brief Allocates @p size bytes in @p arena, aligned for any type. Exits the program if there is not enough memory.
+ * 
+ * @param arena An arena.
+ * @param size The number of bytes.
+ * @return void* The memory, valid until the arena is deleted.
+ */
+void *allocateInArena(Arena *arena, size_t size);
+
+/**
+ * @brief Copies a string in @p arena.
+ * 
+ * @param arena An arena.
+ * @param string The string to copy.
+ * @return char* The copy, valid until the arena is deleted.
+ */
+char *copyStringInArena(Arena *arena, const char *string);
+
+/**
+ * @brief Frees all the memory of an arena at once.
+ * 
+ * @param arena The arena to delete.
+ */
+void deleteArena(Arena arena);
+
+
+#endif /* COCA_ARENA_H_ */
@@ -12,6 +12,8 @@
 #ifndef COCA_EDGELIST_H_
 #define COCA_EDGELIST_H_
 
+#include "Arena.h"
+
 
 /**
  * @brief The EdgeList structure
@@ -33,6 +35,17 @@ typedef struct tagSEdgeList
 
 SEdgeList *addEdge(char* n1, char* n2, SEdgeList *list);
 
+/**
+ * @brief Adds an edge in front of a list (works if list is null), allocating it in an arena. The names are not copied, so they must live as long as
+ *        the arena, for instance by being stored in it. Such a list is freed with the arena, not with deleteExpression.
+ * @param arena the arena to allocate from.
+ * @param n1 the left node
+ * @param n2 the right node
+ * @param list the list to append to
+ * @return the new list.
+ */
+SEdgeList *addEdgeInArena(Arena *arena, char* n1, char* n2, SEdgeList *list);
+
 /**
  * @brief Prints an EdgeList.
  * 
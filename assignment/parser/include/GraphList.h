@@ -14,15 +14,66 @@
 
 #include "EdgeList.h"
 #include "NodeList.h"
+#include "NodeTable.h"
+#include "Arena.h"
 
 /**
- * @brief The EdgeList structure. Contains a list of nodes and a list of edges.
+ * @brief The EdgeList structure. Contains a list of nodes and a list of edges, with a table to find the nodes by their names.
+ *        The cells of both lists and the names are allocated in the arena of the GraphList, each name once, and are all freed with it.
  */
 typedef struct tagGraphList
 {
 	SNodeList *nodes;
     SEdgeList *edges;
+    SNodeList *lastNode;    ///< The last node of nodes, to append a node in constant time.
+    NodeTable nodeTable;    ///< The nodes of nodes indexed by their names.
+    Arena arena;            ///< The memory of the lists and of the names.
 } GraphList;
 
+/**
+ * @brief Creates an empty GraphList.
+ * 
+ * @return GraphList The GraphList, to be deleted with deleteGraphList.
+ */
+GraphList makeGraphList(void);
+
+/**
+ * @brief If a node named n is in the graph, updates its initial and final status with the arguments given. Otherwise, adds the node at the end of the
+ *        list of nodes, with the next index. Takes constant time.
+ * 
+ * @param graph the GraphList to modify.
+ * @param n the node to modify or add.
+ * @param isInit tells if the node is initial.
+ * @param isFinal tells if the node is final.
+ * @return SNodeList* the node, whose name is the copy of n stored in the arena of graph.
+ */
+SNodeList *addOrUpdateGraphNode(GraphList *graph, char *n, bool isInit, bool isFinal);
+
+/**
+ * @brief Adds the edge (n1,n2) in front of the list of edges of graph. Its ends are added as nodes if they are not yet, and the edge refers to their
+ *        names stored in the arena, without copying them.
+ * 
+ * @param graph the GraphList to modify.
+ * @param n1 the left node.
+ * @param n2 the right node.
+ */
+void addGraphEdge(GraphList *graph, char *n1, char *n2);
+
+/**
+ * @brief Returns the index of the node named n, i.e. its position in the list of nodes. Takes constant time.
+ * 
+ * @param graph a GraphList.
+ * @param n the node to search.
+ * @return int the index of n, or -1 if it is not a node of graph.
+ */
+int getNodeIndex(GraphList *graph, char *n);
+
+/**
+ * @brief Deletes a GraphList, with its lists and its table, by freeing its arena.
+ * 
+ * @param graph the GraphList to delete.
+ */
+void deleteGraphList(GraphList graph);
+
 
 #endif /* DOT_PARSER_GRAPHLIST_H_ */
@@ -18,6 +18,7 @@
 
 /**
  * @brief Creates a Graph object from a GraphList. Does NOT free the source, so it must be destroyed independently.
+ *        The ends of the edges are found with the node table of the source, so the translation takes linear time.
  * 
  * @param source the GraphList to reinterpret as a graph.
  * @return Graph the graph corresponding to the source.
@@ -13,16 +13,19 @@
 #ifndef COCA_NODELIST_H_
 #define COCA_NODELIST_H_
 
+#include "Arena.h"
+
 
 
 /**
- * @brief The NodeList structure
+ * @brief The NodeList structure. index is the position of the node in the list of a GraphList, and -1 for a node added with addNode.
  */
 typedef struct tagSNodeList
 {
 	char* node;
     bool initial;
     bool final;
+    int index;
     struct tagSNodeList *next;
 } SNodeList;
 
@@ -37,6 +40,18 @@ typedef struct tagSNodeList
 
 SNodeList *addNode(char* n1,bool isInit, bool isFinal, SNodeList *list);
 
+/**
+ * @brief Adds a node in front of a list (works if list is null), allocating it and a copy of its name in an arena. Such a list is freed with the arena,
+ *        not with deleteNodeList.
+ * @param arena the arena to allocate from.
+ * @param n1 the node
+ * @param isInit tells if the node is initial
+ * @param isFinal tells if the node is final
+ * @param list the list to append to
+ * @return the new list.
+ */
+SNodeList *addNodeInArena(Arena *arena, char* n1, bool isInit, bool isFinal, SNodeList *list);
+
 /**
  * @brief If n is present in the list, updates its initial and final status with the arguments given. Otherwise, adds the node at the end of the list.
  * 
@@ -0,0 +1,58 @@
+/**
+ * @file NodeTable.h
+ * @brief  Hash table from the names of the nodes of a NodeList to the nodes themselves. Built during parsing so that finding a node by its name takes
+ *         constant time, both when a node statement updates a node and when the edges are translated into a graph.
+ * @version 1
+ * 
+ * @copyright Creative Commons.
+ * 
+ */
+
+#ifndef COCA_NODETABLE_H_
+#define COCA_NODETABLE_H_
+
+#include "NodeList.h"
+
+/**
+ * @brief The NodeTable structure: an open addressing table of nodes indexed by their names.
+ */
+typedef struct
+{
+    int capacity;       ///< The number of slots, a power of two.
+    int numNodes;       ///< The number of nodes in the table.
+    SNodeList **slots;  ///< The nodes, or NULL for an empty slot.
+} NodeTable;
+
+/**
+ * @brief Creates an empty table.
+ * 
+ * @return NodeTable The table, to be deleted with deleteNodeTable.
+ */
+NodeTable makeNodeTable(void);
+
+/**
+ * @brief Deletes a table. The nodes it contains are not freed.
+ * 
+ * @param table The table to delete.
+ */
+void deleteNodeTable(NodeTable table);
+
+/**
+ * @brief Finds the node named @p name in @p table.
+ * 
+ * @param table A table.
+ * @param name The name of a node.
+ * @return SNodeList* The node, or NULL if it is not in the table.
+ */
+SNodeList *findNodeInTable(NodeTable *table, const char *name);
+
+/**
+ * @brief Adds a node to @p table. Its name must not be in the table yet.
+ * 
+ * @param table A table.
+ * @param node The node to add.
+ */
+void addNodeToTable(NodeTable *table, SNodeList *node);
+
+
+#endif /* COCA_NODETABLE_H_ */
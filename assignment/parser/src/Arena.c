@@ -0,0 +1,79 @@
+/**
+ * @file Arena.c
+ * @brief  Region allocator for the temporary structures of a parse.
+ * @version 1
+ * 
+ * @copyright Creative Commons.
+ * 
+ */
+
+
+#include "Arena.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ARENA_ALIGNMENT 16
+#define ARENA_BLOCK_SIZE 65536
+
+/**
+ * @brief Rounds a size up to the alignment of the arena.
+ * @param size the size.
+ * @return the rounded size.
+ */
+static size_t alignSize(size_t size)
+{
+    return (size+ARENA_ALIGNMENT-1) & ~(size_t)(ARENA_ALIGNMENT-1);
+}
+
+
+Arena makeArena(void)
+{
+    Arena arena;
+    arena.blocks = NULL;
+    return arena;
+}
+
+void *allocateInArena(Arena *arena, size_t size)
+{
+    size = alignSize(size);
+    ArenaBlock *block = arena->blocks;
+    if (block == NULL || block->used+size > block->size)
+    {
+        // Each block is twice as large as the previous one, so that a parse only needs a logarithmic number of them.
+        size_t blockSize = block == NULL ? ARENA_BLOCK_SIZE : 2*block->size;
+        while (blockSize < size)
+            blockSize *= 2;
+        block = (ArenaBlock *)malloc(alignSize(sizeof(ArenaBlock))+blockSize);
+        if (block == NULL)
+        {
+            printf("Not enough memory to allocate block in allocateInArena\n");
+            exit(EXIT_FAILURE);
+        }
+        block->next = arena->blocks;
+        block->size = blockSize;
+        block->used = 0;
+        arena->blocks = block;
+    }
+    void *memory = (char *)block+alignSize(sizeof(ArenaBlock))+block->used;
+    block->used += size;
+    return memory;
+}
+
+char *copyStringInArena(Arena *arena, const char *string)
+{
+    size_t length = strlen(string)+1;
+    char *copy = (char *)allocateInArena(arena,length);
+    memcpy(copy,string,length);
+    return copy;
+}
+
+void deleteArena(Arena arena)
+{
+    while (arena.blocks != NULL)
+    {
+        ArenaBlock *next = arena.blocks->next;
+        free(arena.blocks);
+        arena.blocks = next;
+    }
+}
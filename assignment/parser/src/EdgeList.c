@@ -53,23 +53,36 @@ SEdgeList *addEdge(char *n1, char *n2, SEdgeList *list)
     return b;
 }
 
+SEdgeList *addEdgeInArena(Arena *arena, char *n1, char *n2, SEdgeList *list)
+{
+    SEdgeList *b = (SEdgeList *)allocateInArena(arena,sizeof(SEdgeList));
+
+    b->node1 = n1;
+    b->node2 = n2;
+
+    b->next = list;
+
+    return b;
+}
+
 void printEdgeList(SEdgeList *e)
 {
-	if(e == NULL) { printf("\n"); return;}
-	printf("(%s,%s) -- ",e->node1,e->node2);
-	printEdgeList(e->next);
+	for(; e != NULL; e = e->next)
+		printf("(%s,%s) -- ",e->node1,e->node2);
+	printf("\n");
 }
 
 void deleteExpression(SEdgeList *b)
 {
-    if (b == NULL)
-        return;
+    while (b != NULL)
+    {
+        SEdgeList *next = b->next;
 
-    deleteExpression(b->next);
+        free(b->node1);
+        free(b->node2);
 
-    free(b->node1);
-    free(b->node2);
+        free(b);
 
-    free(b);
+        b = next;
+    }
 }
-
@@ -0,0 +1,67 @@
+/**
+ * @file GraphList.c
+ * @brief  Structure to store a graph that can be dynamically modified. Used as a temporary structure during parsing before translating into a more static structure.
+ * @version 1
+ * 
+ * @copyright Creative Commons.
+ * 
+ */
+
+
+#include "GraphList.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+GraphList makeGraphList(void)
+{
+    GraphList graph;
+    graph.nodes = NULL;
+    graph.edges = NULL;
+    graph.lastNode = NULL;
+    graph.nodeTable = makeNodeTable();
+    graph.arena = makeArena();
+    return graph;
+}
+
+SNodeList *addOrUpdateGraphNode(GraphList *graph, char *n, bool isInit, bool isFinal)
+{
+    SNodeList *node = findNodeInTable(&graph->nodeTable,n);
+    if (node != NULL)
+    {
+        node->initial = node->initial || isInit;
+        node->final = node->final || isFinal;
+        return node;
+    }
+
+    node = addNodeInArena(&graph->arena,n,isInit,isFinal,NULL);
+    node->index = graph->nodeTable.numNodes;
+    if (graph->lastNode == NULL) graph->nodes = node;
+    else graph->lastNode->next = node;
+    graph->lastNode = node;
+    addNodeToTable(&graph->nodeTable,node);
+    return node;
+}
+
+void addGraphEdge(GraphList *graph, char *n1, char *n2)
+{
+    char *name1 = addOrUpdateGraphNode(graph,n1,false,false)->node;
+    char *name2 = addOrUpdateGraphNode(graph,n2,false,false)->node;
+    graph->edges = addEdgeInArena(&graph->arena,name1,name2,graph->edges);
+}
+
+int getNodeIndex(GraphList *graph, char *n)
+{
+    SNodeList *node = findNodeInTable(&graph->nodeTable,n);
+    if (node == NULL)
+        return -1;
+    return node->index;
+}
+
+void deleteGraphList(GraphList graph)
+{
+    deleteNodeTable(graph.nodeTable);
+    deleteArena(graph.arena);
+}
@@ -24,6 +24,8 @@ Graph createGraph(GraphList source){
 
 	res.numNodes=0;
 	res.numEdges=0;
+	res.mapping=NULL;
+	res.mappingSize=0;
 	SNodeList *explore = source.nodes;
 
 	int count = 0;
@@ -35,7 +37,6 @@ Graph createGraph(GraphList source){
 
 	//printf("nodes: %d\n",count);
 
-	res.edges = (int *)malloc(res.numNodes*res.numNodes*sizeof(int));
 	res.nodes = (char **)malloc(res.numNodes*sizeof(char*));
 
 	//Ajout pour les automates.
@@ -62,20 +63,26 @@ Graph createGraph(GraphList source){
 	printf("\n");
 	*/
 
-	for(int i = 0; i<res.numNodes;i++)
-		for(int j = 0; j<res.numNodes;j++)
-			res.edges[i*res.numNodes+j] = 0;
-
-
 	SEdgeList *exploreBis = source.edges;
+	count = 0;
+	while(exploreBis != NULL){
+		count++;
+		exploreBis = exploreBis->next;
+	}
+	int *sources = (int *)malloc((count+1)*sizeof(int));
+	int *targets = (int *)malloc((count+1)*sizeof(int));
+
+	count = 0;
+	exploreBis = source.edges;
 	while(exploreBis != NULL){
-		int n1,n2;
-		n1=findNode(res.nodes,res.numNodes,exploreBis->node1);
-		n2=findNode(res.nodes,res.numNodes,exploreBis->node2);
-		res.edges[n1*res.numNodes+n2] = 1;
+		sources[count]=getNodeIndex(&source,exploreBis->node1);
+		targets[count]=getNodeIndex(&source,exploreBis->node2);
 		exploreBis = exploreBis->next;
-		res.numEdges++;
+		count++;
 	}
+	setEdges(&res,count,sources,targets);
+	free(sources);
+	free(targets);
 
 	return res;
 }
\ No newline at end of file
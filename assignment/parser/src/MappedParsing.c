@@ -0,0 +1,576 @@
+/**
+ * @file MappedParsing.c
+ * @brief  Loader of graphviz files which maps the file in memory and scans the mapping directly, without flex, bison nor intermediate lists.
+ *         The names are slices of the mapping until the Graph is built, and the attributes other than initial and final are skipped without being
+ *         copied. Handles the syntax accepted by Parser.y; anything else is left to it.
+ * @version 1
+ *
+ * @copyright Creative Commons.
+ *
+ */
+
+
+#include "Parsing.h"
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define INITIAL_CAPACITY 64
+
+/**
+ * @brief The tokens of the graphviz syntax, as in Lexer.l.
+ */
+typedef enum {TOKEN_END, TOKEN_ERROR, TOKEN_ID, TOKEN_STRING, TOKEN_LBRACKET, TOKEN_RBRACKET, TOKEN_LPAREN, TOKEN_RPAREN, TOKEN_LBRACE, TOKEN_RBRACE,
+              TOKEN_COMMA, TOKEN_COLON, TOKEN_SEMI, TOKEN_EDGEOP, TOKEN_EQ, TOKEN_DIGRAPH, TOKEN_GRAPH, TOKEN_SUBGRAPH, TOKEN_AT, TOKEN_STRICT,
+              TOKEN_NODE, TOKEN_EDGE} TokenKind;
+
+/**
+ * @brief The state of a parse: the scanner over the mapping, and the nodes and edges found so far.
+ */
+typedef struct
+{
+    const char *cursor;     ///< The first character not scanned yet.
+    const char *end;        ///< The end of the mapping.
+    TokenKind kind;         ///< The kind of the current token.
+    const char *start;      ///< The first character of the current token.
+    int length;             ///< The length of the current token.
+
+    int numNodes;           ///< The number of nodes.
+    int nodeCapacity;       ///< The size of the arrays of the nodes.
+    const char **names;     ///< The name of each node, as a slice of the mapping.
+    int *lengths;           ///< The length of the name of each node.
+    bool *initial;          ///< Tells if each node is initial.
+    bool *final;            ///< Tells if each node is final.
+    int slotCapacity;       ///< The number of slots of the table, a power of two.
+    int *slots;             ///< The table from the names to the nodes, -1 for an empty slot.
+
+    int numEdges;           ///< The number of edges.
+    int edgeCapacity;       ///< The size of the arrays of the edges.
+    int *sources;           ///< The source of each edge.
+    int *targets;           ///< The target of each edge.
+} MappedParser;
+
+
+/**
+ * @brief Tells if a character can start a name, as anum in Lexer.l.
+ * @param c the character.
+ * @return true iff c is a letter, a digit or '_'.
+ */
+static bool isNameStart(char c)
+{
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+}
+
+/**
+ * @brief Tells if the current token is the keyword given, ignoring case.
+ * @param parser the parser.
+ * @param keyword the keyword.
+ * @return true iff the token is the keyword.
+ */
+static bool isKeyword(MappedParser *parser, const char *keyword)
+{
+    return parser->length == (int)strlen(keyword) && strncasecmp(parser->start,keyword,parser->length) == 0;
+}
+
+/**
+ * @brief Tells if the current token is the name given.
+ * @param parser the parser.
+ * @param name the name.
+ * @return true iff the token is the name.
+ */
+static bool isToken(MappedParser *parser, const char *name)
+{
+    return parser->length == (int)strlen(name) && strncmp(parser->start,name,parser->length) == 0;
+}
+
+/**
+ * @brief Scans the next token of the mapping.
+ * @param parser the parser.
+ */
+static void nextToken(MappedParser *parser)
+{
+    const char *c = parser->cursor, *end = parser->end;
+    while (c < end)
+    {
+        if (*c == ' ' || *c == '\t' || *c == '\n')
+            c++;
+        else if (*c == '/' && c+1 < end && c[1] == '/')
+        {
+            const char *line = (const char *)memchr(c,'\n',end-c);
+            c = line == NULL ? end : line;
+        }
+        else
+            break;
+    }
+    parser->start = c;
+    if (c == end)
+    {
+        parser->kind = TOKEN_END;
+        parser->length = 0;
+        parser->cursor = c;
+        return;
+    }
+    parser->kind = TOKEN_ERROR;
+    const char *next = c+1;
+    switch (*c)
+    {
+        case '[': parser->kind = TOKEN_LBRACKET; break;
+        case ']': parser->kind = TOKEN_RBRACKET; break;
+        case '(': parser->kind = TOKEN_LPAREN; break;
+        case ')': parser->kind = TOKEN_RPAREN; break;
+        case '{': parser->kind = TOKEN_LBRACE; break;
+        case '}': parser->kind = TOKEN_RBRACE; break;
+        case ',': parser->kind = TOKEN_COMMA; break;
+        case ':': parser->kind = TOKEN_COLON; break;
+        case ';': parser->kind = TOKEN_SEMI; break;
+        case '=': parser->kind = TOKEN_EQ; break;
+        case '-':
+            if (next < end && (*next == '>' || *next == '-'))
+            {
+                parser->kind = TOKEN_EDGEOP;
+                next++;
+            }
+            break;
+        case '"':
+            while (next < end && *next != '"')
+                next += *next == '\\' && next+1 < end ? 2 : 1;
+            if (next < end)
+            {
+                parser->kind = TOKEN_STRING;
+                next++;
+            }
+            break;
+        default:
+            if (isNameStart(*c))
+            {
+                while (next < end && (isNameStart(*next) || *next == '.'))
+                    next++;
+                parser->kind = TOKEN_ID;
+            }
+            break;
+    }
+    parser->length = next-c;
+    parser->cursor = next;
+    if (parser->kind == TOKEN_ID)
+    {
+        if (isKeyword(parser,"digraph")) parser->kind = TOKEN_DIGRAPH;
+        else if (isKeyword(parser,"graph")) parser->kind = TOKEN_GRAPH;
+        else if (isKeyword(parser,"subgraph")) parser->kind = TOKEN_SUBGRAPH;
+        else if (isKeyword(parser,"at")) parser->kind = TOKEN_AT;
+        else if (isKeyword(parser,"strict")) parser->kind = TOKEN_STRICT;
+        else if (isKeyword(parser,"node")) parser->kind = TOKEN_NODE;
+        else if (isKeyword(parser,"edge")) parser->kind = TOKEN_EDGE;
+    }
+}
+
+/**
+ * @brief Skips the current token if it has the kind given.
+ * @param parser the parser.
+ * @param kind the kind expected.
+ * @return true iff the token had this kind.
+ */
+static bool accept(MappedParser *parser, TokenKind kind)
+{
+    if (parser->kind != kind)
+        return false;
+    nextToken(parser);
+    return true;
+}
+
+/**
+ * @brief Hashes a slice (FNV-1a).
+ * @param name the first character.
+ * @param length the length.
+ * @return the hash of the slice.
+ */
+static unsigned int hashSlice(const char *name, int length)
+{
+    unsigned int hash = 2166136261u;
+    for (int i = 0; i < length; i++)
+    {
+        hash ^= (unsigned char)name[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * @brief Reallocates an array, exiting if there is not enough memory.
+ * @param array the array.
+ * @param size the new size in bytes.
+ * @return the array.
+ */
+static void *growArray(void *array, size_t size)
+{
+    array = realloc(array,size);
+    if (array == NULL)
+    {
+        printf("Not enough memory to allocate arrays in MappedParsing\n");
+        exit(EXIT_FAILURE);
+    }
+    return array;
+}
+
+/**
+ * @brief Finds the node named by the current token, adding it if it is new.
+ * @param parser the parser.
+ * @return the index of the node.
+ */
+static int addCurrentNode(MappedParser *parser)
+{
+    unsigned int mask = parser->slotCapacity-1;
+    unsigned int i = hashSlice(parser->start,parser->length) & mask;
+    while (parser->slots[i] >= 0)
+    {
+        int node = parser->slots[i];
+        if (parser->lengths[node] == parser->length && memcmp(parser->names[node],parser->start,parser->length) == 0)
+            return node;
+        i = (i+1) & mask;
+    }
+    if (parser->numNodes == parser->nodeCapacity)
+    {
+        parser->nodeCapacity *= 2;
+        parser->names = (const char **)growArray(parser->names,parser->nodeCapacity*sizeof(const char *));
+        parser->lengths = (int *)growArray(parser->lengths,parser->nodeCapacity*sizeof(int));
+        parser->initial = (bool *)growArray(parser->initial,parser->nodeCapacity*sizeof(bool));
+        parser->final = (bool *)growArray(parser->final,parser->nodeCapacity*sizeof(bool));
+    }
+    int node = parser->numNodes++;
+    parser->names[node] = parser->start;
+    parser->lengths[node] = parser->length;
+    parser->initial[node] = false;
+    parser->final[node] = false;
+    parser->slots[i] = node;
+    // The table is kept at most half full, so that probe sequences stay short.
+    if (2*parser->numNodes > parser->slotCapacity)
+    {
+        parser->slotCapacity *= 2;
+        mask = parser->slotCapacity-1;
+        parser->slots = (int *)growArray(parser->slots,parser->slotCapacity*sizeof(int));
+        for (int j = 0; j < parser->slotCapacity; j++)
+            parser->slots[j] = -1;
+        for (int other = 0; other < parser->numNodes; other++)
+        {
+            unsigned int j = hashSlice(parser->names[other],parser->lengths[other]) & mask;
+            while (parser->slots[j] >= 0)
+                j = (j+1) & mask;
+            parser->slots[j] = other;
+        }
+    }
+    return node;
+}
+
+/**
+ * @brief Adds an edge.
+ * @param parser the parser.
+ * @param source the source of the edge.
+ * @param target the target of the edge.
+ */
+static void addMappedEdge(MappedParser *parser, int source, int target)
+{
+    if (parser->numEdges == parser->edgeCapacity)
+    {
+        parser->edgeCapacity *= 2;
+        parser->sources = (int *)growArray(parser->sources,parser->edgeCapacity*sizeof(int));
+        parser->targets = (int *)growArray(parser->targets,parser->edgeCapacity*sizeof(int));
+    }
+    parser->sources[parser->numEdges] = source;
+    parser->targets[parser->numEdges] = target;
+    parser->numEdges++;
+}
+
+/**
+ * @brief Parses a list of attributes ("[a=b, c=d][e=f]"), only keeping track of the initial and final ones.
+ * @param parser the parser.
+ * @param isInit set to true if one of the attributes is initial.
+ * @param isFinal set to true if one of the attributes is final.
+ * @return false in case of syntax error.
+ */
+static bool parseAttributes(MappedParser *parser, bool *isInit, bool *isFinal)
+{
+    if (!accept(parser,TOKEN_LBRACKET))
+        return false;
+    do
+    {
+        while (parser->kind != TOKEN_RBRACKET)
+        {
+            if (parser->kind != TOKEN_ID && parser->kind != TOKEN_STRING)
+                return false;
+            if (isToken(parser,"initial")) *isInit = true;
+            else if (isToken(parser,"final")) *isFinal = true;
+            nextToken(parser);
+            if (!accept(parser,TOKEN_EQ))
+                return false;
+            if (!accept(parser,TOKEN_ID) && !accept(parser,TOKEN_STRING))
+                return false;
+            if (accept(parser,TOKEN_COMMA) && parser->kind == TOKEN_RBRACKET)
+                return false;
+        }
+        nextToken(parser);
+    } while (accept(parser,TOKEN_LBRACKET));
+    return true;
+}
+
+/**
+ * @brief Parses a node identifier with its optional port, adding the node if it is new.
+ * @param parser the parser.
+ * @return the index of the node, or -1 in case of syntax error.
+ */
+static int parseNodeId(MappedParser *parser)
+{
+    if (parser->kind != TOKEN_ID)
+        return -1;
+    int node = addCurrentNode(parser);
+    nextToken(parser);
+    bool location = false, angle = false;
+    while (true)
+    {
+        if (!location && accept(parser,TOKEN_COLON))
+        {
+            location = true;
+            if (!accept(parser,TOKEN_ID))
+                return -1;
+            if (accept(parser,TOKEN_LPAREN))
+            {
+                if (!accept(parser,TOKEN_ID) || !accept(parser,TOKEN_COMMA) || !accept(parser,TOKEN_ID) || !accept(parser,TOKEN_RPAREN))
+                    return -1;
+            }
+        }
+        else if (!angle && accept(parser,TOKEN_AT))
+        {
+            angle = true;
+            if (!accept(parser,TOKEN_ID))
+                return -1;
+        }
+        else
+            return node;
+    }
+}
+
+/**
+ * @brief Parses the right hand side of an edge statement ("-> b -> c"), adding an edge between consecutive nodes.
+ * @param parser the parser.
+ * @param from the node on the left, or -1 for a subgraph, from which no edge is added.
+ * @return false in case of syntax error.
+ */
+static bool parseEdgeEnds(MappedParser *parser, int from)
+{
+    while (accept(parser,TOKEN_EDGEOP))
+    {
+        int to = parseNodeId(parser);
+        if (to < 0)
+            return false;
+        if (from >= 0)
+            addMappedEdge(parser,from,to);
+        from = to;
+    }
+    return true;
+}
+
+static bool parseStatements(MappedParser *parser);
+
+/**
+ * @brief Parses a subgraph ("subgraph name { ... }"), whose statements are added to the graph.
+ * @param parser the parser.
+ * @return false in case of syntax error.
+ */
+static bool parseSubgraph(MappedParser *parser)
+{
+    if (accept(parser,TOKEN_SUBGRAPH))
+        accept(parser,TOKEN_ID);
+    if (!accept(parser,TOKEN_LBRACE) || !parseStatements(parser))
+        return false;
+    return accept(parser,TOKEN_RBRACE);
+}
+
+/**
+ * @brief Parses a statement.
+ * @param parser the parser.
+ * @return false in case of syntax error.
+ */
+static bool parseStatement(MappedParser *parser)
+{
+    bool isInit = false, isFinal = false;
+    switch (parser->kind)
+    {
+        case TOKEN_GRAPH:
+        case TOKEN_NODE:
+        case TOKEN_EDGE:
+            nextToken(parser);
+            return parseAttributes(parser,&isInit,&isFinal);
+
+        case TOKEN_SUBGRAPH:
+        case TOKEN_LBRACE:
+            if (!parseSubgraph(parser))
+                return false;
+            if (parser->kind != TOKEN_EDGEOP)
+                return true;
+            if (!parseEdgeEnds(parser,-1))
+                return false;
+            return parser->kind != TOKEN_LBRACKET || parseAttributes(parser,&isInit,&isFinal);
+
+        case TOKEN_STRING:
+            nextToken(parser);
+            return accept(parser,TOKEN_EQ) && (accept(parser,TOKEN_ID) || accept(parser,TOKEN_STRING));
+
+        case TOKEN_ID:
+        {
+            // An identifier followed by '=' is a graph attribute, not a node.
+            const char *cursor = parser->cursor;
+            const char *start = parser->start;
+            int length = parser->length;
+            nextToken(parser);
+            if (accept(parser,TOKEN_EQ))
+                return accept(parser,TOKEN_ID) || accept(parser,TOKEN_STRING);
+            parser->cursor = cursor;
+            parser->start = start;
+            parser->length = length;
+            parser->kind = TOKEN_ID;
+
+            int node = parseNodeId(parser);
+            if (node < 0)
+                return false;
+            if (parser->kind == TOKEN_EDGEOP)
+            {
+                if (!parseEdgeEnds(parser,node))
+                    return false;
+                return parser->kind != TOKEN_LBRACKET || parseAttributes(parser,&isInit,&isFinal);
+            }
+            if (parser->kind == TOKEN_LBRACKET)
+            {
+                if (!parseAttributes(parser,&isInit,&isFinal))
+                    return false;
+                parser->initial[node] = parser->initial[node] || isInit;
+                parser->final[node] = parser->final[node] || isFinal;
+            }
+            return true;
+        }
+
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief Parses statements until the closing brace of the graph or subgraph, which is not consumed.
+ * @param parser the parser.
+ * @return false in case of syntax error.
+ */
+static bool parseStatements(MappedParser *parser)
+{
+    while (parser->kind != TOKEN_RBRACE)
+    {
+        if (!parseStatement(parser))
+            return false;
+        accept(parser,TOKEN_SEMI);
+    }
+    return true;
+}
+
+/**
+ * @brief Parses a whole graph.
+ * @param parser the parser.
+ * @return false in case of syntax error.
+ */
+static bool parseMappedGraph(MappedParser *parser)
+{
+    nextToken(parser);
+    accept(parser,TOKEN_STRICT);
+    if (!accept(parser,TOKEN_DIGRAPH) && !accept(parser,TOKEN_GRAPH))
+        return false;
+    if (!accept(parser,TOKEN_ID) || !accept(parser,TOKEN_LBRACE) || !parseStatements(parser))
+        return false;
+    return accept(parser,TOKEN_RBRACE) && parser->kind == TOKEN_END;
+}
+
+/**
+ * @brief Builds the Graph of a parse, copying the names out of the mapping.
+ * @param parser the parser.
+ * @return the graph.
+ */
+static Graph buildMappedGraph(MappedParser *parser)
+{
+    Graph graph;
+    graph.numNodes = parser->numNodes;
+    graph.mapping = NULL;
+    graph.mappingSize = 0;
+    graph.nodes = (char **)malloc((parser->numNodes+1)*sizeof(char *));
+    graph.initial = (bool *)malloc((parser->numNodes+1)*sizeof(bool));
+    graph.final = (bool *)malloc((parser->numNodes+1)*sizeof(bool));
+    if (graph.nodes == NULL || graph.initial == NULL || graph.final == NULL)
+    {
+        printf("Not enough memory to allocate graph in buildMappedGraph\n");
+        exit(EXIT_FAILURE);
+    }
+    for (int node = 0; node < parser->numNodes; node++)
+    {
+        graph.nodes[node] = (char *)malloc((parser->lengths[node]+1)*sizeof(char));
+        if (graph.nodes[node] == NULL)
+        {
+            printf("Not enough memory to allocate graph in buildMappedGraph\n");
+            exit(EXIT_FAILURE);
+        }
+        memcpy(graph.nodes[node],parser->names[node],parser->lengths[node]);
+        graph.nodes[node][parser->lengths[node]] = '\0';
+        graph.initial[node] = parser->initial[node];
+        graph.final[node] = parser->final[node];
+    }
+    setEdges(&graph,parser->numEdges,parser->sources,parser->targets);
+    return graph;
+}
+
+bool getGraphFromMappedFile(char *toRead, Graph *graph)
+{
+    int file = open(toRead,O_RDONLY);
+    if (file < 0)
+        return false;
+    struct stat status;
+    if (fstat(file,&status) != 0 || status.st_size == 0)
+    {
+        close(file);
+        return false;
+    }
+    size_t size = status.st_size;
+    void *mapping = mmap(NULL,size,PROT_READ,MAP_PRIVATE,file,0);
+    close(file);
+    if (mapping == MAP_FAILED)
+        return false;
+    madvise(mapping,size,MADV_SEQUENTIAL);
+
+    MappedParser parser;
+    parser.cursor = (const char *)mapping;
+    parser.end = parser.cursor+size;
+    parser.numNodes = 0;
+    parser.nodeCapacity = INITIAL_CAPACITY;
+    parser.names = (const char **)growArray(NULL,parser.nodeCapacity*sizeof(const char *));
+    parser.lengths = (int *)growArray(NULL,parser.nodeCapacity*sizeof(int));
+    parser.initial = (bool *)growArray(NULL,parser.nodeCapacity*sizeof(bool));
+    parser.final = (bool *)growArray(NULL,parser.nodeCapacity*sizeof(bool));
+    parser.slotCapacity = 2*INITIAL_CAPACITY;
+    parser.slots = (int *)growArray(NULL,parser.slotCapacity*sizeof(int));
+    for (int i = 0; i < parser.slotCapacity; i++)
+        parser.slots[i] = -1;
+    parser.numEdges = 0;
+    parser.edgeCapacity = INITIAL_CAPACITY;
+    parser.sources = (int *)growArray(NULL,parser.edgeCapacity*sizeof(int));
+    parser.targets = (int *)growArray(NULL,parser.edgeCapacity*sizeof(int));
+
+    bool parsed = parseMappedGraph(&parser);
+    if (parsed)
+        *graph = buildMappedGraph(&parser);
+
+    free(parser.names);
+    free(parser.lengths);
+    free(parser.initial);
+    free(parser.final);
+    free(parser.slots);
+    free(parser.sources);
+    free(parser.targets);
+    munmap(mapping,size);
+    return parsed;
+}
@@ -33,6 +33,7 @@ static SNodeList *allocateNodeList()
 
     b->initial = false;
     b->final = false;
+    b->index = -1;
 
     b->next = NULL;
 
@@ -58,6 +59,21 @@ SNodeList *addNode(char *n1, bool isInit, bool isFinal, SNodeList *list)
     return b;
 }
 
+SNodeList *addNodeInArena(Arena *arena, char *n1, bool isInit, bool isFinal, SNodeList *list)
+{
+    SNodeList *b = (SNodeList *)allocateInArena(arena,sizeof(SNodeList));
+
+    b->node = copyStringInArena(arena,n1);
+
+    b->initial = isInit;
+    b->final = isFinal;
+    b->index = -1;
+
+    b->next = list;
+
+    return b;
+}
+
 void addOrUpdateNode(char *n, bool isInit, bool isFinal, SNodeList *list)
 {
     if (list == NULL)
@@ -65,11 +81,14 @@ void addOrUpdateNode(char *n, bool isInit, bool isFinal, SNodeList *list)
         return;
     }
 
-    if (strcmp(list->node,n) != 0) 
+    while (strcmp(list->node,n) != 0)
     {
-        if(list->next == NULL) list->next = addNode(n,isInit,isFinal,NULL);
-        else addOrUpdateNode(n,isInit,isFinal,list->next);
-        return;
+        if(list->next == NULL)
+        {
+            list->next = addNode(n,isInit,isFinal,NULL);
+            return;
+        }
+        list = list->next;
     }
 
     list->initial = list->initial || isInit;
@@ -80,21 +99,23 @@ void addOrUpdateNode(char *n, bool isInit, bool isFinal, SNodeList *list)
 
 void printNodeList(SNodeList *e)
 {
-    if(e == NULL) { printf("\n"); return;}
-    printf("%s,%d,%d\n",e->node,e->initial,e->final);
-	printNodeList(e->next);
+    for(; e != NULL; e = e->next)
+        printf("%s,%d,%d\n",e->node,e->initial,e->final);
+    printf("\n");
 }
 
 void deleteNodeList(SNodeList *b)
 {
-    if (b == NULL)
-        return;
+    while (b != NULL)
+    {
+        SNodeList *next = b->next;
 
-    deleteNodeList(b->next);
+        free(b->node);
 
-    free(b->node);
+        free(b);
 
-    free(b);
+        b = next;
+    }
 }
 
 /* Testing main.
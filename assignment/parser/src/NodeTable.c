@@ -0,0 +1,111 @@
+/**
+ * @file NodeTable.c
+ * @brief  Hash table from the names of the nodes of a NodeList to the nodes themselves.
+ * @version 1
+ * 
+ * @copyright Creative Commons.
+ * 
+ */
+
+
+#include "NodeTable.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define INITIAL_CAPACITY 64
+
+
+/**
+ * @brief Hashes a name (FNV-1a).
+ * @param name the name to hash.
+ * @return the hash of the name.
+ */
+static unsigned int hashName(const char *name)
+{
+    unsigned int hash = 2166136261u;
+    for (const unsigned char *c = (const unsigned char *)name; *c != '\0'; c++)
+    {
+        hash ^= *c;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * @brief Allocates the slots of a table, all empty.
+ * @param capacity the number of slots.
+ * @return the slots.
+ */
+static SNodeList **allocateSlots(int capacity)
+{
+    SNodeList **slots = (SNodeList **)calloc(capacity,sizeof(SNodeList *));
+    if (slots == NULL)
+    {
+        printf("Not enough memory to allocate slots in allocateSlots\n");
+        exit(EXIT_FAILURE);
+    }
+    return slots;
+}
+
+/**
+ * @brief Puts a node in the first empty slot of its probe sequence.
+ * @param slots the slots.
+ * @param capacity the number of slots, a power of two.
+ * @param node the node.
+ */
+static void placeNode(SNodeList **slots, int capacity, SNodeList *node)
+{
+    unsigned int i = hashName(node->node) & (capacity-1);
+    while (slots[i] != NULL)
+        i = (i+1) & (capacity-1);
+    slots[i] = node;
+}
+
+
+NodeTable makeNodeTable(void)
+{
+    NodeTable table;
+    table.capacity = INITIAL_CAPACITY;
+    table.numNodes = 0;
+    table.slots = allocateSlots(table.capacity);
+    return table;
+}
+
+void deleteNodeTable(NodeTable table)
+{
+    free(table.slots);
+}
+
+SNodeList *findNodeInTable(NodeTable *table, const char *name)
+{
+    unsigned int i = hashName(name) & (table->capacity-1);
+    while (table->slots[i] != NULL)
+    {
+        if (strcmp(table->slots[i]->node,name) == 0)
+            return table->slots[i];
+        i = (i+1) & (table->capacity-1);
+    }
+    return NULL;
+}
+
+void addNodeToTable(NodeTable *table, SNodeList *node)
+{
+    // The table is kept at most half full, so that probe sequences stay short.
+    if (2*(table->numNodes+1) > table->capacity)
+    {
+        int capacity = 2*table->capacity;
+        SNodeList **slots = allocateSlots(capacity);
+        for (int i = 0; i < table->capacity; i++)
+        {
+            if (table->slots[i] != NULL)
+                placeNode(slots,capacity,table->slots[i]);
+        }
+        free(table->slots);
+        table->slots = slots;
+        table->capacity = capacity;
+    }
+    placeNode(table->slots,table->capacity,node);
+    table->numNodes++;
+}
@@ -18,8 +18,7 @@ GraphList getGraphList(const char *expr)
     yyscan_t scanner;
     YY_BUFFER_STATE state;
 
-    expression.nodes=NULL;
-    expression.edges=NULL;
+    expression = makeGraphList();
  
     if (yylex_init(&scanner)) {
         /* could not initialize */
@@ -54,8 +53,7 @@ GraphList getGraphListFromFile(FILE *toRead)
     yyscan_t scanner;
     YY_BUFFER_STATE state;
 
-    expression.nodes=NULL;
-    expression.edges=NULL;
+    expression = makeGraphList();
  
     if (yylex_init(&scanner)) {
         /* could not initialize */
@@ -82,14 +80,17 @@ GraphList getGraphListFromFile(FILE *toRead)
 }
 
 Graph getGraphFromFile(char *toRead){
+    Graph graph;
+    if(getGraphFromMappedFile(toRead,&graph)){
+        return graph;
+    }
     FILE* file = fopen(toRead,"r");
     if(file == NULL){
         printf("file %s does not exist. Exiting.\n",toRead);
         exit(-1);
     }
     GraphList e = getGraphListFromFile(file);
-    Graph graph = createGraph(e);
-    deleteExpression(e.edges);
-    deleteNodeList(e.nodes);
+    graph = createGraph(e);
+    deleteGraphList(e);
     return graph;
 }
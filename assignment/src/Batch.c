@@ -0,0 +1,411 @@
+#include "Batch.h"
+#include "Solving.h"
+#include "ParallelSolving.h"
+#include "CdclSolving.h"
+#include "GraphCache.h"
+#include "Parsing.h"
+#include "Z3Tools.h"
+#include "Statistics.h"
+#include "Bounds.h"
+#include "Budget.h"
+#include <z3.h>
+#include <dirent.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+
+/** @brief The number of instances a thread solves in the same context: the terms of a context are only freed with it, so it is renewed from time to time. */
+#define BATCH_CONTEXT_REUSE 64
+
+/**
+ * @brief A growable array of instances.
+ */
+typedef struct {
+    BatchInstance *instances;   ///< The instances.
+    int numInstances;           ///< The number of instances.
+    int capacity;               ///< The number of instances @p instances can hold.
+} BatchList;
+
+/**
+ * @brief The state of a batch shared by its threads. The fields after @p lock are protected by it.
+ */
+typedef struct {
+    BatchInstance *instances;   ///< The instances, the largest first.
+    int numInstances;           ///< The number of instances.
+    BatchEngine engine;         ///< The way the instances are decided.
+    AmoEncoding amoEncoding;    ///< The encoding of the at-most-one constraints of the caller.
+    NodeEncoding nodeEncoding;  ///< The encoding of the nodes of the caller.
+    bool pruning;               ///< The pruning of the caller.
+    pthread_mutex_t lock;       ///< The lock of the following fields, also taken to print.
+    int nextInstance;           ///< The next instance to solve.
+    BatchSummary summary;       ///< The number of answers so far.
+} Batch;
+
+/**
+ * @brief Small function returning a copy of "@p folder/@p name".
+ *
+ * @param folder A folder.
+ * @param name The name of a file in @p folder.
+ * @return char* The path, to be freed.
+ */
+static char *joinPath(const char *folder, const char *name){
+    size_t length = strlen(folder)+strlen(name)+2;
+    char *path = (char*)malloc(length);
+    if(path == NULL){
+        printf("Not enough memory to allocate path in joinPath\n");
+        exit(EXIT_FAILURE);
+    }
+    snprintf(path, length, "%s/%s", folder, name);
+    return path;
+}
+
+/**
+ * @brief Small function comparing two strings given by their address, for qsort.
+ */
+static int compareNames(const void *a, const void *b){
+    return strcmp(*(char* const*)a, *(char* const*)b);
+}
+
+/**
+ * @brief Small function ordering the instances by folder, for qsort.
+ */
+static int compareFolders(const void *a, const void *b){
+    return strcmp(((const BatchInstance*)a)->folder, ((const BatchInstance*)b)->folder);
+}
+
+/**
+ * @brief Small function ordering the instances by decreasing size, then by folder, for qsort.
+ */
+static int compareInstances(const void *a, const void *b){
+    const BatchInstance *first = (const BatchInstance*)a;
+    const BatchInstance *second = (const BatchInstance*)b;
+    if(first->size != second->size){
+        return first->size > second->size ? -1 : 1;
+    }
+    return compareFolders(a, b);
+}
+
+/**
+ * @brief Small function telling if @p name ends with ".dot".
+ */
+static bool isGraphFileName(const char *name){
+    size_t length = strlen(name);
+    return length > 4 && strcmp(name+length-4, ".dot") == 0;
+}
+
+/**
+ * @brief Adds to @p list the instances under @p folder, @p folder included, each folder being visited in the order of the names.
+ *
+ * @param folder A folder.
+ * @param list The instances found so far.
+ */
+static void collectInstances(const char *folder, BatchList *list){
+    DIR *dir = opendir(folder);
+    if(dir == NULL){
+        return;
+    }
+    int numNames = 0, capacity = 16;
+    char **names = (char**)malloc(sizeof(char*)*capacity);
+    if(names == NULL){
+        printf("Not enough memory to allocate names in collectInstances\n");
+        exit(EXIT_FAILURE);
+    }
+    struct dirent *entry;
+    while((entry = readdir(dir)) != NULL){
+        if(entry->d_name[0] == '.'){
+            continue;
+        }
+        if(numNames == capacity){
+            capacity *= 2;
+            names = (char**)realloc(names, sizeof(char*)*capacity);
+            if(names == NULL){
+                printf("Not enough memory to allocate names in collectInstances\n");
+                exit(EXIT_FAILURE);
+            }
+        }
+        names[numNames++] = joinPath(folder, entry->d_name);
+    }
+    closedir(dir);
+    qsort(names, numNames, sizeof(char*), compareNames);
+
+    BatchInstance instance;
+    instance.folder = NULL;
+    instance.files = (char**)malloc(sizeof(char*)*(numNames+1));
+    instance.numFiles = 0;
+    instance.size = 0;
+    if(instance.files == NULL){
+        printf("Not enough memory to allocate files in collectInstances\n");
+        exit(EXIT_FAILURE);
+    }
+    for(int i = 0 ; i < numNames ; i++){
+        struct stat status;
+        if(stat(names[i], &status) != 0){
+            free(names[i]);
+        }else if(S_ISDIR(status.st_mode)){
+            collectInstances(names[i], list);
+            free(names[i]);
+        }else if(isGraphFileName(names[i])){
+            instance.files[instance.numFiles++] = names[i];
+            instance.size += (long)status.st_size;
+        }else{
+            free(names[i]);
+        }
+    }
+    free(names);
+    if(instance.numFiles == 0){
+        free(instance.files);
+        return;
+    }
+    instance.folder = strdup(folder);
+    if(list->numInstances == list->capacity){
+        list->capacity = list->capacity == 0 ? 16 : 2*list->capacity;
+        list->instances = (BatchInstance*)realloc(list->instances, sizeof(BatchInstance)*list->capacity);
+        if(list->instances == NULL){
+            printf("Not enough memory to allocate instances in collectInstances\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    list->instances[list->numInstances++] = instance;
+}
+
+BatchInstance *findBatchInstances(const char *folder, int *numInstances){
+    BatchList list;
+    list.instances = NULL;
+    list.numInstances = 0;
+    list.capacity = 0;
+    collectInstances(folder, &list);
+    qsort(list.instances, list.numInstances, sizeof(BatchInstance), compareFolders);
+    *numInstances = list.numInstances;
+    return list.instances;
+}
+
+void deleteBatchInstances(BatchInstance *instances, int numInstances){
+    for(int i = 0 ; i < numInstances ; i++){
+        for(int f = 0 ; f < instances[i].numFiles ; f++){
+            free(instances[i].files[f]);
+        }
+        free(instances[i].files);
+        free(instances[i].folder);
+    }
+    free(instances);
+}
+
+/**
+ * @brief Loads a graph file, or its compiled file when it is not older than the graph file.
+ *
+ * @param fileName The name of a graph file.
+ * @return Graph The graph.
+ */
+static Graph loadBatchGraph(char *fileName){
+    Graph graph;
+    if(isGraphCacheFresh(fileName)){
+        char *cacheName = getGraphCacheName(fileName);
+        bool loaded = loadGraphCache(cacheName, &graph);
+        free(cacheName);
+        if(loaded){
+            return graph;
+        }
+    }
+    return getGraphFromFile(fileName);
+}
+
+/**
+ * @brief Tells with the global formula if the graphs have an accepting path of a common length.
+ *
+ * @param ctx The context of the thread.
+ * @param graphs An array of graphs.
+ * @param numGraphs The number of graphs in @p graphs.
+ * @param pathLength Receives the length found, if any.
+ * @return LengthResult LENGTH_SAT, LENGTH_UNSAT or LENGTH_UNDEF.
+ */
+static LengthResult solveWithZ3(Z3_context ctx, Graph *graphs, int numGraphs, int *pathLength){
+    initNodeVariables(ctx, graphs, numGraphs);
+    Z3_ast formula = graphsToFullFormula(ctx, graphs, numGraphs);
+    LengthResult result = LENGTH_UNSAT;
+    if(formula != NULL){
+        Z3_solver solver = makeSolver(ctx);
+        Z3_solver_assert(ctx, solver, formula);
+        switch(checkSolver(ctx, solver)){
+            case Z3_L_TRUE:{
+                result = LENGTH_SAT;
+                Z3_model model = getModelFromSolver(ctx, solver);
+                *pathLength = getSolutionLengthFromModel(ctx, model, graphs);
+                Z3_model_dec_ref(ctx, model);
+                break;
+            }
+            case Z3_L_FALSE:
+                break;
+
+            default:
+                result = LENGTH_UNDEF;
+                break;
+        }
+        deleteSolver(ctx, solver);
+    }
+    deleteNodeVariables();
+    return result;
+}
+
+/**
+ * @brief Tells without Z3 if the graphs have an accepting path of a common length, checking the same lengths as the global formula one by one.
+ *
+ * @param engine BATCH_NATIVE or BATCH_CDCL.
+ * @param graphs An array of graphs.
+ * @param numGraphs The number of graphs in @p graphs.
+ * @param maxK The smallest order of the graphs.
+ * @param pathLength Receives the length found, if any.
+ * @return LengthResult LENGTH_SAT, LENGTH_UNSAT, or LENGTH_UNDEF if the budget of the query ran out first.
+ */
+static LengthResult solveWithoutZ3(BatchEngine engine, Graph *graphs, int numGraphs, int maxK, int *pathLength){
+    bool *lengths = computeCandidateLengths(graphs, numGraphs, maxK-1, getPruning(), NULL);
+    bool found = false, unknown = false;
+    for(int k = 1 ; k < maxK && !found && !unknown ; k++){
+        if(lengths == NULL || lengths[k]){
+            found = engine == BATCH_CDCL ? cdclGraphsHavePath(graphs, numGraphs, k, NULL) : graphsHaveSimplePath(graphs, numGraphs, k, NULL);
+            if(found){
+                *pathLength = k;
+            }
+            unknown = !found && isQueryBudgetExhausted();
+        }
+    }
+    free(lengths);
+    return found ? LENGTH_SAT : unknown ? LENGTH_UNDEF : LENGTH_UNSAT;
+}
+
+/**
+ * @brief The function of the threads of a batch: solves the next instance until none is left, and prints its answer.
+ *
+ * @param arg The Batch.
+ * @return NULL.
+ */
+static void *runBatchWorker(void *arg){
+    Batch *batch = (Batch*)arg;
+    setAmoEncoding(batch->amoEncoding);
+    setNodeEncoding(batch->nodeEncoding);
+    setPruning(batch->pruning);
+    Z3_context ctx = NULL;
+    int numUses = 0;
+    while(true){
+        pthread_mutex_lock(&batch->lock);
+        int index = batch->nextInstance++;
+        pthread_mutex_unlock(&batch->lock);
+        if(index >= batch->numInstances){
+            break;
+        }
+        BatchInstance *instance = &batch->instances[index];
+        struct timespec start, end;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+
+        Graph graphs[instance->numFiles];
+        double parseStart = getStatisticsClock();
+        for(int i = 0 ; i < instance->numFiles ; i++){
+            graphs[i] = loadBatchGraph(instance->files[i]);
+        }
+        addPhaseTime(PHASE_PARSE, parseStart);
+        int maxK = orderG(graphs[0]);
+        for(int i = 1 ; i < instance->numFiles ; i++){
+            if(orderG(graphs[i]) < maxK){
+                maxK = orderG(graphs[i]);
+            }
+        }
+        int pathLength = -1;
+        LengthResult result;
+        if(isQueryBudgetExhausted()){
+            // The budget covers the whole batch: the instances left are unknown without being solved.
+            result = LENGTH_UNDEF;
+        }else if(batch->engine == BATCH_Z3){
+            if(ctx != NULL && numUses == BATCH_CONTEXT_REUSE){
+                Z3_del_context(ctx);
+                ctx = NULL;
+            }
+            if(ctx == NULL){
+                ctx = makeContext();
+                numUses = 0;
+            }
+            numUses++;
+            result = solveWithZ3(ctx, graphs, instance->numFiles, &pathLength);
+        }else{
+            result = solveWithoutZ3(batch->engine, graphs, instance->numFiles, maxK, &pathLength);
+        }
+        for(int i = 0 ; i < instance->numFiles ; i++){
+            deleteGraph(graphs[i]);
+        }
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        double seconds = (end.tv_sec-start.tv_sec)+(end.tv_nsec-start.tv_nsec)/1e9;
+
+        pthread_mutex_lock(&batch->lock);
+        switch(result){
+            case LENGTH_SAT:
+                printf("%s : Oui, k = %d (%.3f s)\n", instance->folder, pathLength, seconds);
+                batch->summary.numSat++;
+                break;
+
+            case LENGTH_UNSAT:
+                printf("%s : Non (%.3f s)\n", instance->folder, seconds);
+                batch->summary.numUnsat++;
+                break;
+
+            default:
+                printf("%s : We don't know (%.3f s)\n", instance->folder, seconds);
+                batch->summary.numUnknown++;
+                break;
+        }
+        fflush(stdout);
+        pthread_mutex_unlock(&batch->lock);
+    }
+    if(ctx != NULL){
+        Z3_del_context(ctx);
+    }
+    return NULL;
+}
+
+BatchSummary solveBatch(const char *folder, BatchEngine engine, int numThreads){
+    Batch batch;
+    batch.instances = findBatchInstances(folder, &batch.numInstances);
+    qsort(batch.instances, batch.numInstances, sizeof(BatchInstance), compareInstances);
+    batch.engine = engine;
+    batch.amoEncoding = getAmoEncoding();
+    batch.nodeEncoding = getNodeEncoding();
+    batch.pruning = getPruning();
+    batch.nextInstance = 0;
+    batch.summary.numInstances = batch.numInstances;
+    batch.summary.numSat = 0;
+    batch.summary.numUnsat = 0;
+    batch.summary.numUnknown = 0;
+    if(numThreads > batch.numInstances){
+        numThreads = batch.numInstances;
+    }
+    if(numThreads < 1){
+        numThreads = 1;
+    }
+    pthread_t *threads = (pthread_t*)malloc(sizeof(pthread_t)*numThreads);
+    if(threads == NULL){
+        printf("Not enough memory to allocate threads in solveBatch\n");
+        exit(EXIT_FAILURE);
+    }
+    pthread_mutex_init(&batch.lock, NULL);
+    int numStarted = 0;
+    for(int t = 0 ; t < numThreads && batch.numInstances > 0 ; t++){
+        if(pthread_create(&threads[t], NULL, runBatchWorker, &batch) != 0){
+            break;
+        }
+        numStarted++;
+    }
+    if(numStarted == 0 && batch.numInstances > 0){
+        // No thread could be started: the instances are solved by the current one.
+        runBatchWorker(&batch);
+        setAmoEncoding(batch.amoEncoding);
+        setNodeEncoding(batch.nodeEncoding);
+        setPruning(batch.pruning);
+    }
+    for(int t = 0 ; t < numStarted ; t++){
+        pthread_join(threads[t], NULL);
+    }
+    pthread_mutex_destroy(&batch.lock);
+    deleteBatchInstances(batch.instances, batch.numInstances);
+    free(threads);
+    return batch.summary;
+}
@@ -0,0 +1,90 @@
+#include "Bitset.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+Bitset makeBitset(int numBits){
+    Bitset set;
+    set.numBits = numBits;
+    set.numWords = (numBits+BITSET_WORD_BITS-1)/BITSET_WORD_BITS;
+    set.words = (BitsetWord*)calloc(set.numWords+1,sizeof(BitsetWord));
+    if(set.words == NULL){
+        printf("Not enough memory to allocate words in makeBitset\n");
+        exit(EXIT_FAILURE);
+    }
+    return set;
+}
+
+void deleteBitset(Bitset set){
+    free(set.words);
+}
+
+void clearBitset(Bitset set){
+    memset(set.words,0,sizeof(BitsetWord)*set.numWords);
+}
+
+void setBit(Bitset set, int bit){
+    set.words[bit/BITSET_WORD_BITS] |= (BitsetWord)1 << (bit%BITSET_WORD_BITS);
+}
+
+void resetBit(Bitset set, int bit){
+    set.words[bit/BITSET_WORD_BITS] &= ~((BitsetWord)1 << (bit%BITSET_WORD_BITS));
+}
+
+bool testBit(Bitset set, int bit){
+    return (set.words[bit/BITSET_WORD_BITS] >> (bit%BITSET_WORD_BITS)) & 1;
+}
+
+void copyBitset(Bitset destination, Bitset source){
+    memcpy(destination.words,source.words,sizeof(BitsetWord)*destination.numWords);
+}
+
+void unionBitset(Bitset destination, Bitset source){
+    for(int w = 0 ; w < destination.numWords ; w++){
+        destination.words[w] |= source.words[w];
+    }
+}
+
+void intersectBitset(Bitset destination, Bitset source){
+    for(int w = 0 ; w < destination.numWords ; w++){
+        destination.words[w] &= source.words[w];
+    }
+}
+
+void differenceBitset(Bitset destination, Bitset source){
+    for(int w = 0 ; w < destination.numWords ; w++){
+        destination.words[w] &= ~source.words[w];
+    }
+}
+
+int countBitset(Bitset set){
+    int count = 0;
+    for(int w = 0 ; w < set.numWords ; w++){
+        count += __builtin_popcountll(set.words[w]);
+    }
+    return count;
+}
+
+bool isBitsetEmpty(Bitset set){
+    for(int w = 0 ; w < set.numWords ; w++){
+        if(set.words[w] != 0){
+            return false;
+        }
+    }
+    return true;
+}
+
+int nextSetBit(Bitset set, int from){
+    if(from >= set.numBits){
+        return -1;
+    }
+    int w = from/BITSET_WORD_BITS;
+    BitsetWord word = set.words[w] & (~(BitsetWord)0 << (from%BITSET_WORD_BITS));
+    while(word == 0){
+        if(++w >= set.numWords){
+            return -1;
+        }
+        word = set.words[w];
+    }
+    return w*BITSET_WORD_BITS+__builtin_ctzll(word);
+}
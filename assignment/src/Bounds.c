@@ -0,0 +1,68 @@
+#include "Bounds.h"
+#include "Preprocessing.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+LengthBounds computeLengthBoundsFromDistances(Distances distances){
+    LengthBounds bounds;
+    bounds.lowest = 0;
+    bounds.highest = -1;
+    if(distances.source >= 0 && distances.target >= 0 && distances.fromSource[distances.target] != UNREACHABLE){
+        int numUseful = 0;
+        for(int u = 0 ; u < distances.numNodes ; u++){
+            if(isNodeUseful(distances,u)){
+                numUseful++;
+            }
+        }
+        bounds.lowest = distances.fromSource[distances.target];
+        bounds.highest = numUseful-1;
+    }
+    return bounds;
+}
+
+LengthBounds computeLengthBounds(Graph graph){
+    Distances distances = computeDistances(graph);
+    LengthBounds bounds = computeLengthBoundsFromDistances(distances);
+    deleteDistances(distances);
+    return bounds;
+}
+
+LengthBounds computeCommonLengthBounds(Graph *graphs, int numGraphs, Distances *distances){
+    LengthBounds bounds = distances != NULL ? computeLengthBoundsFromDistances(distances[0]) : computeLengthBounds(graphs[0]);
+    for(int i = 1 ; i < numGraphs && bounds.lowest <= bounds.highest ; i++){
+        LengthBounds graphBounds = distances != NULL ? computeLengthBoundsFromDistances(distances[i]) : computeLengthBounds(graphs[i]);
+        if(graphBounds.lowest > bounds.lowest){
+            bounds.lowest = graphBounds.lowest;
+        }
+        if(graphBounds.highest < bounds.highest){
+            bounds.highest = graphBounds.highest;
+        }
+    }
+    return bounds;
+}
+
+void restrictLengthsToBounds(bool *lengths, int maxLength, LengthBounds bounds){
+    for(int k = 0 ; k <= maxLength ; k++){
+        if(k < bounds.lowest || k > bounds.highest){
+            lengths[k] = false;
+        }
+    }
+}
+
+bool *computeCandidateLengths(Graph *graphs, int numGraphs, int maxLength, bool walks, Distances *distances){
+    bool* lengths;
+    if(walks){
+        lengths = computeCommonWalkLengths(graphs,numGraphs,maxLength);
+    }else{
+        lengths = (bool*)malloc(sizeof(bool)*(maxLength+2));
+        if(lengths == NULL){
+            printf("Not enough memory to allocate lengths in computeCandidateLengths\n");
+            exit(EXIT_FAILURE);
+        }
+        for(int k = 0 ; k <= maxLength ; k++){
+            lengths[k] = true;
+        }
+    }
+    restrictLengthsToBounds(lengths,maxLength,computeCommonLengthBounds(graphs,numGraphs,distances));
+    return lengths;
+}
@@ -0,0 +1,41 @@
+#include "Budget.h"
+#include <time.h>
+
+/** @brief The time at which the budget runs out, in seconds of CLOCK_MONOTONIC, or a negative value without a budget. It is read by every thread
+ *         without a lock, so it is only written before the threads are started. */
+static double deadline = -1;
+
+/**
+ * @brief Gives the current time of the monotonic clock.
+ *
+ * @return double The time in seconds.
+ */
+static double getBudgetClock(void){
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec+now.tv_nsec/1e9;
+}
+
+void startQueryBudget(unsigned int budget){
+    deadline = budget > 0 ? getBudgetClock()+budget/1e3 : -1;
+}
+
+bool hasQueryBudget(void){
+    return deadline >= 0;
+}
+
+bool isQueryBudgetExhausted(void){
+    return deadline >= 0 && getBudgetClock() >= deadline;
+}
+
+unsigned int getRemainingQueryBudget(void){
+    if(deadline < 0){
+        return 0;
+    }
+    double left = deadline-getBudgetClock();
+    if(left <= 0){
+        return 0;
+    }
+    // Rounded up: a few microseconds left are still a check of one millisecond.
+    return (unsigned int)(left*1e3)+1;
+}
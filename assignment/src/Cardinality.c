@@ -0,0 +1,217 @@
+/**
+ * @file Cardinality.c
+ * @brief Encodings of the "at most one of these literals is true" constraint.
+ * @version 1
+ * 
+ * @copyright Creative Commons.
+ * 
+ */
+
+#include "Cardinality.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief Under this number of literals, the commander and product encodings fall back on the pairwise one.
+ */
+#define AMO_SMALL 6
+
+/**
+ * @brief Size of the groups of the commander encoding.
+ */
+#define COMMANDER_GROUP 3
+
+/**
+ * @brief A growable array of clauses, to be turned into a single conjunction.
+ */
+typedef struct {
+    Z3_ast *clauses;
+    int num;
+    int capacity;
+} ClauseList;
+
+/**
+ * @brief Appends the clause (@p a or @p b) to @p list.
+ * 
+ * @param ctx The solver context.
+ * @param list The clause list.
+ * @param a A literal.
+ * @param b Another literal.
+ */
+static void addBinaryClause(Z3_context ctx, ClauseList *list, Z3_ast a, Z3_ast b){
+    if(list->num == list->capacity){
+        list->capacity = list->capacity == 0 ? 16 : 2*list->capacity;
+        list->clauses = (Z3_ast*)realloc(list->clauses,sizeof(Z3_ast)*list->capacity);
+        if(list->clauses == NULL){
+            printf("Not enough memory to allocate clauses in addBinaryClause\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    Z3_ast clause[2] = {a,b};
+    list->clauses[list->num++] = Z3_mk_or(ctx,2,clause);
+}
+
+/**
+ * @brief Creates an auxiliary variable that does not clash with any other one.
+ * 
+ * @param ctx The solver context.
+ * @param prefix The prefix of its name.
+ * @return Z3_ast The variable.
+ */
+static Z3_ast freshVariable(Z3_context ctx, const char *prefix){
+    return Z3_mk_fresh_const(ctx, prefix, Z3_mk_bool_sort(ctx));
+}
+
+static void encodeAtMostOne(Z3_context ctx, ClauseList *list, Z3_ast *negs, int n, AmoEncoding encoding);
+
+/**
+ * @brief Adds to @p list the clauses ¬x ∨ ¬y for each pair of literals.
+ */
+static void encodePairwise(Z3_context ctx, ClauseList *list, Z3_ast *negs, int n){
+    for(int u = 0 ; u < n ; u++){
+        for(int v = u+1 ; v < n ; v++){
+            addBinaryClause(ctx,list,negs[u],negs[v]);
+        }
+    }
+}
+
+/**
+ * @brief Adds to @p list the clauses of the sequential counter: s_i means "one of the i+1 first literals is true".
+ */
+static void encodeSequential(Z3_context ctx, ClauseList *list, Z3_ast *negs, int n){
+    Z3_ast negPrev = NULL;
+    for(int i = 0 ; i < n ; i++){
+        if(i > 0){
+            addBinaryClause(ctx,list,negs[i],negPrev);
+        }
+        if(i == n-1){
+            break;
+        }
+        Z3_ast s = freshVariable(ctx,"amo_s");
+        addBinaryClause(ctx,list,negs[i],s);
+        if(i > 0){
+            addBinaryClause(ctx,list,negPrev,s);
+        }
+        negPrev = Z3_mk_not(ctx,s);
+    }
+}
+
+/**
+ * @brief Adds to @p list the clauses of the commander encoding: each group of literals has at most one true literal, which implies its commander,
+ *        and at most one commander is true.
+ */
+static void encodeCommander(Z3_context ctx, ClauseList *list, Z3_ast *negs, int n){
+    int numGroups = (n+COMMANDER_GROUP-1)/COMMANDER_GROUP;
+    Z3_ast *commanders = (Z3_ast*)malloc(sizeof(Z3_ast)*numGroups);
+    Z3_ast *negCommanders = (Z3_ast*)malloc(sizeof(Z3_ast)*numGroups);
+    if(commanders == NULL || negCommanders == NULL){
+        printf("Not enough memory to allocate commanders in encodeCommander\n");
+        exit(EXIT_FAILURE);
+    }
+    for(int g = 0 ; g < numGroups ; g++){
+        int first = g*COMMANDER_GROUP;
+        int size = n-first < COMMANDER_GROUP ? n-first : COMMANDER_GROUP;
+        commanders[g] = freshVariable(ctx,"amo_c");
+        negCommanders[g] = Z3_mk_not(ctx,commanders[g]);
+        encodePairwise(ctx,list,negs+first,size);
+        for(int u = first ; u < first+size ; u++){
+            addBinaryClause(ctx,list,negs[u],commanders[g]);
+        }
+    }
+    encodeAtMostOne(ctx,list,negCommanders,numGroups,AMO_COMMANDER);
+    free(commanders);
+    free(negCommanders);
+}
+
+/**
+ * @brief Adds to @p list the clauses of the product encoding: literal number r*numCols+c implies row r and column c, and at most one row and one
+ *        column are true.
+ */
+static void encodeProduct(Z3_context ctx, ClauseList *list, Z3_ast *negs, int n){
+    int numRows = 1;
+    while(numRows*numRows < n){
+        numRows++;
+    }
+    int numCols = (n+numRows-1)/numRows;
+    Z3_ast *lines = (Z3_ast*)malloc(sizeof(Z3_ast)*(numRows+numCols));
+    Z3_ast *negLines = (Z3_ast*)malloc(sizeof(Z3_ast)*(numRows+numCols));
+    if(lines == NULL || negLines == NULL){
+        printf("Not enough memory to allocate lines in encodeProduct\n");
+        exit(EXIT_FAILURE);
+    }
+    for(int l = 0 ; l < numRows+numCols ; l++){
+        lines[l] = freshVariable(ctx,"amo_p");
+        negLines[l] = Z3_mk_not(ctx,lines[l]);
+    }
+    for(int u = 0 ; u < n ; u++){
+        addBinaryClause(ctx,list,negs[u],lines[u/numCols]);
+        addBinaryClause(ctx,list,negs[u],lines[numRows+u%numCols]);
+    }
+    encodeAtMostOne(ctx,list,negLines,numRows,AMO_PRODUCT);
+    encodeAtMostOne(ctx,list,negLines+numRows,numCols,AMO_PRODUCT);
+    free(lines);
+    free(negLines);
+}
+
+/**
+ * @brief Adds to @p list the clauses of @p encoding over @p n literals whose negations are @p negs.
+ */
+static void encodeAtMostOne(Z3_context ctx, ClauseList *list, Z3_ast *negs, int n, AmoEncoding encoding){
+    if(n <= 1){
+        return;
+    }
+    if(encoding == AMO_PAIRWISE || (encoding != AMO_SEQUENTIAL && n <= AMO_SMALL)){
+        encodePairwise(ctx,list,negs,n);
+        return;
+    }
+    switch(encoding){
+        case AMO_SEQUENTIAL:
+            encodeSequential(ctx,list,negs,n);
+            break;
+        case AMO_COMMANDER:
+            encodeCommander(ctx,list,negs,n);
+            break;
+        default:
+            encodeProduct(ctx,list,negs,n);
+            break;
+    }
+}
+
+Z3_ast atMostOne(Z3_context ctx, Z3_ast *literals, Z3_ast *negLiterals, int numLiterals, AmoEncoding encoding){
+    Z3_ast *negs = negLiterals;
+    if(negs == NULL){
+        negs = (Z3_ast*)malloc(sizeof(Z3_ast)*(numLiterals > 0 ? numLiterals : 1));
+        if(negs == NULL){
+            printf("Not enough memory to allocate negs in atMostOne\n");
+            exit(EXIT_FAILURE);
+        }
+        for(int u = 0 ; u < numLiterals ; u++){
+            negs[u] = Z3_mk_not(ctx,literals[u]);
+        }
+    }
+    ClauseList list = {NULL,0,0};
+    encodeAtMostOne(ctx,&list,negs,numLiterals,encoding);
+    Z3_ast res = Z3_mk_and(ctx,list.num,list.clauses);
+    free(list.clauses);
+    if(negLiterals == NULL){
+        free(negs);
+    }
+    return res;
+}
+
+static const char *amoEncodingNames[] = {"pairwise","sequential","commander","product"};
+
+bool getAmoEncodingFromName(const char *name, AmoEncoding *encoding){
+    for(int e = AMO_PAIRWISE ; e <= AMO_PRODUCT ; e++){
+        if(strcmp(name,amoEncodingNames[e]) == 0){
+            *encoding = (AmoEncoding)e;
+            return true;
+        }
+    }
+    return false;
+}
+
+const char *getAmoEncodingName(AmoEncoding encoding){
+    return amoEncodingNames[encoding];
+}
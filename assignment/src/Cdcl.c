@@ -0,0 +1,768 @@
+#include "Cdcl.h"
+#include "Budget.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/** @brief The value given by propagate when no conflict is found. */
+#define NO_CONFLICT -1
+
+/** @brief The value given by propagate when two literals of a group are true, stored in conflictPair. */
+#define GROUP_CONFLICT -2
+
+/** @brief The flag of a learnt clause. */
+#define CLAUSE_LEARNT 1
+
+/** @brief The flag of a forgotten clause, dropped from the watches when met. */
+#define CLAUSE_DELETED 2
+
+/** @brief The number of conflicts of the first restart, multiplied by the Luby sequence for the next ones. */
+#define RESTART_UNIT 100
+
+/** @brief The number of conflicts between two looks at the budget of the query, a power of two. */
+#define BUDGET_PERIOD 128
+
+/** @brief The factor by which the bump of the activities grows after each conflict. */
+#define ACTIVITY_DECAY (1/0.95)
+
+/**
+ * @brief Adds @p value at the end of @p vector.
+ *
+ * @param vector A vector.
+ * @param value The value to add.
+ */
+static void pushCdclVector(CdclVector *vector, int value){
+    if(vector->size == vector->capacity){
+        vector->capacity = vector->capacity == 0 ? 4 : 2*vector->capacity;
+        vector->data = (int*)realloc(vector->data,sizeof(int)*vector->capacity);
+        if(vector->data == NULL){
+            printf("Not enough memory to allocate data in pushCdclVector\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    vector->data[vector->size++] = value;
+}
+
+/**
+ * @brief Converts a literal given as v or -v into the internal one, 2v or 2v+1.
+ *
+ * @param literal A literal of the interface.
+ * @return int The internal literal.
+ */
+static int toLiteral(int literal){
+    return literal > 0 ? 2*literal : 2*(-literal)+1;
+}
+
+/**
+ * @brief Gives the value of the internal literal @p literal.
+ *
+ * @param solver A solver.
+ * @param literal An internal literal.
+ * @return int 1 if it is true, -1 if it is false, 0 if it is unassigned.
+ */
+static int getLiteralValue(CdclSolver *solver, int literal){
+    int value = solver->values[literal>>1];
+    return (literal & 1) ? -value : value;
+}
+
+/**
+ * @brief Gives the current decision level of @p solver.
+ *
+ * @param solver A solver.
+ * @return int The number of decisions on the trail.
+ */
+static int getLevel(CdclSolver *solver){
+    return solver->levelStarts.size;
+}
+
+/**
+ * @brief Gives the literals of the clause at position @p clause, the first two being watched.
+ *
+ * @param solver A solver.
+ * @param clause The position of a clause.
+ * @return int* Its literals, valid until a clause is added.
+ */
+static int *getClauseLiterals(CdclSolver *solver, int clause){
+    return solver->clauses.data+clause+3;
+}
+
+/**
+ * @brief Moves the variable at position @p index of the heap towards the root while it is more active than its parent.
+ *
+ * @param solver A solver.
+ * @param index A position in the heap.
+ */
+static void heapUp(CdclSolver *solver, int index){
+    int variable = solver->heap[index];
+    while(index > 0){
+        int parent = (index-1)/2;
+        if(solver->activities[solver->heap[parent]] >= solver->activities[variable]){
+            break;
+        }
+        solver->heap[index] = solver->heap[parent];
+        solver->heapIndices[solver->heap[index]] = index;
+        index = parent;
+    }
+    solver->heap[index] = variable;
+    solver->heapIndices[variable] = index;
+}
+
+/**
+ * @brief Moves the variable at position @p index of the heap towards the leaves while one of its children is more active.
+ *
+ * @param solver A solver.
+ * @param index A position in the heap.
+ */
+static void heapDown(CdclSolver *solver, int index){
+    int variable = solver->heap[index];
+    for(;;){
+        int child = 2*index+1;
+        if(child >= solver->heapSize){
+            break;
+        }
+        if(child+1 < solver->heapSize && solver->activities[solver->heap[child+1]] > solver->activities[solver->heap[child]]){
+            child++;
+        }
+        if(solver->activities[solver->heap[child]] <= solver->activities[variable]){
+            break;
+        }
+        solver->heap[index] = solver->heap[child];
+        solver->heapIndices[solver->heap[index]] = index;
+        index = child;
+    }
+    solver->heap[index] = variable;
+    solver->heapIndices[variable] = index;
+}
+
+/**
+ * @brief Puts @p variable back in the heap of the decisions if it is not in it.
+ *
+ * @param solver A solver.
+ * @param variable A variable.
+ */
+static void heapInsert(CdclSolver *solver, int variable){
+    if(solver->heapIndices[variable] >= 0){
+        return;
+    }
+    solver->heap[solver->heapSize] = variable;
+    solver->heapIndices[variable] = solver->heapSize++;
+    heapUp(solver,solver->heapSize-1);
+}
+
+/**
+ * @brief Removes the most active variable from the heap of the decisions.
+ *
+ * @param solver A solver whose heap is not empty.
+ * @return int The variable.
+ */
+static int heapPop(CdclSolver *solver){
+    int variable = solver->heap[0];
+    solver->heapIndices[variable] = -1;
+    solver->heapSize--;
+    if(solver->heapSize > 0){
+        solver->heap[0] = solver->heap[solver->heapSize];
+        solver->heapIndices[solver->heap[0]] = 0;
+        heapDown(solver,0);
+    }
+    return variable;
+}
+
+/**
+ * @brief Increases the activity of @p variable, scaling all of them down when they grow too large.
+ *
+ * @param solver A solver.
+ * @param variable A variable taking part in a conflict.
+ */
+static void bumpVariable(CdclSolver *solver, int variable){
+    solver->activities[variable] += solver->increment;
+    if(solver->activities[variable] > 1e100){
+        for(int v = 1 ; v <= solver->numVariables ; v++){
+            solver->activities[v] *= 1e-100;
+        }
+        solver->increment *= 1e-100;
+    }
+    if(solver->heapIndices[variable] >= 0){
+        heapUp(solver,solver->heapIndices[variable]);
+    }
+}
+
+/**
+ * @brief Assigns the internal literal @p literal to true at the current level.
+ *
+ * @param solver A solver.
+ * @param literal An unassigned internal literal.
+ * @param reason The clause implying it, -1 if none.
+ * @param reasonLiteral The false literal of the binary clause of a group implying it, -1 if none.
+ */
+static void enqueue(CdclSolver *solver, int literal, int reason, int reasonLiteral){
+    int variable = literal>>1;
+    solver->values[variable] = (literal & 1) ? -1 : 1;
+    solver->levels[variable] = getLevel(solver);
+    solver->reasons[variable] = reason;
+    solver->reasonLiterals[variable] = reasonLiteral;
+    solver->trail[solver->trailSize++] = literal;
+}
+
+/**
+ * @brief Stores a clause of at least two internal literals and watches its first two literals.
+ *
+ * @param solver A solver.
+ * @param literals The internal literals.
+ * @param numLiterals The number of literals.
+ * @param flags CLAUSE_LEARNT or 0.
+ * @param glue The number of decision levels of the literals when it is learnt.
+ * @return int The position of the clause.
+ */
+static int storeClause(CdclSolver *solver, int *literals, int numLiterals, int flags, int glue){
+    int clause = solver->clauses.size;
+    pushCdclVector(&solver->clauses,numLiterals);
+    pushCdclVector(&solver->clauses,flags);
+    pushCdclVector(&solver->clauses,glue);
+    for(int i = 0 ; i < numLiterals ; i++){
+        pushCdclVector(&solver->clauses,literals[i]);
+    }
+    pushCdclVector(&solver->watches[literals[0]],clause);
+    pushCdclVector(&solver->watches[literals[1]],clause);
+    return clause;
+}
+
+CdclSolver *makeCdclSolver(int numVariables){
+    CdclSolver *solver = (CdclSolver*)calloc(1,sizeof(CdclSolver));
+    if(solver == NULL){
+        printf("Not enough memory to allocate solver in makeCdclSolver\n");
+        exit(EXIT_FAILURE);
+    }
+    int size = numVariables+1;
+    solver->numVariables = numVariables;
+    solver->values = (signed char*)calloc(size,sizeof(signed char));
+    solver->levels = (int*)calloc(size,sizeof(int));
+    solver->reasons = (int*)malloc(sizeof(int)*size);
+    solver->reasonLiterals = (int*)malloc(sizeof(int)*size);
+    solver->phases = (bool*)calloc(size,sizeof(bool));
+    solver->seen = (char*)calloc(size,sizeof(char));
+    solver->trail = (int*)malloc(sizeof(int)*size);
+    solver->watches = (CdclVector*)calloc(2*size,sizeof(CdclVector));
+    solver->occurrences = (CdclVector*)calloc(2*size,sizeof(CdclVector));
+    solver->activities = (double*)calloc(size,sizeof(double));
+    solver->heap = (int*)malloc(sizeof(int)*size);
+    solver->heapIndices = (int*)malloc(sizeof(int)*size);
+    solver->levelStamps = (int*)calloc(size+1,sizeof(int));
+    if(solver->values == NULL || solver->levels == NULL || solver->reasons == NULL || solver->reasonLiterals == NULL || solver->phases == NULL
+       || solver->seen == NULL || solver->trail == NULL || solver->watches == NULL || solver->occurrences == NULL || solver->activities == NULL
+       || solver->heap == NULL || solver->heapIndices == NULL || solver->levelStamps == NULL){
+        printf("Not enough memory to allocate the variables in makeCdclSolver\n");
+        exit(EXIT_FAILURE);
+    }
+    solver->increment = 1;
+    solver->heapSize = 0;
+    for(int v = 0 ; v < size ; v++){
+        solver->reasons[v] = -1;
+        solver->reasonLiterals[v] = -1;
+        solver->heapIndices[v] = -1;
+    }
+    for(int v = 1 ; v <= numVariables ; v++){
+        heapInsert(solver,v);
+    }
+    pushCdclVector(&solver->groupStarts,0);
+    return solver;
+}
+
+void deleteCdclSolver(CdclSolver *solver){
+    for(int l = 0 ; l < 2*(solver->numVariables+1) ; l++){
+        free(solver->watches[l].data);
+        free(solver->occurrences[l].data);
+    }
+    free(solver->values);
+    free(solver->levels);
+    free(solver->reasons);
+    free(solver->reasonLiterals);
+    free(solver->phases);
+    free(solver->seen);
+    free(solver->trail);
+    free(solver->watches);
+    free(solver->occurrences);
+    free(solver->activities);
+    free(solver->heap);
+    free(solver->heapIndices);
+    free(solver->levelStamps);
+    free(solver->levelStarts.data);
+    free(solver->clauses.data);
+    free(solver->groupLiterals.data);
+    free(solver->groupStarts.data);
+    free(solver->learnts.data);
+    free(solver->learnt.data);
+    free(solver);
+}
+
+void addCdclClause(CdclSolver *solver, int *literals, int numLiterals){
+    // Only the units are assigned before the search: a true literal satisfies the clause, a false one is dropped, as well as duplicates.
+    solver->learnt.size = 0;
+    bool satisfied = false;
+    for(int i = 0 ; i < numLiterals && !satisfied ; i++){
+        int literal = toLiteral(literals[i]);
+        int value = getLiteralValue(solver,literal);
+        if(value < 0 || solver->seen[literal>>1] == 1+(literal & 1)){
+            continue;
+        }
+        // Satisfied by a unit, or holding both a literal and its negation.
+        satisfied = value > 0 || solver->seen[literal>>1] != 0;
+        solver->seen[literal>>1] = 1+(literal & 1);
+        pushCdclVector(&solver->learnt,literal);
+    }
+    for(int j = 0 ; j < solver->learnt.size ; j++){
+        solver->seen[solver->learnt.data[j]>>1] = 0;
+    }
+    if(satisfied){
+        return;
+    }
+    if(solver->learnt.size == 0){
+        solver->unsatisfiable = true;
+    }else if(solver->learnt.size == 1){
+        enqueue(solver,solver->learnt.data[0],-1,-1);
+    }else{
+        storeClause(solver,solver->learnt.data,solver->learnt.size,0,0);
+    }
+}
+
+void addCdclAtMostOne(CdclSolver *solver, int *literals, int numLiterals){
+    if(numLiterals < 2){
+        return;
+    }
+    int group = solver->groupStarts.size-1;
+    for(int i = 0 ; i < numLiterals ; i++){
+        int literal = toLiteral(literals[i]);
+        pushCdclVector(&solver->groupLiterals,literal);
+        pushCdclVector(&solver->occurrences[literal],group);
+    }
+    pushCdclVector(&solver->groupStarts,solver->groupLiterals.size);
+}
+
+void addCdclExactlyOne(CdclSolver *solver, int *literals, int numLiterals){
+    addCdclClause(solver,literals,numLiterals);
+    addCdclAtMostOne(solver,literals,numLiterals);
+}
+
+/**
+ * @brief Propagates the literals of the trail not propagated yet: the other literals of their groups become false, and the clauses watching their
+ *        negation look for another watch or imply their last literal.
+ *
+ * @param solver A solver.
+ * @return int NO_CONFLICT, GROUP_CONFLICT, or the position of a clause whose literals are all false.
+ */
+static int propagate(CdclSolver *solver){
+    while(solver->propagated < solver->trailSize){
+        int literal = solver->trail[solver->propagated++];
+        CdclVector *occurrences = solver->occurrences+literal;
+        for(int o = 0 ; o < occurrences->size ; o++){
+            int group = occurrences->data[o];
+            for(int k = solver->groupStarts.data[group] ; k < solver->groupStarts.data[group+1] ; k++){
+                int other = solver->groupLiterals.data[k];
+                if(other == literal){
+                    continue;
+                }
+                int value = getLiteralValue(solver,other);
+                if(value > 0){
+                    solver->conflictPair[0] = literal;
+                    solver->conflictPair[1] = other;
+                    return GROUP_CONFLICT;
+                }
+                if(value == 0){
+                    enqueue(solver,other^1,-1,literal^1);
+                }
+            }
+        }
+        int falseLiteral = literal^1;
+        CdclVector *watches = solver->watches+falseLiteral;
+        int i = 0, j = 0;
+        while(i < watches->size){
+            int clause = watches->data[i++];
+            if(solver->clauses.data[clause+1] & CLAUSE_DELETED){
+                continue;
+            }
+            int *literals = getClauseLiterals(solver,clause);
+            if(literals[0] == falseLiteral){
+                literals[0] = literals[1];
+                literals[1] = falseLiteral;
+            }
+            if(getLiteralValue(solver,literals[0]) > 0){
+                watches->data[j++] = clause;
+                continue;
+            }
+            int size = solver->clauses.data[clause];
+            bool moved = false;
+            for(int k = 2 ; k < size ; k++){
+                if(getLiteralValue(solver,literals[k]) >= 0){
+                    literals[1] = literals[k];
+                    literals[k] = falseLiteral;
+                    pushCdclVector(solver->watches+literals[1],clause);
+                    moved = true;
+                    break;
+                }
+            }
+            if(moved){
+                continue;
+            }
+            watches->data[j++] = clause;
+            if(getLiteralValue(solver,literals[0]) < 0){
+                while(i < watches->size){
+                    watches->data[j++] = watches->data[i++];
+                }
+                watches->size = j;
+                return clause;
+            }
+            enqueue(solver,literals[0],clause,-1);
+        }
+        watches->size = j;
+    }
+    return NO_CONFLICT;
+}
+
+/**
+ * @brief Unassigns the literals of the levels above @p level, saving their value as their next phase.
+ *
+ * @param solver A solver.
+ * @param level The level to go back to.
+ */
+static void backtrack(CdclSolver *solver, int level){
+    if(getLevel(solver) <= level){
+        return;
+    }
+    int start = solver->levelStarts.data[level];
+    for(int t = solver->trailSize-1 ; t >= start ; t--){
+        int variable = solver->trail[t]>>1;
+        solver->phases[variable] = solver->values[variable] > 0;
+        solver->values[variable] = 0;
+        solver->reasons[variable] = -1;
+        solver->reasonLiterals[variable] = -1;
+        heapInsert(solver,variable);
+    }
+    solver->trailSize = start;
+    solver->propagated = start;
+    solver->levelStarts.size = level;
+}
+
+/**
+ * @brief Marks the false literal @p literal met during the conflict analysis: a literal of the current level is counted in @p pathCount, the other
+ *        ones (except those of level 0) go to the learnt clause.
+ *
+ * @param solver A solver.
+ * @param literal A false internal literal.
+ * @param pathCount The number of marked literals of the current level not resolved yet.
+ */
+static void markLiteral(CdclSolver *solver, int literal, int *pathCount){
+    int variable = literal>>1;
+    if(solver->seen[variable] || solver->levels[variable] == 0){
+        return;
+    }
+    solver->seen[variable] = 1;
+    bumpVariable(solver,variable);
+    if(solver->levels[variable] == getLevel(solver)){
+        (*pathCount)++;
+    }else{
+        pushCdclVector(&solver->learnt,literal);
+    }
+}
+
+/**
+ * @brief Tells if the literal @p literal of the learnt clause is implied by the other ones, i.e. if every literal of its reason is marked or of
+ *        level 0.
+ *
+ * @param solver A solver.
+ * @param literal A false internal literal of the learnt clause.
+ * @return true iff it can be removed from the clause.
+ */
+static bool isRedundant(CdclSolver *solver, int literal){
+    int variable = literal>>1;
+    if(solver->reasonLiterals[variable] >= 0){
+        int other = solver->reasonLiterals[variable]>>1;
+        return solver->seen[other] || solver->levels[other] == 0;
+    }
+    if(solver->reasons[variable] < 0){
+        return false;
+    }
+    int clause = solver->reasons[variable];
+    int *literals = getClauseLiterals(solver,clause);
+    for(int k = 1 ; k < solver->clauses.data[clause] ; k++){
+        int other = literals[k]>>1;
+        if(!solver->seen[other] && solver->levels[other] > 0){
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Learns from @p conflict the clause of the first unique implication point into solver->learnt, its asserting literal first and a literal
+ *        of the level to go back to second.
+ *
+ * @param solver A solver.
+ * @param conflict GROUP_CONFLICT or the position of a false clause.
+ * @return int The level to go back to.
+ */
+static int analyze(CdclSolver *solver, int conflict){
+    solver->learnt.size = 0;
+    pushCdclVector(&solver->learnt,0);
+    int pathCount = 0;
+    int index = solver->trailSize-1;
+    int literal = -1;
+    if(conflict == GROUP_CONFLICT){
+        markLiteral(solver,solver->conflictPair[0]^1,&pathCount);
+        markLiteral(solver,solver->conflictPair[1]^1,&pathCount);
+    }else{
+        int *literals = getClauseLiterals(solver,conflict);
+        for(int k = 0 ; k < solver->clauses.data[conflict] ; k++){
+            markLiteral(solver,literals[k],&pathCount);
+        }
+    }
+    for(;;){
+        while(!solver->seen[solver->trail[index]>>1]){
+            index--;
+        }
+        literal = solver->trail[index--];
+        int variable = literal>>1;
+        solver->seen[variable] = 0;
+        pathCount--;
+        if(pathCount == 0){
+            break;
+        }
+        if(solver->reasonLiterals[variable] >= 0){
+            markLiteral(solver,solver->reasonLiterals[variable],&pathCount);
+        }else{
+            int clause = solver->reasons[variable];
+            int *literals = getClauseLiterals(solver,clause);
+            for(int k = 1 ; k < solver->clauses.data[clause] ; k++){
+                markLiteral(solver,literals[k],&pathCount);
+            }
+        }
+    }
+    solver->learnt.data[0] = literal^1;
+    // The removed literals stay after the kept ones until their marks are cleared.
+    int size = solver->learnt.size;
+    int kept = 1;
+    for(int i = 1 ; i < size ; i++){
+        if(!isRedundant(solver,solver->learnt.data[i])){
+            int tmp = solver->learnt.data[kept];
+            solver->learnt.data[kept++] = solver->learnt.data[i];
+            solver->learnt.data[i] = tmp;
+        }
+    }
+    for(int i = 1 ; i < size ; i++){
+        solver->seen[solver->learnt.data[i]>>1] = 0;
+    }
+    solver->learnt.size = kept;
+    if(kept == 1){
+        return 0;
+    }
+    int highest = 1;
+    for(int i = 2 ; i < kept ; i++){
+        if(solver->levels[solver->learnt.data[i]>>1] > solver->levels[solver->learnt.data[highest]>>1]){
+            highest = i;
+        }
+    }
+    int tmp = solver->learnt.data[1];
+    solver->learnt.data[1] = solver->learnt.data[highest];
+    solver->learnt.data[highest] = tmp;
+    return solver->levels[solver->learnt.data[1]>>1];
+}
+
+/**
+ * @brief Counts the decision levels of the literals of the learnt clause. The clauses with few levels are the most useful ones.
+ *
+ * @param solver A solver.
+ * @return int The glue of solver->learnt.
+ */
+static int computeGlue(CdclSolver *solver){
+    int glue = 0;
+    int stamp = (int)solver->conflicts;
+    for(int i = 0 ; i < solver->learnt.size ; i++){
+        int level = solver->levels[solver->learnt.data[i]>>1];
+        if(solver->levelStamps[level] != stamp){
+            solver->levelStamps[level] = stamp;
+            glue++;
+        }
+    }
+    return glue;
+}
+
+/**
+ * @brief Compares two learnt clauses given as (glue, position) pairs, the highest glue first.
+ *
+ * @param a A pair.
+ * @param b Another pair.
+ * @return int Negative if @p a must be forgotten before @p b.
+ */
+static int compareLearnts(const void *a, const void *b){
+    const int *x = (const int*)a;
+    const int *y = (const int*)b;
+    return y[0]-x[0];
+}
+
+/**
+ * @brief Copies the clauses not forgotten at the beginning of solver->clauses and updates their positions in the watches, the reasons and the
+ *        learnt clauses.
+ *
+ * @param solver A solver at level 0 or between two decisions.
+ */
+static void compactClauses(CdclSolver *solver){
+    CdclVector clauses = {0, 0, NULL};
+    int *old = solver->clauses.data;
+    // The glue of an old clause is replaced by its new position, -1 if it is forgotten, read by the updates.
+    for(int clause = 0 ; clause < solver->clauses.size ; clause += 3+old[clause]){
+        if(old[clause+1] & CLAUSE_DELETED){
+            old[clause+2] = -1;
+            continue;
+        }
+        int position = clauses.size;
+        for(int k = 0 ; k < 3+old[clause] ; k++){
+            pushCdclVector(&clauses,old[clause+k]);
+        }
+        old[clause+2] = position;
+    }
+    for(int l = 0 ; l < 2*(solver->numVariables+1) ; l++){
+        CdclVector *watches = solver->watches+l;
+        int kept = 0;
+        for(int i = 0 ; i < watches->size ; i++){
+            int position = old[watches->data[i]+2];
+            if(position >= 0){
+                watches->data[kept++] = position;
+            }
+        }
+        watches->size = kept;
+    }
+    for(int v = 1 ; v <= solver->numVariables ; v++){
+        if(solver->reasons[v] >= 0){
+            solver->reasons[v] = old[solver->reasons[v]+2];
+        }
+    }
+    for(int i = 0 ; i < solver->learnts.size ; i++){
+        solver->learnts.data[i] = old[solver->learnts.data[i]+2];
+    }
+    free(old);
+    solver->clauses = clauses;
+    solver->wasted = 0;
+}
+
+/**
+ * @brief Forgets half of the learnt clauses, those with the highest glue, except the binary ones, those of glue 2 and those implying a literal.
+ *
+ * @param solver A solver between two decisions.
+ */
+static void reduceLearnts(CdclSolver *solver){
+    int *candidates = (int*)malloc(sizeof(int)*(2*solver->learnts.size+1));
+    if(candidates == NULL){
+        printf("Not enough memory to allocate candidates in reduceLearnts\n");
+        exit(EXIT_FAILURE);
+    }
+    int numCandidates = 0;
+    for(int i = 0 ; i < solver->learnts.size ; i++){
+        int clause = solver->learnts.data[i];
+        int *literals = getClauseLiterals(solver,clause);
+        int first = literals[0]>>1;
+        bool locked = solver->reasons[first] == clause && getLiteralValue(solver,literals[0]) > 0;
+        if(!locked && solver->clauses.data[clause] > 2 && solver->clauses.data[clause+2] > 2){
+            candidates[2*numCandidates] = solver->clauses.data[clause+2];
+            candidates[2*numCandidates+1] = clause;
+            numCandidates++;
+        }
+    }
+    qsort(candidates,numCandidates,2*sizeof(int),compareLearnts);
+    for(int i = 0 ; i < numCandidates/2 ; i++){
+        int clause = candidates[2*i+1];
+        solver->clauses.data[clause+1] |= CLAUSE_DELETED;
+        solver->wasted += 3+solver->clauses.data[clause];
+    }
+    free(candidates);
+    int kept = 0;
+    for(int i = 0 ; i < solver->learnts.size ; i++){
+        int clause = solver->learnts.data[i];
+        if(!(solver->clauses.data[clause+1] & CLAUSE_DELETED)){
+            solver->learnts.data[kept++] = clause;
+        }
+    }
+    solver->learnts.size = kept;
+    solver->maxLearnts += solver->maxLearnts/10;
+    if(solver->wasted > solver->clauses.size/2){
+        compactClauses(solver);
+    }
+}
+
+/**
+ * @brief Gives the element @p x of the Luby sequence 1 1 2 1 1 2 4 1 1 2 1 1 2 4 8..., the number of restart units of each restart.
+ *
+ * @param x A position in the sequence.
+ * @return long The element.
+ */
+static long luby(int x){
+    int size = 1, sequence = 0;
+    while(size < x+1){
+        sequence++;
+        size = 2*size+1;
+    }
+    while(size-1 != x){
+        size = (size-1)>>1;
+        sequence--;
+        x = x % size;
+    }
+    return 1L << sequence;
+}
+
+CdclResult solveCdcl(CdclSolver *solver){
+    if(solver->unsatisfiable || propagate(solver) != NO_CONFLICT){
+        solver->unsatisfiable = true;
+        return CDCL_UNSAT;
+    }
+    solver->maxLearnts = 2000+solver->numVariables;
+    for(int restart = 0 ; ; restart++){
+        long budget = RESTART_UNIT*luby(restart);
+        for(long conflicts = 0 ; ; ){
+            int conflict = propagate(solver);
+            if(conflict != NO_CONFLICT){
+                solver->conflicts++;
+                conflicts++;
+                if(getLevel(solver) == 0){
+                    solver->unsatisfiable = true;
+                    return CDCL_UNSAT;
+                }
+                if((solver->conflicts & (BUDGET_PERIOD-1)) == 0 && isQueryBudgetExhausted()){
+                    backtrack(solver,0);
+                    return CDCL_UNKNOWN;
+                }
+                int level = analyze(solver,conflict);
+                int glue = computeGlue(solver);
+                backtrack(solver,level);
+                if(solver->learnt.size == 1){
+                    enqueue(solver,solver->learnt.data[0],-1,-1);
+                }else{
+                    int clause = storeClause(solver,solver->learnt.data,solver->learnt.size,CLAUSE_LEARNT,glue);
+                    pushCdclVector(&solver->learnts,clause);
+                    enqueue(solver,solver->learnt.data[0],clause,-1);
+                }
+                solver->increment *= ACTIVITY_DECAY;
+                continue;
+            }
+            if(conflicts >= budget){
+                backtrack(solver,0);
+                break;
+            }
+            if(solver->learnts.size >= solver->maxLearnts){
+                reduceLearnts(solver);
+            }
+            int variable = 0;
+            while(solver->heapSize > 0 && variable == 0){
+                int candidate = heapPop(solver);
+                if(solver->values[candidate] == 0){
+                    variable = candidate;
+                }
+            }
+            if(variable == 0){
+                return CDCL_SAT;
+            }
+            pushCdclVector(&solver->levelStarts,solver->trailSize);
+            enqueue(solver,solver->phases[variable] ? 2*variable : 2*variable+1,-1,-1);
+        }
+    }
+}
+
+bool getCdclValue(CdclSolver *solver, int variable){
+    return solver->values[variable] > 0;
+}
@@ -0,0 +1,188 @@
+#include "CdclSolving.h"
+#include "Cdcl.h"
+#include "Solving.h"
+#include "Statistics.h"
+#include "Budget.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ * @brief Adds the clauses of ɸ1: the source is at position 0.
+ * 
+ * @param solver A solver.
+ * @param graph A graph.
+ * @param variables The variable of each node u at each position j at index j*n+u, 0 if the pair is pruned.
+ */
+static void graphToPhi1Clauses(CdclSolver *solver, Graph graph, int *variables){
+    for(int u = 0 ; u < orderG(graph) ; u++){
+        if(isSource(graph,u)){
+            addCdclClause(solver,variables+u,variables[u] == 0 ? 0 : 1);
+            return;
+        }
+    }
+    addCdclClause(solver,NULL,0);
+}
+
+/**
+ * @brief Adds the clauses of ɸ2: the target is at position @p pathLength.
+ * 
+ * @param solver A solver.
+ * @param graph A graph.
+ * @param pathLength The length of the path.
+ * @param variables The variable of each node u at each position j at index j*n+u, 0 if the pair is pruned.
+ */
+static void graphToPhi2Clauses(CdclSolver *solver, Graph graph, int pathLength, int *variables){
+    int *last = variables+pathLength*orderG(graph);
+    for(int u = 0 ; u < orderG(graph) ; u++){
+        if(isTarget(graph,u)){
+            addCdclClause(solver,last+u,last[u] == 0 ? 0 : 1);
+            return;
+        }
+    }
+    addCdclClause(solver,NULL,0);
+}
+
+/**
+ * @brief Adds the clauses of ɸ3 and the groups of ɸ4: exactly one node at each position.
+ * 
+ * @param solver A solver.
+ * @param graph A graph.
+ * @param pathLength The length of the path.
+ * @param variables The variable of each node u at each position j at index j*n+u, 0 if the pair is pruned.
+ * @param literals An array of at least n+1 integers.
+ */
+static void graphToPhi3And4Clauses(CdclSolver *solver, Graph graph, int pathLength, int *variables, int *literals){
+    int numNodes = orderG(graph);
+    for(int j = 0 ; j <= pathLength ; j++){
+        int ind = 0;
+        for(int u = 0 ; u < numNodes ; u++){
+            if(variables[j*numNodes+u] != 0){
+                literals[ind++] = variables[j*numNodes+u];
+            }
+        }
+        addCdclExactlyOne(solver,literals,ind);
+    }
+}
+
+/**
+ * @brief Adds the groups of ɸ5: each node is at most at one position.
+ * 
+ * @param solver A solver.
+ * @param graph A graph.
+ * @param pathLength The length of the path.
+ * @param variables The variable of each node u at each position j at index j*n+u, 0 if the pair is pruned.
+ * @param literals An array of at least @p pathLength+1 integers.
+ */
+static void graphToPhi5Clauses(CdclSolver *solver, Graph graph, int pathLength, int *variables, int *literals){
+    int numNodes = orderG(graph);
+    for(int u = 0 ; u < numNodes ; u++){
+        int ind = 0;
+        for(int j = 0 ; j <= pathLength ; j++){
+            if(variables[j*numNodes+u] != 0){
+                literals[ind++] = variables[j*numNodes+u];
+            }
+        }
+        addCdclAtMostOne(solver,literals,ind);
+    }
+}
+
+/**
+ * @brief Adds the clauses of ɸ6: the node at position j+1 is a successor of the one at position j. Given ɸ3 and ɸ4, "u at j implies one of its
+ *        successors at j+1" is equivalent to the disjunction of the edges of ɸ6, with one clause per node instead of one term per edge.
+ * 
+ * @param solver A solver.
+ * @param graph A graph.
+ * @param pathLength The length of the path.
+ * @param variables The variable of each node u at each position j at index j*n+u, 0 if the pair is pruned.
+ * @param literals An array of at least n+1 integers.
+ */
+static void graphToPhi6Clauses(CdclSolver *solver, Graph graph, int pathLength, int *variables, int *literals){
+    int numNodes = orderG(graph);
+    for(int j = 0 ; j < pathLength ; j++){
+        for(int u = 0 ; u < numNodes ; u++){
+            if(variables[j*numNodes+u] == 0){
+                continue;
+            }
+            int ind = 0;
+            literals[ind++] = -variables[j*numNodes+u];
+            int *successors = getSuccessors(graph,u);
+            for(int e = 0 ; e < getNumSuccessors(graph,u) ; e++){
+                int v = successors[e];
+                if(variables[(j+1)*numNodes+v] != 0){
+                    literals[ind++] = variables[(j+1)*numNodes+v];
+                }
+            }
+            addCdclClause(solver,literals,ind);
+        }
+    }
+}
+
+/**
+ * @brief Decides with the embedded solver if @p graph has a simple path of length @p pathLength from its source to its target.
+ * 
+ * @param graph A graph.
+ * @param pathLength The length of the path.
+ * @param path If not NULL, the array of size @p pathLength+1 receiving the path when true is returned.
+ * @return true iff there is such a path, false if the budget of the query runs out first.
+ */
+static bool cdclGraphHasPath(Graph graph, int pathLength, int *path){
+    int numNodes = orderG(graph);
+    Distances distances;
+    if(getPruning()){
+        distances = computeDistances(graph);
+    }
+    int *variables = (int*)malloc(sizeof(int)*((pathLength+1)*numNodes+1));
+    int *literals = (int*)malloc(sizeof(int)*(numNodes+pathLength+2));
+    if(variables == NULL || literals == NULL){
+        printf("Not enough memory to allocate variables in cdclGraphHasPath\n");
+        exit(EXIT_FAILURE);
+    }
+    double start = getStatisticsClock();
+    int numVariables = 0;
+    for(int j = 0 ; j <= pathLength ; j++){
+        for(int u = 0 ; u < numNodes ; u++){
+            variables[j*numNodes+u] = isNodeAllowed(getPruning() ? &distances : NULL,u,j,pathLength) ? ++numVariables : 0;
+        }
+    }
+    CdclSolver *solver = makeCdclSolver(numVariables);
+    graphToPhi1Clauses(solver,graph,variables);
+    graphToPhi2Clauses(solver,graph,pathLength,variables);
+    graphToPhi3And4Clauses(solver,graph,pathLength,variables,literals);
+    graphToPhi5Clauses(solver,graph,pathLength,variables,literals);
+    graphToPhi6Clauses(solver,graph,pathLength,variables,literals);
+    addPhaseTime(PHASE_ENCODE, start);
+    start = getStatisticsClock();
+    bool res = solveCdcl(solver) == CDCL_SAT;
+    addPhaseTime(PHASE_SOLVE, start);
+    addSolverCall();
+    if(res && path != NULL){
+        start = getStatisticsClock();
+        for(int j = 0 ; j <= pathLength ; j++){
+            for(int u = 0 ; u < numNodes ; u++){
+                if(variables[j*numNodes+u] != 0 && getCdclValue(solver,variables[j*numNodes+u])){
+                    path[j] = u;
+                }
+            }
+        }
+        addPhaseTime(PHASE_DECODE, start);
+    }
+    deleteCdclSolver(solver);
+    free(variables);
+    free(literals);
+    if(getPruning()){
+        deleteDistances(distances);
+    }
+    return res;
+}
+
+bool cdclGraphsHavePath(Graph *graphs, unsigned int numGraphs, int pathLength, int *paths){
+    if(pathLength < 0){
+        return false;
+    }
+    for(unsigned int i = 0 ; i < numGraphs ; i++){
+        if(isQueryBudgetExhausted() || !cdclGraphHasPath(graphs[i],pathLength,paths == NULL ? NULL : paths+i*(pathLength+1))){
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,263 @@
+#include "DotWriter.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+/** @brief The number of edges under which the sections of a file are formatted by the calling thread alone. */
+#define DOT_PARALLEL_EDGES 4096
+
+/**
+ * @brief A list of jobs shared by the threads running them, each thread taking the next job until none is left.
+ */
+typedef struct {
+    pthread_mutex_t lock;               ///< Protects @p next.
+    int next;                           ///< The next job to run.
+    int numJobs;                        ///< The number of jobs.
+    void (*run)(void *jobs, int job);   ///< Runs a job.
+    void *jobs;                         ///< The data of the jobs, given to @p run.
+} DotJobs;
+
+/**
+ * @brief A section of a file, formatted by one thread.
+ */
+typedef struct {
+    Graph graph;       ///< The graph.
+    int graphNumber;   ///< The index of the graph.
+    int pathLength;    ///< The length of the path.
+    int *path;         ///< The path of the graph.
+    DotBuffer buffer;  ///< The formatted section.
+} DotSection;
+
+/**
+ * @brief A file of a sweep, written by one thread.
+ */
+typedef struct {
+    Graph *graphs;     ///< The graphs.
+    int numGraphs;     ///< The number of graphs.
+    int pathLength;    ///< The length of the paths.
+    int *paths;        ///< The paths of the graphs.
+    const char *name;  ///< The name of the solution.
+    bool written;      ///< Tells if the file was written.
+} DotFile;
+
+DotBuffer makeDotBuffer(void){
+    DotBuffer buffer;
+    buffer.size = 0;
+    buffer.capacity = 256;
+    buffer.data = (char*)malloc(buffer.capacity);
+    if(buffer.data == NULL){
+        printf("Not enough memory to allocate data in makeDotBuffer\n");
+        exit(EXIT_FAILURE);
+    }
+    buffer.data[0] = '\0';
+    return buffer;
+}
+
+void deleteDotBuffer(DotBuffer buffer){
+    free(buffer.data);
+}
+
+void appendToDotBuffer(DotBuffer *buffer, const char *format, ...){
+    va_list arguments;
+    va_start(arguments, format);
+    int length = vsnprintf(buffer->data+buffer->size, buffer->capacity-buffer->size, format, arguments);
+    va_end(arguments);
+    if(length < 0){
+        return;
+    }
+    if(buffer->size+length+1 > buffer->capacity){
+        while(buffer->size+length+1 > buffer->capacity){
+            buffer->capacity *= 2;
+        }
+        buffer->data = (char*)realloc(buffer->data, buffer->capacity);
+        if(buffer->data == NULL){
+            printf("Not enough memory to allocate data in appendToDotBuffer\n");
+            exit(EXIT_FAILURE);
+        }
+        va_start(arguments, format);
+        vsnprintf(buffer->data+buffer->size, buffer->capacity-buffer->size, format, arguments);
+        va_end(arguments);
+    }
+    buffer->size += length;
+}
+
+void appendGraphToDotBuffer(DotBuffer *buffer, Graph graph, int graphNumber, int pathLength, int *path){
+    int numNodes = orderG(graph);
+    // The position of each node in the path, -1 if it is not in it, so that the path is searched once for all nodes and edges.
+    int *positions = (int*)malloc(sizeof(int)*(numNodes+1));
+    if(positions == NULL){
+        printf("Not enough memory to allocate positions in appendGraphToDotBuffer\n");
+        exit(EXIT_FAILURE);
+    }
+    for(int u = 0 ; u < numNodes ; u++){
+        positions[u] = -1;
+    }
+    for(int j = 0 ; j <= pathLength ; j++){
+        positions[path[j]] = j;
+    }
+    // Display the starting and ending nodes.
+    appendToDotBuffer(buffer, "_%d_%s [initial=1,color=green][style=filled,fillcolor=lightblue];\n", graphNumber, getNodeName(graph,path[0]));
+    appendToDotBuffer(buffer, "_%d_%s [final=1,color=red][style=filled,fillcolor=lightblue];\n", graphNumber, getNodeName(graph,path[pathLength]));
+    // Display every other nodes with the one in the path in 'light-blue'.
+    for(int u = 0 ; u < numNodes ; u++){
+        if(isTarget(graph,u) || isSource(graph,u)){
+            continue;
+        }
+        if(positions[u] >= 0){
+            appendToDotBuffer(buffer, "_%d_%s [style=filled,fillcolor=lightblue];\n", graphNumber, getNodeName(graph,u));
+        }else{
+            appendToDotBuffer(buffer, "_%d_%s ;\n", graphNumber, getNodeName(graph,u));
+        }
+    }
+    // Display every edges with the ones in the path in 'blue'.
+    for(int u = 0 ; u < numNodes ; u++){
+        int *successors = getSuccessors(graph,u);
+        for(int e = 0 ; e < getNumSuccessors(graph,u) ; e++){
+            int v = successors[e];
+            if(positions[u] >= 0 && positions[u] < pathLength && path[positions[u]+1] == v){
+                appendToDotBuffer(buffer, "_%d_%s -> _%d_%s [color=blue];\n", graphNumber, getNodeName(graph,u), graphNumber, getNodeName(graph,v));
+            }else{
+                appendToDotBuffer(buffer, "_%d_%s -> _%d_%s;\n", graphNumber, getNodeName(graph,u), graphNumber, getNodeName(graph,v));
+            }
+        }
+    }
+    free(positions);
+}
+
+/**
+ * @brief The function of the threads of runDotJobs: runs the next job until none is left.
+ *
+ * @param arg The DotJobs.
+ * @return void* NULL.
+ */
+static void *runDotWorker(void *arg){
+    DotJobs *jobs = (DotJobs*)arg;
+    for(;;){
+        pthread_mutex_lock(&jobs->lock);
+        int job = jobs->next++;
+        pthread_mutex_unlock(&jobs->lock);
+        if(job >= jobs->numJobs){
+            return NULL;
+        }
+        jobs->run(jobs->jobs, job);
+    }
+}
+
+/**
+ * @brief Runs the @p numJobs jobs with at most @p numThreads threads, the calling thread being one of them.
+ *
+ * @param run Runs a job.
+ * @param data The data of the jobs.
+ * @param numJobs The number of jobs.
+ * @param numThreads The largest number of threads.
+ */
+static void runDotJobs(void (*run)(void *jobs, int job), void *data, int numJobs, int numThreads){
+    DotJobs jobs;
+    pthread_mutex_init(&jobs.lock, NULL);
+    jobs.next = 0;
+    jobs.numJobs = numJobs;
+    jobs.run = run;
+    jobs.jobs = data;
+    int numHelpers = (numThreads < numJobs ? numThreads : numJobs)-1;
+    pthread_t threads[numHelpers > 0 ? numHelpers : 1];
+    int numStarted = 0;
+    for(int t = 0 ; t < numHelpers ; t++){
+        if(pthread_create(&threads[t], NULL, runDotWorker, &jobs) != 0){
+            break;
+        }
+        numStarted++;
+    }
+    runDotWorker(&jobs);
+    for(int t = 0 ; t < numStarted ; t++){
+        pthread_join(threads[t], NULL);
+    }
+    pthread_mutex_destroy(&jobs.lock);
+}
+
+/**
+ * @brief Formats a section of a file.
+ *
+ * @param jobs The array of DotSection.
+ * @param job The index of the section.
+ */
+static void runDotSection(void *jobs, int job){
+    DotSection *section = (DotSection*)jobs+job;
+    appendGraphToDotBuffer(&section->buffer, section->graph, section->graphNumber, section->pathLength, section->path);
+}
+
+/**
+ * @brief Writes a file of writeDotFiles, its sections being formatted by the thread writing it.
+ *
+ * @param jobs The array of DotFile.
+ * @param job The index of the file.
+ */
+static void runDotFile(void *jobs, int job){
+    DotFile *file = (DotFile*)jobs+job;
+    file->written = writeDotFile(file->graphs, file->numGraphs, file->pathLength, file->paths, file->name, 1);
+}
+
+bool writeDotFile(Graph *graphs, int numGraphs, int pathLength, int *paths, const char *name, int numThreads){
+    DotSection *sections = (DotSection*)malloc(sizeof(DotSection)*(numGraphs+1));
+    if(sections == NULL){
+        printf("Not enough memory to allocate sections in writeDotFile\n");
+        exit(EXIT_FAILURE);
+    }
+    int numEdges = 0;
+    for(int i = 0 ; i < numGraphs ; i++){
+        sections[i].graph = graphs[i];
+        sections[i].graphNumber = i;
+        sections[i].pathLength = pathLength;
+        sections[i].path = paths+i*(pathLength+1);
+        sections[i].buffer = makeDotBuffer();
+        numEdges += sizeG(graphs[i]);
+    }
+    runDotJobs(runDotSection, sections, numGraphs, numEdges < DOT_PARALLEL_EDGES ? 1 : numThreads);
+    size_t length = strlen(DOT_FOLDER)+strlen(name)+32;
+    char fileName[length];
+    snprintf(fileName, length, "%s/%s-l%d.dot", DOT_FOLDER, name, pathLength);
+    mkdir(DOT_FOLDER, 0777);
+    FILE *file = fopen(fileName, "w");
+    bool written = file != NULL;
+    if(written){
+        fprintf(file, "digraph %s{\n", name);
+        for(int i = 0 ; i < numGraphs ; i++){
+            fwrite(sections[i].buffer.data, 1, sections[i].buffer.size, file);
+        }
+        fprintf(file, "}\n");
+        written = fclose(file) == 0;
+    }
+    for(int i = 0 ; i < numGraphs ; i++){
+        deleteDotBuffer(sections[i].buffer);
+    }
+    free(sections);
+    return written;
+}
+
+int writeDotFiles(Graph *graphs, int numGraphs, int numFiles, int *pathLengths, int **paths, const char *name, int numThreads){
+    DotFile *files = (DotFile*)malloc(sizeof(DotFile)*(numFiles+1));
+    if(files == NULL){
+        printf("Not enough memory to allocate files in writeDotFiles\n");
+        exit(EXIT_FAILURE);
+    }
+    for(int f = 0 ; f < numFiles ; f++){
+        files[f].graphs = graphs;
+        files[f].numGraphs = numGraphs;
+        files[f].pathLength = pathLengths[f];
+        files[f].paths = paths[f];
+        files[f].name = name;
+        files[f].written = false;
+    }
+    runDotJobs(runDotFile, files, numFiles, numThreads);
+    int numWritten = 0;
+    for(int f = 0 ; f < numFiles ; f++){
+        if(files[f].written){
+            numWritten++;
+        }
+    }
+    free(files);
+    return numWritten;
+}
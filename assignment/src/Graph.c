@@ -16,6 +16,7 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
+#include <sys/mman.h>
 
 void printGraph(Graph graph){
 	printf("nodes:\n");
@@ -27,14 +28,24 @@ void printGraph(Graph graph){
 	printf("\nEdges:\n");
 	for(int i = 0; i<graph.numNodes;i++){
 		for(int j = 0; j<graph.numNodes;j++){
-			printf("%d ",graph.edges[i*graph.numNodes+j]);
+			printf("%d ",isEdge(graph,i,j));
 		}
 		printf("\n");
 	}
 }
 
 void deleteGraph(Graph graph){
-	if(graph.edges!=NULL) free(graph.edges);
+	if(graph.mapping!=NULL){
+		//The edges and the names are in the mapping, only the array of names is owned.
+		free(graph.nodes);
+		munmap(graph.mapping,graph.mappingSize);
+		graph.nodes=NULL;
+	}else{
+		if(graph.successorIndex!=NULL) free(graph.successorIndex);
+		if(graph.successors!=NULL) free(graph.successors);
+		if(graph.predecessorIndex!=NULL) free(graph.predecessorIndex);
+		if(graph.predecessors!=NULL) free(graph.predecessors);
+	}
 	if(graph.nodes!=NULL){
 		for(int i = 0; i<graph.numNodes; i++) {
 			if(graph.nodes[i]!=NULL) free(graph.nodes[i]);
@@ -58,8 +69,110 @@ int sizeG(Graph graph){
 	return graph.numEdges;
 }
 
+/*
+ * @brief Auxilary function sorting the edges by a counting sort on their first end, then on their second end.
+ *
+ * @param numNodes the number of nodes.
+ * @param numEdges the number of edges.
+ * @param from the first end of each edge.
+ * @param to the second end of each edge.
+ * @param index the array of size numNodes+1 receiving the index of the first edge of each node.
+ * @param ends the array of size numEdges receiving the second ends, grouped by first end and sorted.
+ */
+static void sortEdges(int numNodes, int numEdges, int *from, int *to, int *index, int *ends){
+	int *byEnd = (int *)malloc((numEdges+1)*sizeof(int));
+	int *count = (int *)malloc((numNodes+1)*sizeof(int));
+	if(byEnd==NULL || count==NULL){
+		printf("Not enough memory to allocate edges in sortEdges\n");
+		exit(EXIT_FAILURE);
+	}
+	//Edges sorted by second end, so that the stable sort on the first end keeps each group sorted.
+	for(int i = 0; i<=numNodes; i++) count[i] = 0;
+	for(int e = 0; e<numEdges; e++) count[to[e]+1]++;
+	for(int i = 0; i<numNodes; i++) count[i+1] += count[i];
+	for(int e = 0; e<numEdges; e++) byEnd[count[to[e]]++] = e;
+
+	for(int i = 0; i<=numNodes; i++) index[i] = 0;
+	for(int e = 0; e<numEdges; e++) index[from[e]+1]++;
+	for(int i = 0; i<numNodes; i++) index[i+1] += index[i];
+	for(int i = 0; i<numNodes; i++) count[i] = index[i];
+	for(int k = 0; k<numEdges; k++){
+		int e = byEnd[k];
+		ends[count[from[e]]++] = to[e];
+	}
+	free(byEnd);
+	free(count);
+}
+
+void setEdges(Graph *graph, int numEdges, int *sources, int *targets){
+	int numNodes = graph->numNodes;
+	int *index = (int *)malloc((numNodes+1)*sizeof(int));
+	int *ends = (int *)malloc((numEdges+1)*sizeof(int));
+	if(index==NULL || ends==NULL){
+		printf("Not enough memory to allocate edges in setEdges\n");
+		exit(EXIT_FAILURE);
+	}
+	sortEdges(numNodes,numEdges,sources,targets,index,ends);
+
+	//Removes the duplicated edges, which are next to each other once sorted.
+	int *from = (int *)malloc((numEdges+1)*sizeof(int));
+	int *to = (int *)malloc((numEdges+1)*sizeof(int));
+	if(from==NULL || to==NULL){
+		printf("Not enough memory to allocate edges in setEdges\n");
+		exit(EXIT_FAILURE);
+	}
+	int count = 0;
+	for(int u = 0; u<numNodes; u++){
+		for(int e = index[u]; e<index[u+1]; e++){
+			if(e==index[u] || ends[e]!=ends[e-1]){
+				from[count] = u;
+				to[count] = ends[e];
+				count++;
+			}
+		}
+	}
+	free(index);
+	free(ends);
+
+	graph->numEdges = count;
+	graph->successorIndex = (int *)malloc((numNodes+1)*sizeof(int));
+	graph->successors = (int *)malloc((count+1)*sizeof(int));
+	graph->predecessorIndex = (int *)malloc((numNodes+1)*sizeof(int));
+	graph->predecessors = (int *)malloc((count+1)*sizeof(int));
+	if(graph->successorIndex==NULL || graph->successors==NULL || graph->predecessorIndex==NULL || graph->predecessors==NULL){
+		printf("Not enough memory to allocate edges in setEdges\n");
+		exit(EXIT_FAILURE);
+	}
+	sortEdges(numNodes,count,from,to,graph->successorIndex,graph->successors);
+	sortEdges(numNodes,count,to,from,graph->predecessorIndex,graph->predecessors);
+	free(from);
+	free(to);
+}
+
 bool isEdge(Graph graph, int source, int target){
-	return graph.edges[(source*graph.numNodes)+target];
+	int low = graph.successorIndex[source], high = graph.successorIndex[source+1];
+	while(low < high){
+		int middle = (low+high)/2;
+		if(graph.successors[middle] < target) low = middle+1;
+		else high = middle;
+	}
+	return low < graph.successorIndex[source+1] && graph.successors[low] == target;
+}
+
+int getNumSuccessors(Graph graph, int node){
+	return graph.successorIndex[node+1]-graph.successorIndex[node];
+}
+
+int* getSuccessors(Graph graph, int node){
+	return graph.successors+graph.successorIndex[node];
+}
+
+int getNumPredecessors(Graph graph, int node){
+	return graph.predecessorIndex[node+1]-graph.predecessorIndex[node];
+}
+
+int* getPredecessors(Graph graph, int node){
+	return graph.predecessors+graph.predecessorIndex[node];
 }
 
 bool isSource(Graph graph, int node){
@@ -0,0 +1,281 @@
+#include "GraphCache.h"
+#include "Bitset.h"
+#include <fcntl.h>
+#include <limits.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * @brief The header of a compiled file, followed by the sections in the order of GraphCacheLayout.
+ */
+typedef struct {
+    char magic[8];          ///< GRAPH_CACHE_MAGIC.
+    uint32_t version;       ///< GRAPH_CACHE_VERSION.
+    uint32_t byteOrder;     ///< GRAPH_CACHE_BYTE_ORDER as written, to reject files from a machine of another endianness.
+    uint32_t numNodes;      ///< The number of nodes.
+    uint32_t numEdges;      ///< The number of edges.
+    uint32_t namesSize;     ///< The number of characters of the string table, terminating zeros included.
+    uint32_t reserved;      ///< Zero.
+} GraphCacheHeader;
+
+#define GRAPH_CACHE_MAGIC "COCAGRPH"
+#define GRAPH_CACHE_BYTE_ORDER 0x01020304u
+
+/**
+ * @brief The offsets in bytes of the sections of a compiled file. Each section is aligned on 8 bytes.
+ */
+typedef struct {
+    size_t successorIndex;      ///< The numNodes+1 int of Graph.successorIndex.
+    size_t successors;          ///< The numEdges int of Graph.successors.
+    size_t predecessorIndex;    ///< The numNodes+1 int of Graph.predecessorIndex.
+    size_t predecessors;        ///< The numEdges int of Graph.predecessors.
+    size_t sources;             ///< The words of the bitset of the source nodes.
+    size_t targets;             ///< The words of the bitset of the target nodes.
+    size_t nameOffsets;         ///< The numNodes+1 uint32_t offsets of the names in the string table.
+    size_t names;               ///< The string table.
+    size_t size;                ///< The size of the file.
+} GraphCacheLayout;
+
+/**
+ * @brief Rounds a size up to a multiple of 8.
+ * 
+ * @param size A size.
+ * @return size_t The rounded size.
+ */
+static size_t alignSection(size_t size){
+    return (size+7) & ~(size_t)7;
+}
+
+/**
+ * @brief Computes the offsets of the sections of a compiled file.
+ * 
+ * @param header The header of the file.
+ * @return GraphCacheLayout The offsets.
+ */
+static GraphCacheLayout computeLayout(GraphCacheHeader header){
+    size_t numNodes = header.numNodes, numEdges = header.numEdges;
+    size_t numWords = (numNodes+BITSET_WORD_BITS-1)/BITSET_WORD_BITS;
+    GraphCacheLayout layout;
+    layout.successorIndex = alignSection(sizeof(GraphCacheHeader));
+    layout.successors = alignSection(layout.successorIndex+(numNodes+1)*sizeof(int));
+    layout.predecessorIndex = alignSection(layout.successors+numEdges*sizeof(int));
+    layout.predecessors = alignSection(layout.predecessorIndex+(numNodes+1)*sizeof(int));
+    layout.sources = alignSection(layout.predecessors+numEdges*sizeof(int));
+    layout.targets = layout.sources+numWords*sizeof(BitsetWord);
+    layout.nameOffsets = layout.targets+numWords*sizeof(BitsetWord);
+    layout.names = alignSection(layout.nameOffsets+(numNodes+1)*sizeof(uint32_t));
+    layout.size = layout.names+header.namesSize;
+    return layout;
+}
+
+/**
+ * @brief Writes @p size bytes at offset @p offset of @p file, filling the gap since the current position with zeros.
+ * 
+ * @param file The file.
+ * @param offset The offset of the data.
+ * @param data The data.
+ * @param size Its size.
+ * @return true if all was written.
+ */
+static bool writeSection(FILE *file, size_t offset, const void *data, size_t size){
+    static const char padding[8] = {0};
+    long position = ftell(file);
+    if(position < 0 || (size_t)position > offset || offset-position > sizeof(padding)){
+        return false;
+    }
+    if(fwrite(padding,1,offset-position,file) != offset-position){
+        return false;
+    }
+    return fwrite(data,1,size,file) == size;
+}
+
+/**
+ * @brief Tells if a compressed sparse row read from a compiled file is well formed: the index starts at 0, never decreases and ends at
+ *        @p numEdges, and each row holds increasing node numbers in [0,@p numNodes), as isEdge expects.
+ * 
+ * @param index The numNodes+1 indexes of the rows.
+ * @param values The numEdges node numbers.
+ * @param numNodes The number of nodes.
+ * @param numEdges The number of edges.
+ * @return true if the row can be used as is.
+ */
+static bool isValidCompressedRow(const int *index, const int *values, int numNodes, int numEdges){
+    if(index[0] != 0 || index[numNodes] != numEdges){
+        return false;
+    }
+    for(int u = 0 ; u < numNodes ; u++){
+        if(index[u+1] < index[u]){
+            return false;
+        }
+        for(int e = index[u] ; e < index[u+1] ; e++){
+            if(values[e] < 0 || values[e] >= numNodes || (e > index[u] && values[e] <= values[e-1])){
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Tells if the offsets of the names read from a compiled file are well formed: they start at 0, increase and end at @p namesSize, and
+ *        each name ends with its terminating zero.
+ * 
+ * @param nameOffsets The numNodes+1 offsets.
+ * @param names The string table.
+ * @param numNodes The number of nodes.
+ * @param namesSize The size of the string table.
+ * @return true if every name can be read.
+ */
+static bool areValidNameOffsets(const uint32_t *nameOffsets, const char *names, int numNodes, uint32_t namesSize){
+    if(nameOffsets[0] != 0 || nameOffsets[numNodes] != namesSize){
+        return false;
+    }
+    for(int u = 0 ; u < numNodes ; u++){
+        if(nameOffsets[u+1] <= nameOffsets[u] || names[nameOffsets[u+1]-1] != '\0'){
+            return false;
+        }
+    }
+    return true;
+}
+
+char *getGraphCacheName(const char *fileName){
+    size_t length = strlen(fileName);
+    if(length >= 4 && strcmp(fileName+length-4,".dot") == 0){
+        length -= 4;
+    }
+    char* cacheName = (char*)malloc(length+strlen(GRAPH_CACHE_EXTENSION)+1);
+    if(cacheName == NULL){
+        printf("Not enough memory to allocate cacheName in getGraphCacheName\n");
+        exit(EXIT_FAILURE);
+    }
+    memcpy(cacheName,fileName,length);
+    strcpy(cacheName+length,GRAPH_CACHE_EXTENSION);
+    return cacheName;
+}
+
+bool isGraphCacheName(const char *fileName){
+    size_t length = strlen(fileName), extension = strlen(GRAPH_CACHE_EXTENSION);
+    return length >= extension && strcmp(fileName+length-extension,GRAPH_CACHE_EXTENSION) == 0;
+}
+
+bool isGraphCacheFresh(const char *fileName){
+    char *cacheName = getGraphCacheName(fileName);
+    struct stat fileStatus, cacheStatus;
+    bool fresh = stat(fileName,&fileStatus) == 0 && stat(cacheName,&cacheStatus) == 0 && cacheStatus.st_mtime >= fileStatus.st_mtime;
+    free(cacheName);
+    return fresh;
+}
+
+bool writeGraphCache(Graph graph, const char *cacheName){
+    int numNodes = orderG(graph), numEdges = sizeG(graph);
+    GraphCacheHeader header;
+    memset(&header,0,sizeof(header));
+    memcpy(header.magic,GRAPH_CACHE_MAGIC,sizeof(header.magic));
+    header.version = GRAPH_CACHE_VERSION;
+    header.byteOrder = GRAPH_CACHE_BYTE_ORDER;
+    header.numNodes = numNodes;
+    header.numEdges = numEdges;
+    uint32_t* nameOffsets = (uint32_t*)malloc(sizeof(uint32_t)*(numNodes+1));
+    Bitset sources = makeBitset(numNodes);
+    Bitset targets = makeBitset(numNodes);
+    if(nameOffsets == NULL){
+        printf("Not enough memory to allocate nameOffsets in writeGraphCache\n");
+        exit(EXIT_FAILURE);
+    }
+    nameOffsets[0] = 0;
+    for(int u = 0 ; u < numNodes ; u++){
+        nameOffsets[u+1] = nameOffsets[u]+strlen(getNodeName(graph,u))+1;
+        if(isSource(graph,u)) setBit(sources,u);
+        if(isTarget(graph,u)) setBit(targets,u);
+    }
+    header.namesSize = nameOffsets[numNodes];
+    GraphCacheLayout layout = computeLayout(header);
+
+    bool written = false;
+    FILE* file = fopen(cacheName,"wb");
+    if(file != NULL){
+        written = fwrite(&header,sizeof(header),1,file) == 1
+            && writeSection(file,layout.successorIndex,graph.successorIndex,sizeof(int)*(numNodes+1))
+            && writeSection(file,layout.successors,graph.successors,sizeof(int)*numEdges)
+            && writeSection(file,layout.predecessorIndex,graph.predecessorIndex,sizeof(int)*(numNodes+1))
+            && writeSection(file,layout.predecessors,graph.predecessors,sizeof(int)*numEdges)
+            && writeSection(file,layout.sources,sources.words,sizeof(BitsetWord)*sources.numWords)
+            && writeSection(file,layout.targets,targets.words,sizeof(BitsetWord)*targets.numWords)
+            && writeSection(file,layout.nameOffsets,nameOffsets,sizeof(uint32_t)*(numNodes+1));
+        written = written && writeSection(file,layout.names,NULL,0);
+        for(int u = 0 ; u < numNodes && written ; u++){
+            size_t length = nameOffsets[u+1]-nameOffsets[u];
+            written = fwrite(getNodeName(graph,u),1,length,file) == length;
+        }
+        written = fclose(file) == 0 && written;
+    }
+    free(nameOffsets);
+    deleteBitset(sources);
+    deleteBitset(targets);
+    return written;
+}
+
+bool loadGraphCache(const char *cacheName, Graph *graph){
+    int file = open(cacheName,O_RDONLY);
+    if(file < 0){
+        return false;
+    }
+    struct stat status;
+    if(fstat(file,&status) != 0 || (size_t)status.st_size < sizeof(GraphCacheHeader)){
+        close(file);
+        return false;
+    }
+    size_t size = status.st_size;
+    char* mapping = (char*)mmap(NULL,size,PROT_READ,MAP_PRIVATE,file,0);
+    close(file);
+    if(mapping == MAP_FAILED){
+        return false;
+    }
+    GraphCacheHeader header;
+    memcpy(&header,mapping,sizeof(header));
+    GraphCacheLayout layout = computeLayout(header);
+    if(memcmp(header.magic,GRAPH_CACHE_MAGIC,sizeof(header.magic)) != 0 || header.version != GRAPH_CACHE_VERSION
+       || header.byteOrder != GRAPH_CACHE_BYTE_ORDER || layout.size != size || header.numNodes > INT_MAX || header.numEdges > INT_MAX
+       || (header.namesSize > 0 && mapping[size-1] != '\0')){
+        munmap(mapping,size);
+        return false;
+    }
+    int numNodes = header.numNodes, numEdges = header.numEdges;
+    // The contents are checked too, since a corrupt file would make the accesses to the graph go out of the mapping: the caller then reads the graph file.
+    if(!isValidCompressedRow((const int*)(mapping+layout.successorIndex),(const int*)(mapping+layout.successors),numNodes,numEdges)
+       || !isValidCompressedRow((const int*)(mapping+layout.predecessorIndex),(const int*)(mapping+layout.predecessors),numNodes,numEdges)
+       || !areValidNameOffsets((const uint32_t*)(mapping+layout.nameOffsets),mapping+layout.names,numNodes,header.namesSize)){
+        munmap(mapping,size);
+        return false;
+    }
+    graph->numNodes = numNodes;
+    graph->numEdges = numEdges;
+    graph->successorIndex = (int*)(mapping+layout.successorIndex);
+    graph->successors = (int*)(mapping+layout.successors);
+    graph->predecessorIndex = (int*)(mapping+layout.predecessorIndex);
+    graph->predecessors = (int*)(mapping+layout.predecessors);
+    graph->mapping = mapping;
+    graph->mappingSize = size;
+    // Only the arrays of pointers and of booleans expected by Graph are built, the rest stays in the mapping.
+    graph->nodes = (char**)malloc(sizeof(char*)*(numNodes+1));
+    graph->initial = (bool*)malloc(sizeof(bool)*(numNodes+1));
+    graph->final = (bool*)malloc(sizeof(bool)*(numNodes+1));
+    if(graph->nodes == NULL || graph->initial == NULL || graph->final == NULL){
+        printf("Not enough memory to allocate graph in loadGraphCache\n");
+        exit(EXIT_FAILURE);
+    }
+    const uint32_t* nameOffsets = (const uint32_t*)(mapping+layout.nameOffsets);
+    const BitsetWord* sources = (const BitsetWord*)(mapping+layout.sources);
+    const BitsetWord* targets = (const BitsetWord*)(mapping+layout.targets);
+    for(int u = 0 ; u < numNodes ; u++){
+        graph->nodes[u] = mapping+layout.names+nameOffsets[u];
+        graph->initial[u] = (sources[u/BITSET_WORD_BITS] >> (u%BITSET_WORD_BITS)) & 1;
+        graph->final[u] = (targets[u/BITSET_WORD_BITS] >> (u%BITSET_WORD_BITS)) & 1;
+    }
+    return true;
+}
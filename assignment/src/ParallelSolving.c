@@ -0,0 +1,833 @@
+#include "ParallelSolving.h"
+#include "Solving.h"
+#include "Z3Tools.h"
+#include "Bounds.h"
+#include "Budget.h"
+#include <z3.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/**
+ * @brief The state of an exploration shared by its threads. The fields after @p lock are protected by it.
+ */
+typedef struct {
+    Graph *graphs;          ///< The graphs, only read.
+    int numGraphs;          ///< The number of graphs.
+    int maxLength;          ///< The largest length.
+    bool decreasing;        ///< Tells if the lengths are explored in decreasing order.
+    bool all;               ///< Tells if every length is wanted.
+    bool incremental;       ///< Tells if each thread keeps an incremental solver.
+    bool wantPaths;         ///< Tells if the paths are wanted.
+    AmoEncoding amoEncoding;    ///< The encoding of the at-most-one constraints of the caller.
+    NodeEncoding nodeEncoding;  ///< The encoding of the nodes of the caller.
+    bool pruning;               ///< The pruning of the caller.
+    bool *candidates;       ///< The lengths within the bounds (and of a common walk when pruning), or NULL. The others are unsatisfiable.
+    int numThreads;         ///< The number of threads.
+    pthread_mutex_t lock;   ///< The lock of the following fields.
+    int nextIndex;          ///< The next index of the exploration to check.
+    int bound;              ///< The first index of the exploration known to be satisfiable: the later ones are not needed.
+    Z3_context *contexts;   ///< The context of each thread while it is in a check, NULL otherwise: only a check can be interrupted safely.
+    int *indexes;           ///< The index checked by each thread, -1 if none.
+    SweepResults results;   ///< The answers.
+} Sweep;
+
+/**
+ * @brief The argument of a thread of an exploration.
+ */
+typedef struct {
+    Sweep *sweep;   ///< The exploration.
+    int id;         ///< The number of the thread.
+} SweepWorker;
+
+/**
+ * @brief Small function returning the length checked at index @p index of the exploration.
+ * 
+ * @param sweep The exploration.
+ * @param index An index of the exploration.
+ * @return The length.
+ */
+static int getSweepLength(Sweep *sweep, int index){
+    return sweep->decreasing ? sweep->maxLength-index : index;
+}
+
+/**
+ * @brief Small function making the context of thread @p id interruptible while it checks index @p index, if this index is still needed.
+ * 
+ * @param sweep The exploration.
+ * @param id The number of the thread.
+ * @param index The index checked.
+ * @param ctx The context of the thread.
+ * @return true iff the index is still needed, in which case leaveSweepCheck must be called after the check.
+ */
+static bool enterSweepCheck(Sweep *sweep, int id, int index, Z3_context ctx){
+    pthread_mutex_lock(&sweep->lock);
+    bool needed = index <= sweep->bound;
+    if(needed){
+        sweep->contexts[id] = ctx;
+    }
+    pthread_mutex_unlock(&sweep->lock);
+    return needed;
+}
+
+/**
+ * @brief Small function making the context of thread @p id not interruptible any more.
+ * 
+ * @param sweep The exploration.
+ * @param id The number of the thread.
+ */
+static void leaveSweepCheck(Sweep *sweep, int id){
+    pthread_mutex_lock(&sweep->lock);
+    sweep->contexts[id] = NULL;
+    pthread_mutex_unlock(&sweep->lock);
+}
+
+/**
+ * @brief A function checking a single length in the context of a thread.
+ * 
+ * @param ctx The context of the thread.
+ * @param window The window of the incremental solver of the thread, or NULL.
+ * @param sweep The exploration.
+ * @param id The number of the thread.
+ * @param index The index of the length in the exploration.
+ * @param paths Set to the paths if the length is satisfiable and they are wanted.
+ * @return The answer, Z3_L_UNDEF if the length is not needed any more.
+ */
+static Z3_lbool checkSweepLength(Z3_context ctx, LengthWindow *window, Sweep *sweep, int id, int index, int **paths){
+    int pathLength = getSweepLength(sweep,index);
+    Z3_lbool res = Z3_L_UNDEF;
+    Z3_model model = NULL;
+    if(window != NULL){
+        Z3_solver solver = getLengthWindowSolver(ctx,window,sweep->graphs,sweep->numGraphs,pathLength,0,sweep->maxLength,sweep->decreasing);
+        if(enterSweepCheck(sweep,id,index,ctx)){
+            res = isPathLengthSat(ctx,solver,pathLength);
+            leaveSweepCheck(sweep,id);
+        }
+        if(res == Z3_L_TRUE && sweep->wantPaths){
+            model = getModelFromSolver(ctx,solver);
+        }
+        retractPathFormulaFromSolver(ctx,solver,pathLength);
+    }else{
+        Z3_solver lengthSolver = makeSolver(ctx);
+        Z3_solver_assert(ctx,lengthSolver,graphsToPathFormula(ctx,sweep->graphs,sweep->numGraphs,pathLength));
+        if(enterSweepCheck(sweep,id,index,ctx)){
+            res = checkSolver(ctx,lengthSolver);
+            leaveSweepCheck(sweep,id);
+        }
+        if(res == Z3_L_TRUE && sweep->wantPaths){
+            model = getModelFromSolver(ctx,lengthSolver);
+        }
+        deleteSolver(ctx,lengthSolver);
+    }
+    if(model != NULL){
+        *paths = getPathsFromModel(ctx,model,sweep->graphs,sweep->numGraphs,pathLength);
+        Z3_model_dec_ref(ctx,model);
+    }
+    return res;
+}
+
+/**
+ * @brief The function run by each thread of an exploration: it takes the next index of the exploration until there is none left or needed.
+ * 
+ * @param arg The SweepWorker of the thread.
+ * @return NULL.
+ */
+static void *runSweepWorker(void *arg){
+    Sweep *sweep = ((SweepWorker*)arg)->sweep;
+    int id = ((SweepWorker*)arg)->id;
+    int numLengths = sweep->maxLength+1;
+    setAmoEncoding(sweep->amoEncoding);
+    setNodeEncoding(sweep->nodeEncoding);
+    setPruning(sweep->pruning);
+    Z3_context ctx = makeContext();
+    initNodeVariables(ctx,sweep->graphs,sweep->numGraphs);
+    LengthWindow window;
+    initLengthWindow(&window);
+    while(true){
+        pthread_mutex_lock(&sweep->lock);
+        int index = sweep->nextIndex;
+        if(index >= numLengths || index > sweep->bound){
+            pthread_mutex_unlock(&sweep->lock);
+            break;
+        }
+        sweep->nextIndex++;
+        sweep->indexes[id] = index;
+        pthread_mutex_unlock(&sweep->lock);
+
+        int pathLength = getSweepLength(sweep,index);
+        int *paths = NULL;
+        Z3_lbool res = Z3_L_FALSE;
+        if(sweep->candidates == NULL || sweep->candidates[pathLength]){
+            // Once the budget of the query has run out, the lengths left are unknown without building their formula.
+            res = isQueryBudgetExhausted() ? Z3_L_UNDEF : checkSweepLength(ctx,sweep->incremental ? &window : NULL,sweep,id,index,&paths);
+        }
+
+        pthread_mutex_lock(&sweep->lock);
+        sweep->indexes[id] = -1;
+        LengthResult result = res == Z3_L_TRUE ? LENGTH_SAT : res == Z3_L_FALSE ? LENGTH_UNSAT : LENGTH_UNDEF;
+        if(result == LENGTH_UNDEF && index > sweep->bound){
+            result = LENGTH_CANCELLED;
+        }
+        sweep->results.results[pathLength] = result;
+        sweep->results.paths[pathLength] = paths;
+        if(result == LENGTH_SAT && !sweep->all && index < sweep->bound){
+            // The later lengths are not needed any more.
+            sweep->bound = index;
+            for(int other = 0 ; other < sweep->numThreads ; other++){
+                if(other != id && sweep->contexts[other] != NULL && sweep->indexes[other] > index){
+                    Z3_interrupt(sweep->contexts[other]);
+                }
+            }
+        }
+        pthread_mutex_unlock(&sweep->lock);
+    }
+    deleteLengthWindow(ctx,&window);
+    deleteNodeVariables();
+    Z3_del_context(ctx);
+    return NULL;
+}
+
+SweepResults parallelSweep(Graph *graphs, int numGraphs, int maxLength, bool decreasing, bool all, bool incremental, bool wantPaths, int numThreads){
+    int numLengths = maxLength+1;
+    Sweep sweep;
+    sweep.graphs = graphs;
+    sweep.numGraphs = numGraphs;
+    sweep.maxLength = maxLength;
+    sweep.decreasing = decreasing;
+    sweep.all = all;
+    sweep.incremental = incremental;
+    sweep.wantPaths = wantPaths;
+    sweep.amoEncoding = getAmoEncoding();
+    sweep.nodeEncoding = getNodeEncoding();
+    sweep.pruning = getPruning();
+    sweep.candidates = numLengths > 0 ? computeCandidateLengths(graphs,numGraphs,maxLength,sweep.pruning,NULL) : NULL;
+    sweep.nextIndex = 0;
+    sweep.bound = numLengths;
+    sweep.results.maxLength = maxLength;
+    sweep.results.results = (LengthResult*)malloc(sizeof(LengthResult)*(numLengths+1));
+    sweep.results.paths = (int**)malloc(sizeof(int*)*(numLengths+1));
+    if(numThreads > numLengths){
+        numThreads = numLengths;
+    }
+    if(numThreads < 1){
+        numThreads = 1;
+    }
+    sweep.numThreads = numThreads;
+    sweep.contexts = (Z3_context*)malloc(sizeof(Z3_context)*numThreads);
+    sweep.indexes = (int*)malloc(sizeof(int)*numThreads);
+    pthread_t* threads = (pthread_t*)malloc(sizeof(pthread_t)*numThreads);
+    SweepWorker* workers = (SweepWorker*)malloc(sizeof(SweepWorker)*numThreads);
+    if(sweep.results.results == NULL || sweep.results.paths == NULL || sweep.contexts == NULL || sweep.indexes == NULL || threads == NULL || workers == NULL){
+        printf("Not enough memory to allocate sweep in parallelSweep\n");
+        exit(EXIT_FAILURE);
+    }
+    for(int k = 0 ; k <= numLengths ; k++){
+        sweep.results.results[k] = LENGTH_UNKNOWN;
+        sweep.results.paths[k] = NULL;
+    }
+    for(int t = 0 ; t < numThreads ; t++){
+        sweep.contexts[t] = NULL;
+        sweep.indexes[t] = -1;
+    }
+    pthread_mutex_init(&sweep.lock,NULL);
+    int numStarted = 0;
+    for(int t = 0 ; t < numThreads && numLengths > 0 ; t++){
+        workers[t].sweep = &sweep;
+        workers[t].id = t;
+        if(pthread_create(&threads[t],NULL,runSweepWorker,&workers[t]) != 0){
+            break;
+        }
+        numStarted++;
+    }
+    if(numStarted == 0 && numLengths > 0){
+        // No thread could be started: the exploration is done by the current one.
+        workers[0].sweep = &sweep;
+        workers[0].id = 0;
+        runSweepWorker(&workers[0]);
+        setAmoEncoding(sweep.amoEncoding);
+        setNodeEncoding(sweep.nodeEncoding);
+        setPruning(sweep.pruning);
+    }
+    for(int t = 0 ; t < numStarted ; t++){
+        pthread_join(threads[t],NULL);
+    }
+    pthread_mutex_destroy(&sweep.lock);
+    free(sweep.candidates);
+    free(sweep.contexts);
+    free(sweep.indexes);
+    free(threads);
+    free(workers);
+    return sweep.results;
+}
+
+void deleteSweepResults(SweepResults results){
+    for(int k = 0 ; k <= results.maxLength ; k++){
+        free(results.paths[k]);
+    }
+    free(results.paths);
+    free(results.results);
+}
+
+int getNumProcessors(void){
+    long num = sysconf(_SC_NPROCESSORS_ONLN);
+    return num < 1 ? 1 : (int)num;
+}
+
+/**
+ * @brief A way of solving raced by the portfolio.
+ */
+typedef struct {
+    const char *name;           ///< The name of the configuration.
+    bool byLength;              ///< Tells if the lengths are checked one by one with an incremental solver, instead of the global formula.
+    bool decreasing;            ///< Tells if the lengths are checked in decreasing order.
+    NodeEncoding nodeEncoding;  ///< The encoding of the nodes.
+    AmoEncoding amoEncoding;    ///< The encoding of the at-most-one constraints.
+} PortfolioConfiguration;
+
+static const PortfolioConfiguration portfolioConfigurations[] = {
+    {"global/onehot", false, false, NODE_ONEHOT, AMO_SEQUENTIAL},
+    {"global/binary", false, false, NODE_BINARY, AMO_SEQUENTIAL},
+    {"increasing/onehot", true, false, NODE_ONEHOT, AMO_SEQUENTIAL},
+    {"decreasing/onehot", true, true, NODE_ONEHOT, AMO_SEQUENTIAL},
+    {"increasing/binary", true, false, NODE_BINARY, AMO_SEQUENTIAL}
+};
+
+/**
+ * @brief The state of a portfolio shared by its threads. The fields after @p lock are protected by it.
+ */
+typedef struct {
+    Graph *graphs;          ///< The graphs, only read.
+    int numGraphs;          ///< The number of graphs.
+    bool wantPaths;         ///< Tells if the paths are wanted.
+    bool pruning;           ///< The pruning of the caller.
+    pthread_mutex_t lock;   ///< The lock of the following fields.
+    volatile bool decided;  ///< Tells if a configuration has answered.
+    Z3_context *contexts;   ///< The context of each thread while it is in a check, NULL otherwise: only a check can be interrupted safely.
+    PortfolioResult result; ///< The answer.
+} Portfolio;
+
+/**
+ * @brief The argument of a thread of a portfolio.
+ */
+typedef struct {
+    Portfolio *portfolio;   ///< The portfolio.
+    int id;                 ///< The number of the thread, which is the one of its configuration.
+} PortfolioWorker;
+
+/**
+ * @brief Small function making the context of thread @p id interruptible during a check, if no configuration has answered yet and the budget of
+ *        the query has not run out.
+ * 
+ * @param portfolio The portfolio.
+ * @param id The number of the thread.
+ * @param ctx The context of the thread.
+ * @return true iff the check is still needed, in which case leavePortfolioCheck must be called after it.
+ */
+static bool enterPortfolioCheck(Portfolio *portfolio, int id, Z3_context ctx){
+    pthread_mutex_lock(&portfolio->lock);
+    bool needed = !portfolio->decided && !isQueryBudgetExhausted();
+    if(needed){
+        portfolio->contexts[id] = ctx;
+    }
+    pthread_mutex_unlock(&portfolio->lock);
+    return needed;
+}
+
+/**
+ * @brief Small function making the context of thread @p id not interruptible any more.
+ * 
+ * @param portfolio The portfolio.
+ * @param id The number of the thread.
+ */
+static void leavePortfolioCheck(Portfolio *portfolio, int id){
+    pthread_mutex_lock(&portfolio->lock);
+    portfolio->contexts[id] = NULL;
+    pthread_mutex_unlock(&portfolio->lock);
+}
+
+/**
+ * @brief A function solving the question of the portfolio with the configuration of a thread.
+ * 
+ * @param ctx The context of the thread.
+ * @param portfolio The portfolio.
+ * @param id The number of the thread, which is the one of its configuration.
+ * @param pathLength Set to the common length found, if any.
+ * @param paths Set to the paths if a length is found and they are wanted.
+ * @return The answer, Z3_L_UNDEF if another configuration answered first.
+ */
+static Z3_lbool solvePortfolioConfiguration(Z3_context ctx, Portfolio *portfolio, int id, int *pathLength, int **paths){
+    const PortfolioConfiguration *configuration = &portfolioConfigurations[id];
+    Graph *graphs = portfolio->graphs;
+    int numGraphs = portfolio->numGraphs;
+    Z3_solver solver = makeSolver(ctx);
+    Z3_lbool res = Z3_L_FALSE;
+    if(!configuration->byLength){
+        Z3_ast formula = graphsToFullFormula(ctx,graphs,numGraphs);
+        if(formula != NULL){
+            Z3_solver_assert(ctx,solver,formula);
+            res = Z3_L_UNDEF;
+            if(enterPortfolioCheck(portfolio,id,ctx)){
+                res = checkSolver(ctx,solver);
+                leavePortfolioCheck(portfolio,id);
+            }
+        }
+        if(res == Z3_L_TRUE){
+            Z3_model model = getModelFromSolver(ctx,solver);
+            *pathLength = getSolutionLengthFromModel(ctx,model,graphs);
+            if(portfolio->wantPaths){
+                *paths = getPathsFromModel(ctx,model,graphs,numGraphs,*pathLength);
+            }
+            Z3_model_dec_ref(ctx,model);
+        }
+    }else{
+        int maxLength = orderG(graphs[0])-1;
+        for(int i = 1 ; i < numGraphs ; i++){
+            if(orderG(graphs[i])-1 < maxLength) maxLength = orderG(graphs[i])-1;
+        }
+        addUnifiedFormulaToSolver(ctx,solver,graphs,numGraphs,1,maxLength);
+        bool unknown = false;
+        for(int j = 1 ; j <= maxLength && res != Z3_L_TRUE && !portfolio->decided ; j++){
+            int k = configuration->decreasing ? maxLength+1-j : j;
+            Z3_lbool lengthRes = Z3_L_UNDEF;
+            if(enterPortfolioCheck(portfolio,id,ctx)){
+                lengthRes = isPathLengthSat(ctx,solver,k);
+                leavePortfolioCheck(portfolio,id);
+            }
+            if(lengthRes == Z3_L_TRUE){
+                Z3_model model = getModelFromSolver(ctx,solver);
+                *pathLength = k;
+                if(portfolio->wantPaths){
+                    *paths = getPathsFromModel(ctx,model,graphs,numGraphs,k);
+                }
+                Z3_model_dec_ref(ctx,model);
+                res = Z3_L_TRUE;
+            }else{
+                unknown = unknown || lengthRes == Z3_L_UNDEF || portfolio->decided;
+                retractPathFormulaFromSolver(ctx,solver,k);
+            }
+        }
+        if(res != Z3_L_TRUE && (unknown || portfolio->decided)){
+            res = Z3_L_UNDEF;
+        }
+    }
+    deleteSolver(ctx,solver);
+    return res;
+}
+
+/**
+ * @brief The function run by each thread of a portfolio.
+ * 
+ * @param arg The PortfolioWorker of the thread.
+ * @return NULL.
+ */
+static void *runPortfolioWorker(void *arg){
+    Portfolio *portfolio = ((PortfolioWorker*)arg)->portfolio;
+    int id = ((PortfolioWorker*)arg)->id;
+    const PortfolioConfiguration *configuration = &portfolioConfigurations[id];
+    setAmoEncoding(configuration->amoEncoding);
+    setNodeEncoding(configuration->nodeEncoding);
+    setPruning(portfolio->pruning);
+    Z3_context ctx = makeContext();
+    initNodeVariables(ctx,portfolio->graphs,portfolio->numGraphs);
+
+    int pathLength = -1;
+    int *paths = NULL;
+    Z3_lbool res = Z3_L_UNDEF;
+    if(!portfolio->decided){
+        res = solvePortfolioConfiguration(ctx,portfolio,id,&pathLength,&paths);
+    }
+
+    pthread_mutex_lock(&portfolio->lock);
+    if(res != Z3_L_UNDEF && !portfolio->decided){
+        portfolio->decided = true;
+        portfolio->result.result = res == Z3_L_TRUE ? LENGTH_SAT : LENGTH_UNSAT;
+        portfolio->result.pathLength = pathLength;
+        portfolio->result.paths = paths;
+        portfolio->result.winner = id;
+        paths = NULL;
+        for(int other = 0 ; other < getNumPortfolioConfigurations() ; other++){
+            if(portfolio->contexts[other] != NULL){
+                Z3_interrupt(portfolio->contexts[other]);
+            }
+        }
+    }
+    pthread_mutex_unlock(&portfolio->lock);
+    free(paths);
+    deleteNodeVariables();
+    Z3_del_context(ctx);
+    return NULL;
+}
+
+int getNumPortfolioConfigurations(void){
+    return sizeof(portfolioConfigurations)/sizeof(portfolioConfigurations[0]);
+}
+
+const char *getPortfolioConfigurationName(int configuration){
+    return portfolioConfigurations[configuration].name;
+}
+
+PortfolioResult portfolioSolve(Graph *graphs, int numGraphs, bool wantPaths){
+    int numConfigurations = getNumPortfolioConfigurations();
+    Portfolio portfolio;
+    portfolio.graphs = graphs;
+    portfolio.numGraphs = numGraphs;
+    portfolio.wantPaths = wantPaths;
+    portfolio.pruning = getPruning();
+    portfolio.decided = false;
+    portfolio.result.result = LENGTH_UNDEF;
+    portfolio.result.pathLength = -1;
+    portfolio.result.paths = NULL;
+    portfolio.result.winner = -1;
+    portfolio.contexts = (Z3_context*)malloc(sizeof(Z3_context)*numConfigurations);
+    pthread_t* threads = (pthread_t*)malloc(sizeof(pthread_t)*numConfigurations);
+    PortfolioWorker* workers = (PortfolioWorker*)malloc(sizeof(PortfolioWorker)*numConfigurations);
+    bool* started = (bool*)malloc(sizeof(bool)*numConfigurations);
+    if(portfolio.contexts == NULL || threads == NULL || workers == NULL || started == NULL){
+        printf("Not enough memory to allocate portfolio in portfolioSolve\n");
+        exit(EXIT_FAILURE);
+    }
+    pthread_mutex_init(&portfolio.lock,NULL);
+    for(int t = 0 ; t < numConfigurations ; t++){
+        portfolio.contexts[t] = NULL;
+        workers[t].portfolio = &portfolio;
+        workers[t].id = t;
+        started[t] = pthread_create(&threads[t],NULL,runPortfolioWorker,&workers[t]) == 0;
+    }
+    for(int t = 0 ; t < numConfigurations ; t++){
+        if(started[t]){
+            pthread_join(threads[t],NULL);
+        }
+    }
+    pthread_mutex_destroy(&portfolio.lock);
+    free(portfolio.contexts);
+    free(threads);
+    free(workers);
+    free(started);
+    return portfolio.result;
+}
+
+/**
+ * @brief The state of a separable solving shared by its threads. The fields after @p lock are protected by it.
+ */
+typedef struct {
+    Graph *graphs;              ///< The graphs, only read.
+    int numGraphs;              ///< The number of graphs.
+    int minLength;              ///< The smallest length.
+    int maxLength;              ///< The largest length.
+    bool all;                   ///< Tells if every length is wanted, otherwise the first common length found is enough.
+    bool wantPaths;             ///< Tells if the paths are wanted.
+    AmoEncoding amoEncoding;    ///< The encoding of the at-most-one constraints of the caller.
+    NodeEncoding nodeEncoding;  ///< The encoding of the nodes of the caller.
+    bool pruning;               ///< The pruning of the caller.
+    int numThreads;             ///< The number of threads.
+    pthread_mutex_t lock;       ///< The lock of the following fields.
+    int *order;                 ///< The graphs in the order they are solved.
+    int nextGraph;              ///< The next graph to solve in @p order.
+    volatile bool decided;      ///< Tells if no common length is left, or if a common length is found and @p all is false.
+    bool *possible;             ///< The lengths not ruled out by a graph yet.
+    bool **found;               ///< The lengths found for each graph.
+    bool *complete;             ///< Tells for each graph if all its lengths are known.
+    int ***paths;               ///< For each graph and length found, a path of this length if they are wanted.
+    Z3_context *contexts;       ///< The context of each thread while it is in a check, NULL otherwise.
+} Separable;
+
+/**
+ * @brief The argument of a thread of a separable solving.
+ */
+typedef struct {
+    Separable *separable;   ///< The separable solving.
+    int id;                 ///< The number of the thread.
+} SeparableWorker;
+
+/**
+ * @brief Small function ending a separable solving: the threads in a check are interrupted and no other check is started. Must be called with the
+ *        lock held.
+ * 
+ * @param separable The separable solving.
+ */
+static void decideSeparable(Separable *separable){
+    if(separable->decided){
+        return;
+    }
+    separable->decided = true;
+    for(int other = 0 ; other < separable->numThreads ; other++){
+        if(separable->contexts[other] != NULL){
+            Z3_interrupt(separable->contexts[other]);
+        }
+    }
+}
+
+/**
+ * @brief A function enumerating the lengths of the simple accepting paths of graph @p graph alone, in the context of a thread.
+ * 
+ * @param separable The separable solving.
+ * @param id The number of the thread.
+ * @param graph The number of the graph.
+ */
+static void solveSeparableGraph(Separable *separable, int id, int graph){
+    Graph *graphs = separable->graphs+graph;
+    int maxLength = separable->maxLength;
+    Z3_context ctx = makeContext();
+    initNodeVariables(ctx,graphs,1);
+    Z3_solver solver = makeSolver(ctx);
+    addUnifiedFormulaToSolver(ctx,solver,graphs,1,separable->minLength,maxLength);
+    bool* excluded = (bool*)calloc(maxLength+2,sizeof(bool));
+    if(excluded == NULL){
+        printf("Not enough memory to allocate excluded in solveSeparableGraph\n");
+        exit(EXIT_FAILURE);
+    }
+    Z3_lbool res = Z3_L_TRUE;
+    while(res == Z3_L_TRUE && !separable->decided){
+        // The lengths ruled out by the other graphs are not searched any more.
+        pthread_mutex_lock(&separable->lock);
+        for(int k = separable->minLength ; k <= maxLength ; k++){
+            if(!separable->possible[k] && !excluded[k]){
+                excluded[k] = true;
+                retractPathFormulaFromSolver(ctx,solver,k);
+            }
+        }
+        bool needed = !separable->decided && !isQueryBudgetExhausted();
+        if(needed){
+            separable->contexts[id] = ctx;
+        }
+        pthread_mutex_unlock(&separable->lock);
+        res = Z3_L_UNDEF;
+        if(needed){
+            res = checkSolver(ctx,solver);
+            pthread_mutex_lock(&separable->lock);
+            separable->contexts[id] = NULL;
+            pthread_mutex_unlock(&separable->lock);
+        }
+        if(res == Z3_L_TRUE){
+            Z3_model model = getModelFromSolver(ctx,solver);
+            int pathLength = getSolutionLengthFromModel(ctx,model,graphs);
+            int *path = separable->wantPaths ? getPathsFromModel(ctx,model,graphs,1,pathLength) : NULL;
+            Z3_model_dec_ref(ctx,model);
+            pthread_mutex_lock(&separable->lock);
+            separable->found[graph][pathLength] = true;
+            separable->paths[graph][pathLength] = path;
+            // Without all the lengths, a length found in every graph answers the question.
+            bool common = !separable->all;
+            for(int i = 0 ; i < separable->numGraphs && common ; i++){
+                common = separable->found[i][pathLength];
+            }
+            if(common){
+                decideSeparable(separable);
+            }
+            pthread_mutex_unlock(&separable->lock);
+            excluded[pathLength] = true;
+            retractPathFormulaFromSolver(ctx,solver,pathLength);
+        }
+    }
+    if(res == Z3_L_FALSE){
+        // Every length of this graph is known: the others are ruled out for all graphs.
+        pthread_mutex_lock(&separable->lock);
+        separable->complete[graph] = true;
+        bool left = false;
+        for(int k = separable->minLength ; k <= maxLength ; k++){
+            separable->possible[k] = separable->possible[k] && separable->found[graph][k];
+            left = left || separable->possible[k];
+        }
+        if(!left){
+            decideSeparable(separable);
+        }
+        pthread_mutex_unlock(&separable->lock);
+    }
+    free(excluded);
+    deleteSolver(ctx,solver);
+    deleteNodeVariables();
+    Z3_del_context(ctx);
+}
+
+/**
+ * @brief The function run by each thread of a separable solving: it takes the next graph until there is none left or no common length is left.
+ * 
+ * @param arg The SeparableWorker of the thread.
+ * @return NULL.
+ */
+static void *runSeparableWorker(void *arg){
+    Separable *separable = ((SeparableWorker*)arg)->separable;
+    int id = ((SeparableWorker*)arg)->id;
+    setAmoEncoding(separable->amoEncoding);
+    setNodeEncoding(separable->nodeEncoding);
+    setPruning(separable->pruning);
+    while(true){
+        pthread_mutex_lock(&separable->lock);
+        int next = separable->nextGraph++;
+        bool needed = next < separable->numGraphs && !separable->decided && !isQueryBudgetExhausted();
+        pthread_mutex_unlock(&separable->lock);
+        if(!needed){
+            break;
+        }
+        solveSeparableGraph(separable,id,separable->order[next]);
+    }
+    return NULL;
+}
+
+/**
+ * @brief Sorts the graphs by increasing number of lengths of walks from their source to their target. A graph with few lengths is usually
+ *        enumerated quickly: once complete, it rules out the lengths it lacks for the others, and it gives its thread back to the graphs not
+ *        started yet, which must all be started before a length can be found in every graph and end the solving early.
+ * 
+ * @param graphs An array of graphs.
+ * @param numGraphs The number of graphs in @p graphs.
+ * @param minLength The smallest length.
+ * @param maxLength The largest length.
+ * @return int* The numbers of the graphs in the order they should be solved, to be freed.
+ */
+static int *sortGraphsByWalkLengths(Graph *graphs, int numGraphs, int minLength, int maxLength){
+    int* order = (int*)malloc(sizeof(int)*(numGraphs+1));
+    int* counts = (int*)malloc(sizeof(int)*(numGraphs+1));
+    if(order == NULL || counts == NULL){
+        printf("Not enough memory to allocate order in sortGraphsByWalkLengths\n");
+        exit(EXIT_FAILURE);
+    }
+    for(int i = 0 ; i < numGraphs ; i++){
+        counts[i] = 0;
+        if(maxLength >= 0){
+            bool *lengths = computeWalkLengths(graphs[i],maxLength);
+            for(int k = minLength ; k <= maxLength ; k++){
+                counts[i] += lengths[k] ? 1 : 0;
+            }
+            free(lengths);
+        }
+        // Insertion sort, stable so that equal graphs keep their order.
+        int j = i;
+        while(j > 0 && counts[order[j-1]] > counts[i]){
+            order[j] = order[j-1];
+            j--;
+        }
+        order[j] = i;
+    }
+    free(counts);
+    return order;
+}
+
+SweepResults separableSolve(Graph *graphs, int numGraphs, int minLength, int maxLength, bool all, bool wantPaths, int numThreads){
+    int numLengths = maxLength+1;
+    Separable separable;
+    separable.graphs = graphs;
+    separable.numGraphs = numGraphs;
+    separable.minLength = minLength;
+    separable.maxLength = maxLength;
+    separable.all = all;
+    separable.wantPaths = wantPaths;
+    separable.amoEncoding = getAmoEncoding();
+    separable.nodeEncoding = getNodeEncoding();
+    separable.pruning = getPruning();
+    if(numThreads > numGraphs){
+        numThreads = numGraphs;
+    }
+    if(numThreads < 1){
+        numThreads = 1;
+    }
+    separable.numThreads = numThreads;
+    separable.nextGraph = 0;
+    separable.decided = false;
+    separable.possible = numLengths > 0 ? computeCandidateLengths(graphs,numGraphs,maxLength,separable.pruning,NULL) : (bool*)malloc(sizeof(bool)*(numLengths+1));
+    separable.found = (bool**)malloc(sizeof(bool*)*numGraphs);
+    separable.complete = (bool*)calloc(numGraphs,sizeof(bool));
+    separable.paths = (int***)malloc(sizeof(int**)*numGraphs);
+    separable.contexts = (Z3_context*)calloc(numThreads,sizeof(Z3_context));
+    pthread_t* threads = (pthread_t*)malloc(sizeof(pthread_t)*numThreads);
+    SeparableWorker* workers = (SeparableWorker*)malloc(sizeof(SeparableWorker)*numThreads);
+    SweepResults results;
+    results.maxLength = maxLength;
+    results.results = (LengthResult*)malloc(sizeof(LengthResult)*(numLengths+1));
+    results.paths = (int**)calloc(numLengths+1,sizeof(int*));
+    if(separable.possible == NULL || separable.found == NULL || separable.complete == NULL || separable.paths == NULL || separable.contexts == NULL
+       || threads == NULL || workers == NULL || results.results == NULL || results.paths == NULL){
+        printf("Not enough memory to allocate separable in separableSolve\n");
+        exit(EXIT_FAILURE);
+    }
+    for(int k = 0 ; k < numLengths ; k++){
+        if(k < minLength){
+            separable.possible[k] = false;
+        }
+    }
+    for(int i = 0 ; i < numGraphs ; i++){
+        separable.found[i] = (bool*)calloc(numLengths+1,sizeof(bool));
+        separable.paths[i] = (int**)calloc(numLengths+1,sizeof(int*));
+        if(separable.found[i] == NULL || separable.paths[i] == NULL){
+            printf("Not enough memory to allocate separable in separableSolve\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    separable.order = sortGraphsByWalkLengths(graphs,numGraphs,minLength,maxLength);
+    bool* candidates = (bool*)malloc(sizeof(bool)*(numLengths+1));
+    if(candidates == NULL){
+        printf("Not enough memory to allocate candidates in separableSolve\n");
+        exit(EXIT_FAILURE);
+    }
+    for(int k = 0 ; k < numLengths ; k++){
+        candidates[k] = separable.possible[k];
+    }
+    pthread_mutex_init(&separable.lock,NULL);
+    int numStarted = 0;
+    for(int t = 0 ; t < numThreads && numLengths > 0 ; t++){
+        workers[t].separable = &separable;
+        workers[t].id = t;
+        if(pthread_create(&threads[t],NULL,runSeparableWorker,&workers[t]) != 0){
+            break;
+        }
+        numStarted++;
+    }
+    if(numStarted == 0 && numLengths > 0){
+        // No thread could be started: the graphs are solved by the current one.
+        workers[0].separable = &separable;
+        workers[0].id = 0;
+        runSeparableWorker(&workers[0]);
+        setAmoEncoding(separable.amoEncoding);
+        setNodeEncoding(separable.nodeEncoding);
+        setPruning(separable.pruning);
+    }
+    for(int t = 0 ; t < numStarted ; t++){
+        pthread_join(threads[t],NULL);
+    }
+    pthread_mutex_destroy(&separable.lock);
+    for(int k = 0 ; k < numLengths ; k++){
+        bool all = true, ruledOut = k >= minLength && !candidates[k];
+        for(int i = 0 ; i < numGraphs ; i++){
+            all = all && separable.found[i][k];
+            ruledOut = ruledOut || (separable.complete[i] && !separable.found[i][k]);
+        }
+        if(k < minLength){
+            results.results[k] = LENGTH_UNKNOWN;
+        }else if(all){
+            results.results[k] = LENGTH_SAT;
+        }else if(ruledOut){
+            results.results[k] = LENGTH_UNSAT;
+        }else{
+            results.results[k] = LENGTH_UNDEF;
+        }
+        if(results.results[k] == LENGTH_SAT && wantPaths){
+            results.paths[k] = (int*)malloc(sizeof(int)*(numGraphs*(k+1)+1));
+            if(results.paths[k] == NULL){
+                printf("Not enough memory to allocate paths in separableSolve\n");
+                exit(EXIT_FAILURE);
+            }
+            for(int i = 0 ; i < numGraphs ; i++){
+                memcpy(results.paths[k]+i*(k+1),separable.paths[i][k],sizeof(int)*(k+1));
+            }
+        }
+    }
+    for(int i = 0 ; i < numGraphs ; i++){
+        for(int k = 0 ; k < numLengths ; k++){
+            free(separable.paths[i][k]);
+        }
+        free(separable.paths[i]);
+        free(separable.found[i]);
+    }
+    free(candidates);
+    free(separable.order);
+    free(separable.possible);
+    free(separable.found);
+    free(separable.complete);
+    free(separable.paths);
+    free(separable.contexts);
+    free(threads);
+    free(workers);
+    return results;
+}
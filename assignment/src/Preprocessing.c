@@ -0,0 +1,140 @@
+#include "Preprocessing.h"
+#include "Bitset.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ * @brief Small function filling @p dist with the number of edges of a shortest path from @p start to each node (or to @p start if @p backwards),
+ *        with a breadth first search.
+ * 
+ * @param graph A graph.
+ * @param start The node where the search starts, -1 if there is none.
+ * @param backwards Tells if the edges are followed backwards.
+ * @param dist The array of size orderG(@p graph) in which the distances are written.
+ */
+void breadthFirstSearch(Graph graph, int start, bool backwards, int *dist){
+    int numNodes = orderG(graph);
+    for(int u = 0 ; u < numNodes ; u++){
+        dist[u] = UNREACHABLE;
+    }
+    if(start < 0){
+        return;
+    }
+    int* queue = (int*)malloc(sizeof(int)*numNodes);
+    if(queue == NULL){
+        printf("Not enough memory to allocate queue in breadthFirstSearch\n");
+        exit(EXIT_FAILURE);
+    }
+    int head = 0, tail = 0;
+    dist[start] = 0;
+    queue[tail++] = start;
+    while(head < tail){
+        int u = queue[head++];
+        int numNeighbours = backwards ? getNumPredecessors(graph,u) : getNumSuccessors(graph,u);
+        int *neighbours = backwards ? getPredecessors(graph,u) : getSuccessors(graph,u);
+        for(int e = 0 ; e < numNeighbours ; e++){
+            int v = neighbours[e];
+            if(dist[v] == UNREACHABLE){
+                dist[v] = dist[u]+1;
+                queue[tail++] = v;
+            }
+        }
+    }
+    free(queue);
+}
+
+Distances computeDistances(Graph graph){
+    Distances distances;
+    distances.numNodes = orderG(graph);
+    distances.source = -1;
+    distances.target = -1;
+    for(int u = distances.numNodes-1 ; u >= 0 ; u--){
+        if(isSource(graph,u)) distances.source = u;
+        if(isTarget(graph,u)) distances.target = u;
+    }
+    distances.fromSource = (int*)malloc(sizeof(int)*(distances.numNodes+1));
+    distances.toTarget = (int*)malloc(sizeof(int)*(distances.numNodes+1));
+    if(distances.fromSource == NULL || distances.toTarget == NULL){
+        printf("Not enough memory to allocate distances in computeDistances\n");
+        exit(EXIT_FAILURE);
+    }
+    breadthFirstSearch(graph,distances.source,false,distances.fromSource);
+    breadthFirstSearch(graph,distances.target,true,distances.toTarget);
+    return distances;
+}
+
+void deleteDistances(Distances distances){
+    free(distances.fromSource);
+    free(distances.toTarget);
+}
+
+bool isNodeUseful(Distances distances, int node){
+    return distances.fromSource[node] != UNREACHABLE && distances.toTarget[node] != UNREACHABLE;
+}
+
+bool isNodeFeasible(Distances distances, int node, int position, int pathLength){
+    return position >= 0 && position <= pathLength
+        && distances.fromSource[node] <= position
+        && distances.toTarget[node] <= pathLength-position;
+}
+
+bool *computeWalkLengths(Graph graph, int maxLength){
+    int numNodes = orderG(graph);
+    bool* lengths = (bool*)calloc(maxLength+2,sizeof(bool));
+    if(lengths == NULL){
+        printf("Not enough memory to allocate lengths in computeWalkLengths\n");
+        exit(EXIT_FAILURE);
+    }
+    int source = -1, target = -1;
+    for(int u = numNodes-1 ; u >= 0 ; u--){
+        if(isSource(graph,u)) source = u;
+        if(isTarget(graph,u)) target = u;
+    }
+    if(source < 0 || target < 0 || maxLength < 0){
+        return lengths;
+    }
+    Bitset current = makeBitset(numNodes);
+    Bitset next = makeBitset(numNodes);
+    setBit(current,source);
+    for(int k = 0 ; k <= maxLength ; k++){
+        lengths[k] = testBit(current,target);
+        if(k == maxLength){
+            break;
+        }
+        clearBitset(next);
+        for(int u = nextSetBit(current,0) ; u >= 0 ; u = nextSetBit(current,u+1)){
+            int *successors = getSuccessors(graph,u);
+            for(int e = 0 ; e < getNumSuccessors(graph,u) ; e++){
+                setBit(next,successors[e]);
+            }
+        }
+        if(isBitsetEmpty(next)){
+            break;
+        }
+        copyBitset(current,next);
+    }
+    deleteBitset(current);
+    deleteBitset(next);
+    return lengths;
+}
+
+bool *computeCommonWalkLengths(Graph *graphs, int numGraphs, int maxLength){
+    bool* lengths = computeWalkLengths(graphs[0],maxLength);
+    for(int i = 1 ; i < numGraphs && hasCandidateLength(lengths,maxLength) ; i++){
+        bool* graphLengths = computeWalkLengths(graphs[i],maxLength);
+        for(int k = 0 ; k <= maxLength ; k++){
+            lengths[k] = lengths[k] && graphLengths[k];
+        }
+        free(graphLengths);
+    }
+    return lengths;
+}
+
+bool hasCandidateLength(bool *lengths, int maxLength){
+    for(int k = 0 ; k <= maxLength ; k++){
+        if(lengths[k]){
+            return true;
+        }
+    }
+    return false;
+}
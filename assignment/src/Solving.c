@@ -8,20 +8,20 @@
  * 
  */
 
-#ifndef COCA_SOLVING_H_
-#define COCA_SOLVING_H_
-
+#include "Solving.h"
 #include "Graph.h"
 #include <z3.h>
 #include "Z3Tools.h"
+#include "Cardinality.h"
+#include "Bitset.h"
+#include "DotWriter.h"
+#include "Statistics.h"
+#include "Bounds.h"
+#include "Budget.h"
 #include <stdio.h>
 #include <string.h>
 #include <math.h>
 #include <stdlib.h>
-#include <unistd.h>
-#include <sys/types.h>
-#include <sys/stat.h>
-#include <fcntl.h>
 
 /**
  * @brief Small function to return the maximum between the two parameter
@@ -66,6 +66,297 @@ int getMaxK(Graph * graph, int numGraph){
     return maxK;
 }
 
+/**
+ * @brief The encoding of the at-most-one constraints of ɸ4 and ɸ5 used by the current thread.
+ */
+static __thread AmoEncoding amoEncoding = AMO_SEQUENTIAL;
+
+void setAmoEncoding(AmoEncoding encoding){
+    amoEncoding = encoding;
+}
+
+AmoEncoding getAmoEncoding(void){
+    return amoEncoding;
+}
+
+/**
+ * @brief The way the node at each position of a path is encoded by the formulae built by the current thread.
+ */
+static __thread NodeEncoding nodeEncoding = NODE_ONEHOT;
+
+void setNodeEncoding(NodeEncoding encoding){
+    nodeEncoding = encoding;
+}
+
+NodeEncoding getNodeEncoding(void){
+    return nodeEncoding;
+}
+
+/**
+ * @brief Tells if the formulae built by the current thread skip the pairs (node, position) that no accepting path can use.
+ */
+static __thread bool pruning = true;
+
+void setPruning(bool enabled){
+    pruning = enabled;
+}
+
+bool getPruning(void){
+    return pruning;
+}
+
+bool isNodeAllowed(Distances *distances, int node, int position, int pathLength){
+    return distances == NULL || isNodeFeasible(*distances,node,position,pathLength);
+}
+
+/**
+ * @brief Small function returning the distance from @p node to the target, or 0 if the pruning is disabled.
+ * 
+ * @param distances, The distances of the graph, or NULL if the pruning is disabled.
+ * @param node, The node identifier.
+ * @return The number of positions the path needs after the one of @p node.
+ */
+int getDistanceToTarget(Distances *distances, int node){
+    return distances == NULL ? 0 : distances->toTarget[node];
+}
+
+/**
+ * @brief Computes the distances of each graph of @p graphs when the pruning is enabled.
+ * 
+ * @param graphs, An array of graphs.
+ * @param numGraphs, The number of graphs in @p graphs.
+ * @return An array of @p numGraphs distances to be freed with deleteGraphsDistances, or NULL if the pruning is disabled.
+ */
+Distances *computeGraphsDistances(Graph *graphs, unsigned int numGraphs){
+    if(!pruning){
+        return NULL;
+    }
+    Distances* distances = (Distances*)malloc(sizeof(Distances)*(numGraphs+1));
+    if(distances == NULL){
+        printf("Not enough memory to allocate distances in computeGraphsDistances\n");
+        exit(EXIT_FAILURE);
+    }
+    for(unsigned int i = 0 ; i < numGraphs ; i++){
+        distances[i] = computeDistances(graphs[i]);
+    }
+    return distances;
+}
+
+/**
+ * @brief Frees the distances given by computeGraphsDistances.
+ * 
+ * @param distances, The distances, or NULL.
+ * @param numGraphs, The number of graphs.
+ */
+void deleteGraphsDistances(Distances *distances, unsigned int numGraphs){
+    if(distances == NULL){
+        return;
+    }
+    for(unsigned int i = 0 ; i < numGraphs ; i++){
+        deleteDistances(distances[i]);
+    }
+    free(distances);
+}
+
+/**
+ * @brief The table of the node variables of a set of graphs. The variables of graph i for length k (or ANY_LENGTH) are created on first use in a dense
+ *        block indexed by position*order+node, alongside their negations, so each variable is only named and declared once. The bits of the binary
+ *        encoding are kept the same way, in blocks indexed by position*numBits+bit.
+ */
+typedef struct {
+    Z3_context ctx;     ///< The context the variables belong to.
+    Z3_sort boolSort;   ///< The sort shared by all variables.
+    int numGraphs;      ///< The number of graphs.
+    int maxK;           ///< The largest length having a block.
+    int *orders;        ///< The number of nodes of each graph.
+    Z3_ast **vars;      ///< The blocks of variables, vars[number*(maxK+2)+k], the block of ANY_LENGTH being the last one of each graph.
+    Z3_ast **negVars;   ///< The blocks of negated variables, same layout as vars.
+    Z3_ast **bits;      ///< The blocks of the bits of the binary encoding, same layout as vars.
+    Z3_ast **negBits;   ///< The blocks of negated bits, same layout as vars.
+    Z3_ast *selectors;  ///< The selector of each length up to maxK, created on first use by getLengthSelector.
+    int numLengthBits;  ///< The number of bits of the register of the selected length, enough for maxK.
+    Z3_ast *lengthBits; ///< The bits of the register of the selected length, created on first use by getLengthBit.
+    Graph *graphs;      ///< The graphs of the table.
+    Distances *distances;   ///< The distances of the graphs with the pruning, computed on first use by getGraphsDistances, or NULL.
+} NodeVariables;
+
+/**
+ * @brief The table used by the current thread, NULL if there is none.
+ */
+static __thread NodeVariables *nodeVariables = NULL;
+
+void deleteNodeVariables(void){
+    NodeVariables *table = nodeVariables;
+    if(table == NULL){
+        return;
+    }
+    for(int b = 0 ; b < table->numGraphs*(table->maxK+2) ; b++){
+        free(table->vars[b]);
+        free(table->negVars[b]);
+        free(table->bits[b]);
+        free(table->negBits[b]);
+    }
+    free(table->vars);
+    free(table->negVars);
+    free(table->bits);
+    free(table->negBits);
+    free(table->selectors);
+    free(table->lengthBits);
+    free(table->orders);
+    deleteGraphsDistances(table->distances,table->numGraphs);
+    free(table);
+    nodeVariables = NULL;
+}
+
+void initNodeVariables(Z3_context ctx, Graph *graphs, unsigned int numGraphs){
+    deleteNodeVariables();
+    NodeVariables *table = (NodeVariables*)malloc(sizeof(NodeVariables));
+    if(table == NULL){
+        printf("Not enough memory to allocate the table in initNodeVariables\n");
+        exit(EXIT_FAILURE);
+    }
+    table->ctx = ctx;
+    table->boolSort = Z3_mk_bool_sort(ctx);
+    table->numGraphs = numGraphs;
+    table->graphs = graphs;
+    table->distances = NULL;
+    table->maxK = getMaxK(graphs,numGraphs);
+    table->orders = (int*)malloc(sizeof(int)*numGraphs);
+    table->vars = (Z3_ast**)calloc(numGraphs*(table->maxK+2),sizeof(Z3_ast*));
+    table->negVars = (Z3_ast**)calloc(numGraphs*(table->maxK+2),sizeof(Z3_ast*));
+    table->bits = (Z3_ast**)calloc(numGraphs*(table->maxK+2),sizeof(Z3_ast*));
+    table->negBits = (Z3_ast**)calloc(numGraphs*(table->maxK+2),sizeof(Z3_ast*));
+    table->selectors = (Z3_ast*)calloc(table->maxK+1,sizeof(Z3_ast));
+    table->numLengthBits = 1;
+    while((1 << table->numLengthBits) <= table->maxK){
+        table->numLengthBits++;
+    }
+    table->lengthBits = (Z3_ast*)calloc(table->numLengthBits,sizeof(Z3_ast));
+    if(table->orders == NULL || table->vars == NULL || table->negVars == NULL || table->bits == NULL || table->negBits == NULL
+       || table->selectors == NULL || table->lengthBits == NULL){
+        printf("Not enough memory to allocate the blocks in initNodeVariables\n");
+        exit(EXIT_FAILURE);
+    }
+    for(unsigned int i = 0 ; i < numGraphs ; i++){
+        table->orders[i] = orderG(graphs[i]);
+    }
+    nodeVariables = table;
+}
+
+/**
+ * @brief Small function giving the distances of computeGraphsDistances, kept in the table of the current thread when it covers @p graphs so that the
+ *        breadth first searches are run once per query instead of once per formula.
+ * 
+ * @param ctx, The solver context.
+ * @param graphs, An array of graphs.
+ * @param numGraphs, The number of graphs in @p graphs.
+ * @return Distances*, The distances, or NULL if the pruning is disabled. To be given back to releaseGraphsDistances.
+ */
+static Distances *getGraphsDistances(Z3_context ctx, Graph *graphs, unsigned int numGraphs){
+    NodeVariables *table = nodeVariables;
+    if(!pruning || table == NULL || table->ctx != ctx || table->graphs != graphs || table->numGraphs != (int)numGraphs){
+        return computeGraphsDistances(graphs,numGraphs);
+    }
+    if(table->distances == NULL){
+        table->distances = computeGraphsDistances(graphs,numGraphs);
+    }
+    return table->distances;
+}
+
+/**
+ * @brief Small function freeing the distances given by getGraphsDistances, unless they are kept in the table of the current thread.
+ * 
+ * @param distances, The distances, or NULL.
+ * @param numGraphs, The number of graphs.
+ */
+static void releaseGraphsDistances(Distances *distances, unsigned int numGraphs){
+    if(nodeVariables == NULL || distances != nodeVariables->distances){
+        deleteGraphsDistances(distances,numGraphs);
+    }
+}
+
+/**
+ * @brief Creates the variable X_i,j,k,q (or X_i,j,q if @p k is ANY_LENGTH) by its name.
+ * 
+ * @param ctx, The solver context.
+ * @param sort, The boolean sort.
+ * @param number, The number of the graph.
+ * @param position, The position in the path.
+ * @param k, The length of the path.
+ * @param node, The node identifier.
+ * @return Z3_ast, The variable.
+ */
+static Z3_ast makeNodeVariable(Z3_context ctx, Z3_sort sort, int number, int position, int k, int node){
+    char str[64];
+    if(k == ANY_LENGTH){
+        sprintf(str, "X_%d,%d,%d", (number+1), position, node); // His name will be X_i,j,q, shared by all lengths
+    }else{
+        sprintf(str, "X_%d,%d,%d,%d", (number+1), position, k, node);
+    }
+    return Z3_mk_const(ctx, Z3_mk_string_symbol(ctx, str), sort); // His name will be X_i,j,k,q ( i = number, j = position, k = k, q = node )
+}
+
+/**
+ * @brief Returns the slot at @p position and @p offset of the block of graph number @p number for length @p k in @p blocks, a layout of the table of
+ *        the current thread, allocating the block if needed.
+ * 
+ * @param blocks, The blocks of the table.
+ * @param number, The number of the graph.
+ * @param position, The position in the path.
+ * @param k, The length of the path.
+ * @param width, The number of slots of a position.
+ * @param offset, The slot at this position, below @p width.
+ * @return Z3_ast*, The slot.
+ */
+static Z3_ast *getBlockSlot(Z3_ast **blocks, int number, int position, int k, int width, int offset){
+    NodeVariables *table = nodeVariables;
+    int index = number*(table->maxK+2)+(k == ANY_LENGTH ? table->maxK+1 : k);
+    Z3_ast *block = blocks[index];
+    if(block == NULL){
+        int numPositions = k == ANY_LENGTH ? table->maxK+1 : k+1;
+        block = (Z3_ast*)calloc(numPositions*width,sizeof(Z3_ast));
+        if(block == NULL){
+            printf("Not enough memory to allocate a block in getBlockSlot\n");
+            exit(EXIT_FAILURE);
+        }
+        blocks[index] = block;
+    }
+    return &block[position*width+offset];
+}
+
+/**
+ * @brief Small function telling if the table of the current thread covers the variables of graph number @p number at @p position for length @p k.
+ * 
+ * @param ctx, The solver context.
+ * @param number, The number of the graph.
+ * @param position, The position in the path.
+ * @param k, The length of the path.
+ * @return true iff the table belongs to @p ctx and has a block for these variables.
+ */
+static bool isCoveredByTable(Z3_context ctx, int number, int position, int k){
+    NodeVariables *table = nodeVariables;
+    return table != NULL && table->ctx == ctx && number >= 0 && number < table->numGraphs && k >= ANY_LENGTH && k <= table->maxK
+           && position >= 0 && position <= (k == ANY_LENGTH ? table->maxK : k);
+}
+
+/**
+ * @brief Returns the slot of the variable in the table of the current thread, allocating its block if needed.
+ * 
+ * @param ctx, The solver context.
+ * @param number, The number of the graph.
+ * @param position, The position in the path.
+ * @param k, The length of the path.
+ * @param node, The node identifier.
+ * @param negated, Tells if the slot of the negation is wanted.
+ * @return Z3_ast*, The slot, or NULL if the variable is not covered by the table.
+ */
+static Z3_ast *getNodeVariableSlot(Z3_context ctx, int number, int position, int k, int node, bool negated){
+    if(!isCoveredByTable(ctx,number,position,k) || node < 0 || node >= nodeVariables->orders[number]){
+        return NULL;
+    }
+    return getBlockSlot(negated ? nodeVariables->negVars : nodeVariables->vars, number, position, k, nodeVariables->orders[number], node);
+}
+
 /**
  * @brief Generates a formula consisting of a variable representing the fact that @p node of graph number @p number is at position @p position of an accepting path.
  * Génère une formule consistant en une variable représentant le fait que node du graphe number soit à la position position d'un chemin acceptant.
@@ -78,15 +369,25 @@ int getMaxK(Graph * graph, int numGraph){
  * @return Z3_ast, The formula.
  */
 Z3_ast getNodeVariable(Z3_context ctx, int number, int position, int k, int node){
-    char* str = (char*)malloc(sizeof(char)*(int)ceil(10+log10(max(number,1))+log10(max(position,1))+log10(max(k,1))+log10(max(node,1))));
-    if(str == NULL){
-        printf("Not enough memory to allocate str in getNodeVariable\n");
-        exit(EXIT_FAILURE);
+    Z3_ast *slot = getNodeVariableSlot(ctx, number, position, k, node, false);
+    if(slot == NULL){
+        return makeNodeVariable(ctx, Z3_mk_bool_sort(ctx), number, position, k, node);
+    }
+    if(*slot == NULL){
+        *slot = makeNodeVariable(ctx, nodeVariables->boolSort, number, position, k, node);
+    }
+    return *slot;
+}
+
+Z3_ast getNegNodeVariable(Z3_context ctx, int number, int position, int k, int node){
+    Z3_ast *slot = getNodeVariableSlot(ctx, number, position, k, node, true);
+    if(slot == NULL){
+        return Z3_mk_not(ctx, getNodeVariable(ctx, number, position, k, node));
+    }
+    if(*slot == NULL){
+        *slot = Z3_mk_not(ctx, getNodeVariable(ctx, number, position, k, node));
     }
-    sprintf(str, "X_%d,%d,%d,%d", (number+1), position, k, node);
-    Z3_ast x = mk_bool_var(ctx, str);
-    free(str);
-    return x; // His name will be X_i,j,k,q ( i = number, j = position, k = k, q = node )
+    return *slot;
 }
 
 
@@ -97,14 +398,19 @@ Z3_ast getNodeVariable(Z3_context ctx, int number, int position, int k, int node
  * @param graphs, An array of graphs.
  * @param i, The number of graphs in @p graphs.
  * @param pathLength, The length of the path to check.
+ * @param distances, The distances of the graph, or NULL if the pruning is disabled.
  * @return Z3_ast, The formula.
  */
-Z3_ast graphToPhi1Formula(Z3_context ctx, Graph *graphs, unsigned int i, int pathLength){
+Z3_ast graphToPhi1Formula(Z3_context ctx, Graph *graphs, unsigned int i, int pathLength, Distances *distances){
     for(int j = 0; j < orderG(graphs[i]); j++){
         if(isSource(graphs[i],j)){
+            if(!isNodeAllowed(distances,j,0,pathLength)){
+                return Z3_mk_false(ctx);
+            }
             return getNodeVariable(ctx,i,0,pathLength,j);
         }
     }
+    return Z3_mk_false(ctx);
 }
 
 /**
@@ -114,34 +420,43 @@ Z3_ast graphToPhi1Formula(Z3_context ctx, Graph *graphs, unsigned int i, int pat
  * @param graphs, An array of graphs.
  * @param i, The number of graphs in @p graphs.
  * @param pathLength, The length of the path to check.
+ * @param distances, The distances of the graph, or NULL if the pruning is disabled.
  * @return Z3_ast, The formula.
  */
-Z3_ast graphToPhi2Formula(Z3_context ctx, Graph *graphs, unsigned int i, int pathLength){
+Z3_ast graphToPhi2Formula(Z3_context ctx, Graph *graphs, unsigned int i, int pathLength, Distances *distances){
     for(int j = 0; j < orderG(graphs[i]); j++){
         //printf("j = %d\n",j);
         if(isTarget(graphs[i],j)){
+            if(!isNodeAllowed(distances,j,pathLength,pathLength)){
+                return Z3_mk_false(ctx);
+            }
             return getNodeVariable(ctx,i,pathLength,pathLength,j);
         }
     }
+    return Z3_mk_false(ctx);
 }
 
 /**
- * @brief A function used to build our ɸ3 formula
+ * @brief A function used to build our ɸ3 formula. Only the nodes allowed at a position are candidates for it.
  * 
  * @param ctx, The solver context.
  * @param graphs, An array of graphs.
  * @param i, The number of graphs in @p graphs.
  * @param pathLength, The length of the path to check.
+ * @param distances, The distances of the graph, or NULL if the pruning is disabled.
  * @return Z3_ast, The formula.
  */
-Z3_ast graphToPhi3Formula(Z3_context ctx, Graph *graphs, unsigned int i, int pathLength){
+Z3_ast graphToPhi3Formula(Z3_context ctx, Graph *graphs, unsigned int i, int pathLength, Distances *distances){
     Z3_ast formulaAND[pathLength+1]; 
     for(int j = 0 ; j <= pathLength ; j++ ){
-        Z3_ast formulaOR[orderG(graphs[i])];
+        Z3_ast formulaOR[orderG(graphs[i])+1];
+        int ind = 0;
         for(int u = 0 ; u < orderG(graphs[i]) ; u++ ){
-            formulaOR[u] = getNodeVariable(ctx,i,j,pathLength,u);
+            if(isNodeAllowed(distances,u,j,pathLength)){
+                formulaOR[ind++] = getNodeVariable(ctx,i,j,pathLength,u);
+            }
         }
-        formulaAND[j] = Z3_mk_or(ctx,orderG(graphs[i]),formulaOR);
+        formulaAND[j] = Z3_mk_or(ctx,ind,formulaOR);
     }
     return Z3_mk_and(ctx,pathLength+1,formulaAND);
 }
@@ -153,111 +468,99 @@ Z3_ast graphToPhi3Formula(Z3_context ctx, Graph *graphs, unsigned int i, int pat
  * @param graphs, An array of graphs.
  * @param i, The number of graphs in @p graphs.
  * @param pathLength, The length of the path to check.
+ * @param distances, The distances of the graph, or NULL if the pruning is disabled.
  * @return Z3_ast, The formula.
  */
-Z3_ast graphToPhi4Formula(Z3_context ctx, Graph *graphs, unsigned int i, int pathLength){
-    Z3_ast* formulaAND1 = (Z3_ast*)malloc(sizeof(Z3_ast)*pathLength+1);
-    if(formulaAND1 == NULL){
-        printf("Not enough memory to allocate formulaAND1 in Phi4\n");
+Z3_ast graphToPhi4Formula(Z3_context ctx, Graph *graphs, unsigned int i, int pathLength, Distances *distances){
+    int numNodes = orderG(graphs[i]);
+    Z3_ast* formulaAND = (Z3_ast*)malloc(sizeof(Z3_ast)*(pathLength+1));
+    Z3_ast* literals = (Z3_ast*)malloc(sizeof(Z3_ast)*(numNodes+1));
+    Z3_ast* negLiterals = (Z3_ast*)malloc(sizeof(Z3_ast)*(numNodes+1));
+    if(formulaAND == NULL || literals == NULL || negLiterals == NULL){
+        printf("Not enough memory to allocate formulaAND in Phi4\n");
         exit(EXIT_FAILURE);
     }
     for(int j = 0 ; j <= pathLength ; j++){
-        Z3_ast* formulaAND2 = (Z3_ast*)malloc(sizeof(Z3_ast)*orderG(graphs[i]));
-        if(formulaAND2 == NULL){
-            printf("Not enough memory to allocate formulaAND2 in Phi4\n");
-            exit(EXIT_FAILURE);
-        }
-        for(int u = 0 ; u < orderG(graphs[i]) ; u++){
-            Z3_ast* formulaAND3 = (Z3_ast*)malloc(sizeof(Z3_ast)*(orderG(graphs[i])-1));
-            if(formulaAND3 == NULL){
-                printf("Not enough memory to allocate formulaAND3 in Phi4\n");
-                exit(EXIT_FAILURE);
-            }
-            int AND3index = 0;
-            Z3_ast* formulaOR = (Z3_ast*)malloc(sizeof(Z3_ast)*2);
-            if(formulaOR == NULL){
-                printf("Not enough memory to allocate formulaOR in Phi4\n");
-                exit(EXIT_FAILURE);
-            }
-            for(int v = 0 ; v < orderG(graphs[i]) ; v++){
-                if(v!=u){
-                    formulaOR[0] = Z3_mk_not(ctx,getNodeVariable(ctx,i,j,pathLength,u));
-                    formulaOR[1] = Z3_mk_not(ctx,getNodeVariable(ctx,i,j,pathLength,v));
-                    formulaAND3[AND3index++] = Z3_mk_or(ctx,2,formulaOR);
-                }
+        int ind = 0;
+        for(int u = 0 ; u < numNodes ; u++){
+            if(isNodeAllowed(distances,u,j,pathLength)){
+                literals[ind] = getNodeVariable(ctx,i,j,pathLength,u);
+                negLiterals[ind++] = getNegNodeVariable(ctx,i,j,pathLength,u);
             }
-            free(formulaOR);
-            formulaAND2[u] = Z3_mk_and(ctx,AND3index/*orderG(graphs[i])-1*/,formulaAND3);
-            free(formulaAND3);
         }
-        formulaAND1[j] = Z3_mk_and(ctx,orderG(graphs[i]),formulaAND2);
-        free(formulaAND2);
+        formulaAND[j] = atMostOne(ctx,literals,negLiterals,ind,amoEncoding);
     }
-    Z3_ast finalAND = Z3_mk_and(ctx,pathLength+1,formulaAND1);
-    free(formulaAND1);
+    Z3_ast finalAND = Z3_mk_and(ctx,pathLength+1,formulaAND);
+    free(formulaAND);
+    free(literals);
+    free(negLiterals);
     return finalAND;
 }
 
 /**
- * @brief A function used to build our ɸ5 formula
+ * @brief A function used to build our ɸ5 formula. The nodes lying on no path from the source to the target are skipped.
  * 
  * @param ctx, The solver context.
  * @param graphs, An array of graphs.
  * @param i, The number of graphs in @p graphs.
  * @param pathLength, The length of the path to check.
+ * @param distances, The distances of the graph, or NULL if the pruning is disabled.
  * @return Z3_ast, The formula.
  */
-Z3_ast graphToPhi5Formula(Z3_context ctx, Graph *graphs, unsigned int i, int pathLength){
-    Z3_ast formulaAND1[orderG(graphs[i])];
-    Z3_ast* formulaAND2 = (Z3_ast*)malloc(sizeof(Z3_ast)*pathLength+1);
-    if(formulaAND2 == NULL){
-        printf("Not enough memory to allocate formulaAND2 in Phi5\n");
+Z3_ast graphToPhi5Formula(Z3_context ctx, Graph *graphs, unsigned int i, int pathLength, Distances *distances){
+    int numNodes = orderG(graphs[i]);
+    Z3_ast* formulaAND = (Z3_ast*)malloc(sizeof(Z3_ast)*(numNodes+1));
+    Z3_ast* literals = (Z3_ast*)malloc(sizeof(Z3_ast)*(pathLength+1));
+    Z3_ast* negLiterals = (Z3_ast*)malloc(sizeof(Z3_ast)*(pathLength+1));
+    if(formulaAND == NULL || literals == NULL || negLiterals == NULL){
+        printf("Not enough memory to allocate formulaAND in Phi5\n");
         exit(EXIT_FAILURE);
     }
-    for(int u = 0 ; u < orderG(graphs[i]) ; u++ ){
-        Z3_ast* formulaAND3 = (Z3_ast*)malloc(sizeof(Z3_ast)*pathLength);
-        if(formulaAND3 == NULL){
-            printf("Not enough memory to allocate formulaAND3 in Phi5\n");
-            exit(EXIT_FAILURE);
+    int id = 0;
+    for(int u = 0 ; u < numNodes ; u++ ){
+        if(distances != NULL && !isNodeUseful(*distances,u)){
+            continue;
         }
+        int ind = 0;
         for(int j = 0 ; j <= pathLength ; j++){
-            int id = 0;
-            for(int j2 = 0 ; j2 <= pathLength ; j2++ ){
-                Z3_ast formulaOR[2];
-                if(j2!=j){
-                    formulaOR[0] = Z3_mk_not(ctx,getNodeVariable(ctx,i,j,pathLength,u));
-                    formulaOR[1] = Z3_mk_not(ctx,getNodeVariable(ctx,i,j2,pathLength,u));
-                    formulaAND3[id] = Z3_mk_or(ctx,2,formulaOR);
-                    id++;
-                }
+            if(isNodeAllowed(distances,u,j,pathLength)){
+                literals[ind] = getNodeVariable(ctx,i,j,pathLength,u);
+                negLiterals[ind++] = getNegNodeVariable(ctx,i,j,pathLength,u);
             }
-            formulaAND2[j] = Z3_mk_and(ctx,id/*pathLength*/,formulaAND3);
         }
-        formulaAND1[u] = Z3_mk_and(ctx,pathLength+1,formulaAND2);
-        free(formulaAND3);
+        formulaAND[id++] = atMostOne(ctx,literals,negLiterals,ind,amoEncoding);
     }
-    free(formulaAND2);
-    return Z3_mk_and(ctx,orderG(graphs[i]),formulaAND1);;
+    Z3_ast finalAND = Z3_mk_and(ctx,id,formulaAND);
+    free(formulaAND);
+    free(literals);
+    free(negLiterals);
+    return finalAND;
 }
 
 /**
- * @brief A function used to build our ɸ6 formula
+ * @brief A function used to build our ɸ6 formula. Only the edges between nodes allowed at consecutive positions are kept.
  * 
  * @param ctx, The solver context.
  * @param graphs, An array of graphs.
  * @param i, The number of graphs in @p graphs.
  * @param pathLength, The length of the path to check.
+ * @param distances, The distances of the graph, or NULL if the pruning is disabled.
  * @return Z3_ast, The formula.
  */
-Z3_ast graphToPhi6Formula(Z3_context ctx, Graph *graphs, unsigned int i, int pathLength){
-    Z3_ast formulaAND[pathLength];
+Z3_ast graphToPhi6Formula(Z3_context ctx, Graph *graphs, unsigned int i, int pathLength, Distances *distances){
+    Z3_ast formulaAND[pathLength+1];
     for(int j = 0 ; j <= pathLength - 1; j++ ){
         int ind = 0;
-        Z3_ast formulaOR[sizeG(graphs[i])];
+        Z3_ast formulaOR[sizeG(graphs[i])+1];
         Z3_ast formulaLittleAND[2];
         for(int u = 0 ; u < orderG(graphs[i]) ; u++ ){
-            for(int v = 0 ; v < orderG(graphs[i]) ; v++ ){
-                if(isEdge(graphs[i],u,v)){
+            if(!isNodeAllowed(distances,u,j,pathLength)){
+                continue;
+            }
+            int *successors = getSuccessors(graphs[i],u);
+            for(int e = 0 ; e < getNumSuccessors(graphs[i],u) ; e++ ){
+                int v = successors[e];
+                if(isNodeAllowed(distances,v,j+1,pathLength)){
                     formulaLittleAND[0] = getNodeVariable(ctx,i,j,pathLength,u);
                     formulaLittleAND[1] = getNodeVariable(ctx,i,j+1,pathLength,v);
                     formulaOR[ind] = Z3_mk_and(ctx,2,formulaLittleAND);
@@ -271,276 +574,1295 @@ Z3_ast graphToPhi6Formula(Z3_context ctx, Graph *graphs, unsigned int i, int pat
 }
 
 /**
- * @brief Small function returning a different value depending on the returned value of isFormulaSat
+ * @brief Small function returning the number of bits needed to write the identifier of a node of a graph of @p numNodes nodes.
  * 
- * @param val, A Z3_bool returned by isFormulaSat
- * @return An integer ( -1 if the formula wasn't SAT, 0 if it was not determined & 1 if it is SAT )
+ * @param numNodes, The number of nodes.
+ * @return The smallest b such that numNodes <= 2^b.
  */
-int isSatisfiable(Z3_lbool val){
-    switch (val)
-        {
-        case Z3_L_FALSE:
-            return -1;
+int getNumNodeBits(int numNodes){
+    int numBits = 0;
+    while((1 << numBits) < numNodes){
+        numBits++;
+    }
+    return numBits;
+}
 
-        case Z3_L_UNDEF:
-            return 0;
+/**
+ * @brief Returns the slot of the bit variable in the table of the current thread, allocating its block if needed.
+ * 
+ * @param ctx, The solver context.
+ * @param number, The number of the graph.
+ * @param position, The position in the path.
+ * @param k, The length of the path, or ANY_LENGTH.
+ * @param bit, The number of the bit.
+ * @param negated, Tells if the slot of the negation is wanted.
+ * @return Z3_ast*, The slot, or NULL if the bit is not covered by the table.
+ */
+static Z3_ast *getNodeBitSlot(Z3_context ctx, int number, int position, int k, int bit, bool negated){
+    if(!isCoveredByTable(ctx,number,position,k)){
+        return NULL;
+    }
+    int numBits = getNumNodeBits(nodeVariables->orders[number]);
+    if(bit < 0 || bit >= numBits){
+        return NULL;
+    }
+    return getBlockSlot(negated ? nodeVariables->negBits : nodeVariables->bits, number, position, k, numBits, bit);
+}
 
-        case Z3_L_TRUE:
-            return 1;
-        }
+/**
+ * @brief Creates the bit variable B_i,j,k,b (or B_i,j,b if @p k is ANY_LENGTH) by its name.
+ * 
+ * @param ctx, The solver context.
+ * @param sort, The boolean sort.
+ * @param number, The number of the graph.
+ * @param position, The position in the path.
+ * @param k, The length of the path.
+ * @param bit, The number of the bit.
+ * @return Z3_ast, The variable.
+ */
+static Z3_ast makeNodeBitVariable(Z3_context ctx, Z3_sort sort, int number, int position, int k, int bit){
+    char str[64];
+    if(k == ANY_LENGTH){
+        sprintf(str, "B_%d,%d,%d", (number+1), position, bit); // His name will be B_i,j,b, shared by all lengths
+    }else{
+        sprintf(str, "B_%d,%d,%d,%d", (number+1), position, k, bit);
+    }
+    return Z3_mk_const(ctx, Z3_mk_string_symbol(ctx, str), sort); // His name will be B_i,j,k,b ( i = number, j = position, k = k, b = bit )
 }
 
 /**
- * @brief Generates a SAT formula satisfiable if and only if all graphs of @p graphs contain an accepting path of length @p pathLength.
+ * @brief Generates a formula consisting of a variable representing the bit number @p bit of the node at position @p position of an accepting path of
+ *        length @p k in graph number @p number, in the binary encoding.
  * 
  * @param ctx, The solver context.
- * @param graphs, An array of graphs.
- * @param numGraphs, The number of graphs in @p graphs.
- * @param pathLength, The length of the path to check.
+ * @param number, The number of the graph.
+ * @param position, The position in the path.
+ * @param k, The length of the path, or ANY_LENGTH for the variables shared by all lengths.
+ * @param bit, The number of the bit, 0 being the least significant.
  * @return Z3_ast, The formula.
  */
-Z3_ast graphsToPathFormula(Z3_context ctx, Graph *graphs, unsigned int numGraphs, int pathLength){
-    Z3_ast* formulaAND = (Z3_ast*)malloc(sizeof(Z3_ast)*pathLength);
-    if(formulaAND == NULL){
-        printf("Not enough memory to allocate formulaLittleAND in graphsToPathFormula\n");
-        exit(EXIT_FAILURE);
-    }
-    Z3_ast* formulaLittleAND = (Z3_ast*)malloc(sizeof(Z3_ast)*6); // 6 = number of formula
-    if(formulaLittleAND == NULL){
-        printf("Not enough memory to allocate formulaLittleAND in graphsToPathFormula\n");
-        exit(EXIT_FAILURE);
+Z3_ast getNodeBitVariable(Z3_context ctx, int number, int position, int k, int bit){
+    Z3_ast *slot = getNodeBitSlot(ctx, number, position, k, bit, false);
+    if(slot == NULL){
+        return makeNodeBitVariable(ctx, Z3_mk_bool_sort(ctx), number, position, k, bit);
     }
-    for(int i = 0 ; i < numGraphs ; i++){
-        formulaLittleAND[0] = graphToPhi1Formula(ctx, graphs, i, pathLength);
-        formulaLittleAND[1] = graphToPhi2Formula(ctx, graphs, i, pathLength);
-        formulaLittleAND[2] = graphToPhi3Formula(ctx, graphs, i, pathLength);
-        formulaLittleAND[3] = graphToPhi4Formula(ctx, graphs, i, pathLength);
-        formulaLittleAND[4] = graphToPhi5Formula(ctx, graphs, i, pathLength);
-        formulaLittleAND[5] = graphToPhi6Formula(ctx, graphs, i, pathLength);
-        formulaAND[i] = Z3_mk_and(ctx,6,formulaLittleAND);
+    if(*slot == NULL){
+        *slot = makeNodeBitVariable(ctx, nodeVariables->boolSort, number, position, k, bit);
     }
-    
-    Z3_ast x = Z3_mk_and(ctx,numGraphs,formulaAND);
-    free(formulaLittleAND);
-    free(formulaAND);
-    return x;
+    return *slot;
 }
 
+/**
+ * @brief Generates the negation of getNodeBitVariable, built once per bit when the table of the current thread covers it.
+ * 
+ * @param ctx, The solver context.
+ * @param number, The number of the graph.
+ * @param position, The position in the path.
+ * @param k, The length of the path, or ANY_LENGTH for the variables shared by all lengths.
+ * @param bit, The number of the bit, 0 being the least significant.
+ * @return Z3_ast, The formula.
+ */
+static Z3_ast getNegNodeBitVariable(Z3_context ctx, int number, int position, int k, int bit){
+    Z3_ast *slot = getNodeBitSlot(ctx, number, position, k, bit, true);
+    if(slot == NULL){
+        return Z3_mk_not(ctx, getNodeBitVariable(ctx, number, position, k, bit));
+    }
+    if(*slot == NULL){
+        *slot = Z3_mk_not(ctx, getNodeBitVariable(ctx, number, position, k, bit));
+    }
+    return *slot;
+}
 
 /**
- * @brief Gets the length of the solution from a given model.
+ * @brief A function building the literals of the bits of @p node at position @p position: the formula stating that @p node is at this position is
+ *        their conjunction, and its negation is the disjunction of their negations.
  * 
- * @param ctx, The solver context. 
- * @param model, A variable assignment. 
- * @param graphs, An array of graphs.
- * @return int, The length of a common simple accepting path in all graphs from @p graphs
- */ 
-int getSolutionLengthFromModel(Z3_context ctx, Z3_model model, Graph *graphs){
-    int maxLength = orderG(graphs[0]);
-    for(int k = 1 ; k < maxLength+1 ; k++ ){
-        int numK = 0;
-        for(int j = 0 ; j < k+1 ; j++ ){
-            int numVal = 0;
-            for(int u = 0 ; u < maxLength ; u++ ){
-                if(valueOfVarInModel(ctx, model, getNodeVariable(ctx,0,j,k,u))){
-                    if(j==0){
-                        if( isSource(graphs[0],u)){
-                            numVal++;
-                        }else{
-                            // Falsification of the values if a node which isn't the starting point is proposed for the step 0. 
-                            numVal++;
-                            numVal++;
-                        }
-                    }else{
-                        if(j==k){
-                            if(isTarget(graphs[0],u)){
-                                numVal++;
-                            }else{
-                                // Falsification of the values if a node which isn't the ending point is proposed for the step k. 
-                                numVal++;
-                                numVal++;
-                            }
-                        }else{
-                            numVal++;
-                        }
-                    }
-                }
-            }
-            if(numVal == 1){
-                numK++;
-            }
-        }
-        if(numK-1 == k){
-            return k;
+ * @param ctx, The solver context.
+ * @param i, The number of the graph.
+ * @param position, The position in the path.
+ * @param pathLength, The length of the path.
+ * @param numBits, The number of bits of a node.
+ * @param node, The node identifier.
+ * @param negated, Tells if the negated literals are wanted.
+ * @param literals, The array of size @p numBits in which the literals are written.
+ */
+void getBinaryNodeLiterals(Z3_context ctx, unsigned int i, int position, int pathLength, int numBits, int node, bool negated, Z3_ast *literals){
+    for(int b = 0 ; b < numBits ; b++){
+        if(((node >> b) & 1) != negated){
+            literals[b] = getNodeBitVariable(ctx,i,position,pathLength,b);
+        }else{
+            literals[b] = getNegNodeBitVariable(ctx,i,position,pathLength,b);
         }
     }
 }
 
-
 /**
- * @brief Generates a SAT formula satisfiable if and only if all graphs of @p graphs contain an accepting path of common length.
- * Génère une formule SAT satisfaisable si et seulement si tous les graphes de graphs contiennent un chemin acceptant de longueur commune.
+ * @brief A function building the formula stating that @p node is at position @p position, in the binary encoding.
  * 
  * @param ctx, The solver context.
- * @param graphs, An array of graphs.
- * @param numGraphs, The number of graphs in @p graphs. 
+ * @param i, The number of the graph.
+ * @param position, The position in the path.
+ * @param pathLength, The length of the path.
+ * @param numBits, The number of bits of a node.
+ * @param node, The node identifier.
  * @return Z3_ast, The formula.
  */
-Z3_ast graphsToFullFormula(Z3_context ctx, Graph *graphs, unsigned int numGraphs){
-    int commonLength = getMaxK(graphs,numGraphs);
-    int index = 0;
-    Z3_ast formulaOR[commonLength];
-    for(int l = 1; l < commonLength; l++){
-        Z3_ast formulaToTest = graphsToPathFormula(ctx, graphs, numGraphs, l);
-        if(isSatisfiable(isFormulaSat(ctx,formulaToTest)) == 1){
-            formulaOR[index] = formulaToTest;
-            index++;
-        } 
-    }
-    Z3_ast x = Z3_mk_or(ctx,index,formulaOR);
-    return x;
+Z3_ast binaryNodeAt(Z3_context ctx, unsigned int i, int position, int pathLength, int numBits, int node){
+    Z3_ast literals[numBits+1];
+    getBinaryNodeLiterals(ctx,i,position,pathLength,numBits,node,false,literals);
+    return Z3_mk_and(ctx,numBits,literals);
 }
 
-
-
-
 /**
- * @brief Small function printing the path for a graph
+ * @brief A function used to build our ɸ1 formula in the binary encoding: the path starts at the source.
  * 
  * @param ctx, The solver context.
- * @param model, A variable assignment.
- * @param graph, A graph. 
- * @param graphIndex,  The index of the graph in the array.
- * @param pathLength, The length of path. 
+ * @param graphs, An array of graphs.
+ * @param i, The number of graphs in @p graphs.
+ * @param pathLength, The length of the path to check.
+ * @param distances, The distances of the graph, or NULL if the pruning is disabled.
+ * @return Z3_ast, The formula.
  */
-void oneGraphPrintPathsFromModel(Z3_context ctx, Z3_model model, Graph graph, int graphIndex, int pathLength){
-    int tab[pathLength+1];
-    for(int j = 0 ; j <= pathLength ; j++){
-        for(int u = 0 ; u < orderG(graph) ; u++){
-            if(valueOfVarInModel(ctx, model, getNodeVariable(ctx,graphIndex,j,pathLength,u))){
-                tab[j] = u;
+Z3_ast graphToBinaryPhi1Formula(Z3_context ctx, Graph *graphs, unsigned int i, int pathLength, Distances *distances){
+    for(int u = 0; u < orderG(graphs[i]); u++){
+        if(isSource(graphs[i],u)){
+            if(!isNodeAllowed(distances,u,0,pathLength)){
+                return Z3_mk_false(ctx);
             }
+            return binaryNodeAt(ctx,i,0,pathLength,getNumNodeBits(orderG(graphs[i])),u);
         }
     }
-    for(int k = 0 ; k < pathLength ; k++){
-        printf("%s -> ",getNodeName(graph,tab[k]));
-    }
-    printf("%s;\n",getNodeName(graph,tab[pathLength]));
+    return Z3_mk_false(ctx);
 }
 
 /**
- * @brief Displays the paths of length @p pathLength of each graphs in @p graphs described by @p model.
- * Affiche les chemins de longueur pathLength pour tous les graphes décrits dans model.
+ * @brief A function used to build our ɸ2 formula in the binary encoding: the path ends at the target.
  * 
- * @param ctx, The solver context. 
- * @param model, A variable assignment. 
- * @param graphs, An array of graphs. 
- * @param numGraph, The number of graphs in @p graphs. 
- * @param pathLength, The length of path.
+ * @param ctx, The solver context.
+ * @param graphs, An array of graphs.
+ * @param i, The number of graphs in @p graphs.
+ * @param pathLength, The length of the path to check.
+ * @param distances, The distances of the graph, or NULL if the pruning is disabled.
+ * @return Z3_ast, The formula.
  */
-void printPathsFromModel(Z3_context ctx, Z3_model model, Graph *graphs, int numGraph, int pathLength){
-    for(int i = 0 ; i < numGraph ; i++ ){
-        printf("Chemin valide pour le graphe %d\n",i);
-        oneGraphPrintPathsFromModel(ctx, model, graphs[i], i, pathLength);
+Z3_ast graphToBinaryPhi2Formula(Z3_context ctx, Graph *graphs, unsigned int i, int pathLength, Distances *distances){
+    for(int u = 0; u < orderG(graphs[i]); u++){
+        if(isTarget(graphs[i],u)){
+            if(!isNodeAllowed(distances,u,pathLength,pathLength)){
+                return Z3_mk_false(ctx);
+            }
+            return binaryNodeAt(ctx,i,pathLength,pathLength,getNumNodeBits(orderG(graphs[i])),u);
+        }
     }
+    return Z3_mk_false(ctx);
 }
 
 /**
- * @brief Small function returning the integers corresponding to the starting and ending nodes of the graph.
+ * @brief A function used to build our ɸ3 formula in the binary encoding: the number written at each position is a node identifier, i.e. is lower
+ *        than the order of the graph. This replaces ɸ3 and ɸ4, since a position always holds exactly one number.
  * 
- * @param ctx, The solver context. 
- * @param model, A variable assignment. 
- * @param graphNumber, The index of the graph in the array.
- * @param pathLength, The length of path.
- * @param tab, The array in which we save the integers with the one for the starting node in the case 0 and the ending one in the case 1.
+ * @param ctx, The solver context.
+ * @param graphs, An array of graphs.
+ * @param i, The number of graphs in @p graphs.
+ * @param pathLength, The length of the path to check, or ANY_LENGTH.
+ * @param lastPosition, The last position constrained.
+ * @return Z3_ast, The formula.
  */
-void get_source_and_destination(Z3_context ctx, Z3_model model, Graph graph, int graphNumber, int pathLength, int * tab){
-    for(int u = 0 ; u < orderG(graph) ; u++){
-        if(valueOfVarInModel(ctx, model, getNodeVariable(ctx,graphNumber,0,pathLength,u))){
-            tab[0] = u;
-        }numGraphs
-        else if(valueOfVarInModel(ctx, model, getNodeVariable(ctx,graphNumber,pathLength,pathLength,u))){
-            tab[1] = u;
+Z3_ast graphToBinaryPhi3Formula(Z3_context ctx, Graph *graphs, unsigned int i, int pathLength, int lastPosition){
+    int numBits = getNumNodeBits(orderG(graphs[i]));
+    int maxNode = orderG(graphs[i])-1;
+    if(maxNode < 0){
+        return Z3_mk_false(ctx);
+    }
+    Z3_ast formulaAND[lastPosition+1];
+    for(int j = 0 ; j <= lastPosition ; j++){
+        // From the least significant bit up: value[b..0] <= maxNode[b..0].
+        Z3_ast lowerOrEqual = Z3_mk_true(ctx);
+        for(int b = 0 ; b < numBits ; b++){
+            Z3_ast negBit = getNegNodeBitVariable(ctx,i,j,pathLength,b);
+            Z3_ast args[2] = {negBit,lowerOrEqual};
+            if((maxNode >> b) & 1){
+                lowerOrEqual = Z3_mk_or(ctx,2,args);
+            }else{
+                lowerOrEqual = Z3_mk_and(ctx,2,args);
+            }
         }
+        formulaAND[j] = lowerOrEqual;
     }
-    return;
+    return Z3_mk_and(ctx,lastPosition+1,formulaAND);
 }
 
 /**
- * @brief Creates the file ("%s-l%d.dot",name,pathLength) representing the solution to the problem described by @p model, or ("result-l%d.dot,pathLength") if name is NULL.
- * Crée le fichier représentant la solution du problème décrit par model, ou ("result-l%d.dot,pathLength") si name == NULL
+ * @brief A function building, in the binary encoding, the clauses excluding the pruned nodes from the positions where no accepting path can use them.
+ *        In the formula shared by all lengths, a node at position j also needs the path to be active until it has reached the target.
  * 
  * @param ctx, The solver context.
- * @param model, A variable assignment. 
  * @param graphs, An array of graphs.
- * @param numGraph, The number of graphs in @p graphs. 
- * @param pathLength, The length of path. 
- * @param name, The name of the output file. 
+ * @param i, The number of graphs in @p graphs.
+ * @param pathLength, The length of the path to check, or ANY_LENGTH.
+ * @param minLength, The smallest length, ignored if @p active is NULL.
+ * @param maxLength, The largest length, which is the last position constrained.
+ * @param distances, The distances of the graph.
+ * @param active, The formulae given by getActivePositions, or NULL if all positions up to @p maxLength are used.
+ * @return Z3_ast, The formula.
  */
-void createDotFromModel(Z3_context ctx, Z3_model model, Graph *graphs, int numGraph, int pathLength, char* name){
-    // open the file for writing //
-    char* tmp = (char*)malloc(sizeof(char)*(13+strlen(name)+log10(pathLength))); 
-    if(tmp == NULL){
-        printf("Not enough memory to allocate tmp in createDotFromModel\n");
+Z3_ast graphToBinaryPruningFormula(Z3_context ctx, Graph *graphs, unsigned int i, int pathLength, int minLength, int maxLength, Distances *distances, Z3_ast *active){
+    int numNodes = orderG(graphs[i]);
+    int numBits = getNumNodeBits(numNodes);
+    Z3_ast* formulaAND = (Z3_ast*)malloc(sizeof(Z3_ast)*((maxLength+1)*numNodes+1));
+    if(formulaAND == NULL){
+        printf("Not enough memory to allocate formulaAND in graphToBinaryPruningFormula\n");
         exit(EXIT_FAILURE);
     }
-    int save_out = dup(STDOUT_FILENO);
-    sprintf(tmp, "./sol/%s-l%d.dot",name,pathLength);
-    int fp = open(tmp, O_CREAT | O_RDWR | O_TRUNC, 0777);
-    close(1);
-    dup2(fp,1);
-    printf ("digraph %s{\n",name);
-    for(int graphNumber = 0; graphNumber < numGraph; graphNumber++){
-        int tab[2];
-        // Display the starting and ending nodes.
-        get_source_and_destination(ctx, model, graphs[graphNumber], graphNumber, pathLength, tab);
-        printf ("_%d_%s [initial=1,color=green][style=filled,fillcolor=lightblue];\n",graphNumber,getNodeName(graphs[graphNumber],tab[0]));
-        printf ("_%d_%s [final=1,color=red][style=filled,fillcolor=lightblue];\n",graphNumber,getNodeName(graphs[graphNumber],tab[1]));
-        int numNode = orderG(graphs[graphNumber]);
-        // Display every other nodes with the one in the path in 'light-blue'.
-        for(int ind = 0 ; ind < numNode ; ind++ ){
-            if(!isTarget(graphs[graphNumber],ind) && !isSource(graphs[graphNumber],ind)){
-                bool used = false;
-                for(int j = 0 ; j < pathLength+1 ; j++){
-                    if(valueOfVarInModel(ctx,model,getNodeVariable(ctx,graphNumber,j,pathLength,ind))){
-                        used = true;
-                        break;
-                    }
+    int id = 0;
+    Z3_ast formulaOR[numBits+2];
+    for(int j = 0 ; j <= maxLength ; j++){
+        for(int u = 0 ; u < numNodes ; u++){
+            int ind = numBits;
+            if(isNodeAllowed(distances,u,j,maxLength)){
+                int reach = j+getDistanceToTarget(distances,u);
+                if(active == NULL || reach <= minLength || reach == j){
+                    continue;
                 }
-                if(used){
-                    printf ("_%d_%s [style=filled,fillcolor=lightblue];\n",graphNumber,getNodeName(graphs[graphNumber],ind));
-                }else{
-                    printf ("_%d_%s ;\n",graphNumber,getNodeName(graphs[graphNumber],ind));
+                formulaOR[ind++] = active[reach];
+            }
+            getBinaryNodeLiterals(ctx,i,j,pathLength,numBits,u,true,formulaOR);
+            if(active != NULL && j > minLength){
+                formulaOR[ind++] = Z3_mk_not(ctx,active[j]);
+            }
+            formulaAND[id++] = Z3_mk_or(ctx,ind,formulaOR);
+        }
+    }
+    Z3_ast finalAND = Z3_mk_and(ctx,id,formulaAND);
+    free(formulaAND);
+    return finalAND;
+}
+
+/**
+ * @brief A function used to build our ɸ5 formula in the binary encoding: the numbers written at two different positions differ on at least one bit.
+ * 
+ * @param ctx, The solver context.
+ * @param graphs, An array of graphs.
+ * @param i, The number of graphs in @p graphs.
+ * @param pathLength, The length of the path to check.
+ * @return Z3_ast, The formula.
+ */
+Z3_ast graphToBinaryPhi5Formula(Z3_context ctx, Graph *graphs, unsigned int i, int pathLength){
+    int numBits = getNumNodeBits(orderG(graphs[i]));
+    Z3_ast* formulaAND = (Z3_ast*)malloc(sizeof(Z3_ast)*((pathLength+1)*pathLength/2+1));
+    if(formulaAND == NULL){
+        printf("Not enough memory to allocate formulaAND in binary Phi5\n");
+        exit(EXIT_FAILURE);
+    }
+    int id = 0;
+    Z3_ast formulaOR[numBits+1];
+    for(int j = 0 ; j <= pathLength ; j++){
+        for(int j2 = j+1 ; j2 <= pathLength ; j2++){
+            for(int b = 0 ; b < numBits ; b++){
+                formulaOR[b] = Z3_mk_xor(ctx,getNodeBitVariable(ctx,i,j,pathLength,b),getNodeBitVariable(ctx,i,j2,pathLength,b));
+            }
+            formulaAND[id++] = Z3_mk_or(ctx,numBits,formulaOR);
+        }
+    }
+    Z3_ast finalAND = Z3_mk_and(ctx,id,formulaAND);
+    free(formulaAND);
+    return finalAND;
+}
+
+/**
+ * @brief A function used to build our ɸ6 formula in the binary encoding: if node u is at position j < pathLength, one of its successors is at
+ *        position j+1.
+ * 
+ * @param ctx, The solver context.
+ * @param graphs, An array of graphs.
+ * @param i, The number of graphs in @p graphs.
+ * @param pathLength, The length of the path to check.
+ * @param distances, The distances of the graph, or NULL if the pruning is disabled.
+ * @return Z3_ast, The formula.
+ */
+Z3_ast graphToBinaryPhi6Formula(Z3_context ctx, Graph *graphs, unsigned int i, int pathLength, Distances *distances){
+    int numNodes = orderG(graphs[i]);
+    int numBits = getNumNodeBits(numNodes);
+    Z3_ast* formulaAND = (Z3_ast*)malloc(sizeof(Z3_ast)*(pathLength*numNodes+1));
+    Z3_ast* formulaOR = (Z3_ast*)malloc(sizeof(Z3_ast)*(numNodes+numBits+1));
+    if(formulaAND == NULL || formulaOR == NULL){
+        printf("Not enough memory to allocate formulaAND in binary Phi6\n");
+        exit(EXIT_FAILURE);
+    }
+    int id = 0;
+    for(int j = 0 ; j < pathLength ; j++){
+        for(int u = 0 ; u < numNodes ; u++){
+            if(!isNodeAllowed(distances,u,j,pathLength)){
+                continue; // Excluded by graphToBinaryPruningFormula.
+            }
+            getBinaryNodeLiterals(ctx,i,j,pathLength,numBits,u,true,formulaOR);
+            int ind = numBits;
+            int *successors = getSuccessors(graphs[i],u);
+            for(int e = 0 ; e < getNumSuccessors(graphs[i],u) ; e++){
+                int v = successors[e];
+                if(isNodeAllowed(distances,v,j+1,pathLength)){
+                    formulaOR[ind++] = binaryNodeAt(ctx,i,j+1,pathLength,numBits,v);
+                }
+            }
+            formulaAND[id++] = Z3_mk_or(ctx,ind,formulaOR);
+        }
+    }
+    Z3_ast finalAND = Z3_mk_and(ctx,id,formulaAND);
+    free(formulaAND);
+    free(formulaOR);
+    return finalAND;
+}
+
+/**
+ * @brief Small function returning a different value depending on the returned value of isFormulaSat
+ * 
+ * @param val, A Z3_bool returned by isFormulaSat
+ * @return An integer ( -1 if the formula wasn't SAT, 0 if it was not determined & 1 if it is SAT )
+ */
+int isSatisfiable(Z3_lbool val){
+    switch (val)
+        {
+        case Z3_L_FALSE:
+            return -1;
+
+        case Z3_L_UNDEF:
+            return 0;
+
+        case Z3_L_TRUE:
+            return 1;
+        }
+}
+
+/**
+ * @brief Generates a SAT formula satisfiable if and only if all graphs of @p graphs contain an accepting path of length @p pathLength.
+ * 
+ * @param ctx, The solver context.
+ * @param graphs, An array of graphs.
+ * @param numGraphs, The number of graphs in @p graphs.
+ * @param pathLength, The length of the path to check.
+ * @return Z3_ast, The formula.
+ */
+Z3_ast graphsToPathFormula(Z3_context ctx, Graph *graphs, unsigned int numGraphs, int pathLength){
+    double start = getStatisticsClock();
+    // The parts of the formula of each graph and their kinds, kept to measure them once the formula is built.
+    Z3_ast* parts = areStatisticsEnabled() ? (Z3_ast*)malloc(sizeof(Z3_ast)*numGraphs*6) : NULL;
+    FormulaKind* partKinds = parts != NULL ? (FormulaKind*)malloc(sizeof(FormulaKind)*numGraphs*6) : NULL;
+    if(parts != NULL && partKinds == NULL){
+        printf("Not enough memory to allocate partKinds in graphsToPathFormula\n");
+        exit(EXIT_FAILURE);
+    }
+    int numParts = 0;
+    Z3_ast* formulaAND = (Z3_ast*)malloc(sizeof(Z3_ast)*numGraphs);
+    if(formulaAND == NULL){
+        printf("Not enough memory to allocate formulaLittleAND in graphsToPathFormula\n");
+        exit(EXIT_FAILURE);
+    }
+    Z3_ast* formulaLittleAND = (Z3_ast*)malloc(sizeof(Z3_ast)*6); // 6 = number of formula
+    if(formulaLittleAND == NULL){
+        printf("Not enough memory to allocate formulaLittleAND in graphsToPathFormula\n");
+        exit(EXIT_FAILURE);
+    }
+    Distances* distances = getGraphsDistances(ctx,graphs,numGraphs);
+    for(int i = 0 ; i < numGraphs ; i++){
+        Distances *graphDistances = distances == NULL ? NULL : &distances[i];
+        if(nodeEncoding == NODE_BINARY){
+            int num = 0;
+            formulaLittleAND[num++] = graphToBinaryPhi1Formula(ctx, graphs, i, pathLength, graphDistances);
+            formulaLittleAND[num++] = graphToBinaryPhi2Formula(ctx, graphs, i, pathLength, graphDistances);
+            formulaLittleAND[num++] = graphToBinaryPhi3Formula(ctx, graphs, i, pathLength, pathLength);
+            formulaLittleAND[num++] = graphToBinaryPhi5Formula(ctx, graphs, i, pathLength);
+            formulaLittleAND[num++] = graphToBinaryPhi6Formula(ctx, graphs, i, pathLength, graphDistances);
+            if(graphDistances != NULL){
+                formulaLittleAND[num++] = graphToBinaryPruningFormula(ctx, graphs, i, pathLength, pathLength, pathLength, graphDistances, NULL);
+            }
+            formulaAND[i] = Z3_mk_and(ctx,num,formulaLittleAND);
+            FormulaKind binaryKinds[6] = {FORMULA_PHI1, FORMULA_PHI2, FORMULA_PHI3, FORMULA_PHI5, FORMULA_PHI6, FORMULA_PRUNING};
+            for(int f = 0 ; parts != NULL && f < num ; f++){
+                partKinds[numParts] = binaryKinds[f];
+                parts[numParts++] = formulaLittleAND[f];
+            }
+            continue;
+        }
+        formulaLittleAND[0] = graphToPhi1Formula(ctx, graphs, i, pathLength, graphDistances);
+        formulaLittleAND[1] = graphToPhi2Formula(ctx, graphs, i, pathLength, graphDistances);
+        formulaLittleAND[2] = graphToPhi3Formula(ctx, graphs, i, pathLength, graphDistances);
+        formulaLittleAND[3] = graphToPhi4Formula(ctx, graphs, i, pathLength, graphDistances);
+        formulaLittleAND[4] = graphToPhi5Formula(ctx, graphs, i, pathLength, graphDistances);
+        formulaLittleAND[5] = graphToPhi6Formula(ctx, graphs, i, pathLength, graphDistances);
+        formulaAND[i] = Z3_mk_and(ctx,6,formulaLittleAND);
+        for(int f = 0 ; parts != NULL && f < 6 ; f++){
+            partKinds[numParts] = (FormulaKind)(FORMULA_PHI1+f);
+            parts[numParts++] = formulaLittleAND[f];
+        }
+    }
+    
+    Z3_ast x = Z3_mk_and(ctx,numGraphs,formulaAND);
+    releaseGraphsDistances(distances,numGraphs);
+    free(formulaLittleAND);
+    free(formulaAND);
+    addPhaseTime(PHASE_ENCODE, start);
+    for(int p = 0 ; p < numParts ; p++){
+        addFormulaStatistics(ctx, partKinds[p], parts[p]);
+    }
+    free(parts);
+    free(partKinds);
+    return x;
+}
+
+
+/**
+ * @brief Generates the selector variable stating that the common path has length @p pathLength, in the formulae shared by all lengths.
+ * 
+ * @param ctx, The solver context.
+ * @param pathLength, The length of the path.
+ * @return Z3_ast, The selector variable.
+ */
+Z3_ast getLengthSelector(Z3_context ctx, int pathLength){
+    NodeVariables *table = nodeVariables;
+    bool cached = table != NULL && table->ctx == ctx && pathLength >= 0 && pathLength <= table->maxK;
+    if(cached && table->selectors[pathLength] != NULL){
+        return table->selectors[pathLength];
+    }
+    char str[32];
+    sprintf(str, "L_%d", pathLength);
+    Z3_ast selector = mk_bool_var(ctx, str); // His name will be L_k ( k = pathLength )
+    if(cached){
+        table->selectors[pathLength] = selector;
+    }
+    return selector;
+}
+
+/**
+ * @brief Small function returning the bit @p bit of the register holding the selected length in binary, from the table of the current thread. The
+ *        register only exists with a table, whose maxK gives its number of bits.
+ * 
+ * @param ctx, The solver context.
+ * @param bit, The number of the bit, 0 for the lowest one.
+ * @return Z3_ast, The variable of the bit, or NULL if the current thread has no table for @p ctx.
+ */
+static Z3_ast getLengthBit(Z3_context ctx, int bit){
+    NodeVariables *table = nodeVariables;
+    if(table == NULL || table->ctx != ctx || bit < 0 || bit >= table->numLengthBits){
+        return NULL;
+    }
+    if(table->lengthBits[bit] == NULL){
+        char str[32];
+        sprintf(str, "LB_%d", bit);
+        table->lengthBits[bit] = mk_bool_var(ctx, str); // His name will be LB_b ( b = bit )
+    }
+    return table->lengthBits[bit];
+}
+
+/**
+ * @brief Small function building the formula stating that the register of getLengthBit holds @p pathLength when its selector is true.
+ * 
+ * @param ctx, The solver context.
+ * @param pathLength, The length.
+ * @return Z3_ast, The formula, or NULL if there is no register.
+ */
+static Z3_ast getLengthRegisterFormula(Z3_context ctx, int pathLength){
+    if(getLengthBit(ctx,0) == NULL){
+        return NULL;
+    }
+    int numBits = nodeVariables->numLengthBits;
+    Z3_ast bits[numBits];
+    for(int b = 0 ; b < numBits ; b++){
+        bits[b] = (pathLength >> b) & 1 ? getLengthBit(ctx,b) : Z3_mk_not(ctx,getLengthBit(ctx,b));
+    }
+    return Z3_mk_implies(ctx,getLengthSelector(ctx,pathLength),Z3_mk_and(ctx,numBits,bits));
+}
+
+/**
+ * @brief Small function building, for each position j <= @p maxLength, the formula stating that the path goes through position j, i.e. that the
+ *        selected length is at least j.
+ * 
+ * @param ctx, The solver context.
+ * @param minLength, The smallest length.
+ * @param maxLength, The largest length.
+ * @param active, The array of size @p maxLength+1 in which the formulae are written.
+ */
+void getActivePositions(Z3_context ctx, int minLength, int maxLength, Z3_ast *active){
+    Z3_ast atLeast = Z3_mk_false(ctx);
+    for(int j = maxLength ; j >= 0 ; j--){
+        if(j <= minLength){
+            active[j] = Z3_mk_true(ctx);
+        }else{
+            Z3_ast formulaOR[2] = {getLengthSelector(ctx,j),atLeast};
+            atLeast = Z3_mk_or(ctx,2,formulaOR);
+            active[j] = atLeast;
+        }
+    }
+}
+
+/**
+ * @brief A function building the block of graph @p i in the formula shared by all lengths, with the one-hot encoding. The variables of positions
+ *        beyond the selected length are all false.
+ * 
+ * @param ctx, The solver context.
+ * @param graphs, An array of graphs.
+ * @param i, The number of the graph in @p graphs.
+ * @param minLength, The smallest length.
+ * @param maxLength, The largest length.
+ * @param active, The formulae given by getActivePositions.
+ * @param distances, The distances of the graph, or NULL if the pruning is disabled.
+ * @return Z3_ast, The formula.
+ */
+Z3_ast graphToUnifiedFormula(Z3_context ctx, Graph *graphs, unsigned int i, int minLength, int maxLength, Z3_ast *active, Distances *distances){
+    int numNodes = orderG(graphs[i]);
+    int numPositions = maxLength+1;
+    int size = 1+(maxLength-minLength+1)+numPositions*(numNodes+2)+numNodes;
+    Z3_ast* formulaAND = (Z3_ast*)malloc(sizeof(Z3_ast)*size);
+    int maxLiterals = numNodes > numPositions ? numNodes : numPositions;
+    Z3_ast* literals = (Z3_ast*)malloc(sizeof(Z3_ast)*(maxLiterals+1));
+    Z3_ast* negLiterals = (Z3_ast*)malloc(sizeof(Z3_ast)*(maxLiterals+1));
+    Z3_ast* formulaOR = (Z3_ast*)malloc(sizeof(Z3_ast)*(sizeG(graphs[i])+1));
+    if(formulaAND == NULL || literals == NULL || negLiterals == NULL || formulaOR == NULL){
+        printf("Not enough memory to allocate formulaAND in graphToUnifiedFormula\n");
+        exit(EXIT_FAILURE);
+    }
+    int id = 0;
+    // ɸ1: the path starts at the source.
+    int source = -1, target = -1;
+    for(int u = numNodes-1 ; u >= 0 ; u--){
+        if(isSource(graphs[i],u)) source = u;
+        if(isTarget(graphs[i],u)) target = u;
+    }
+    bool sourceAllowed = source >= 0 && isNodeAllowed(distances,source,0,maxLength);
+    formulaAND[id++] = sourceAllowed ? getNodeVariable(ctx,i,0,ANY_LENGTH,source) : Z3_mk_false(ctx);
+    // ɸ2: the path of length k ends at the target.
+    for(int k = minLength ; k <= maxLength ; k++){
+        bool targetAllowed = target >= 0 && isNodeAllowed(distances,target,k,maxLength);
+        Z3_ast end = targetAllowed ? getNodeVariable(ctx,i,k,ANY_LENGTH,target) : Z3_mk_false(ctx);
+        formulaAND[id++] = Z3_mk_implies(ctx,getLengthSelector(ctx,k),end);
+    }
+    for(int j = 0 ; j < numPositions ; j++){
+        // ɸ3: an active position has a node, and an inactive one has none. A node also needs the path to go on until it reaches the target.
+        int ind = 0;
+        for(int u = 0 ; u < numNodes ; u++){
+            if(!isNodeAllowed(distances,u,j,maxLength)){
+                continue;
+            }
+            literals[ind] = getNodeVariable(ctx,i,j,ANY_LENGTH,u);
+            negLiterals[ind] = getNegNodeVariable(ctx,i,j,ANY_LENGTH,u);
+            int reach = j+getDistanceToTarget(distances,u);
+            if(reach > minLength){
+                formulaAND[id++] = Z3_mk_implies(ctx,literals[ind],active[reach]);
+            }
+            ind++;
+        }
+        formulaAND[id++] = Z3_mk_implies(ctx,active[j],Z3_mk_or(ctx,ind,literals));
+        // ɸ4: at most one node per position.
+        formulaAND[id++] = atMostOne(ctx,literals,negLiterals,ind,amoEncoding);
+    }
+    // ɸ5: each node at most once in the path.
+    for(int u = 0 ; u < numNodes ; u++){
+        if(distances != NULL && !isNodeUseful(*distances,u)){
+            continue;
+        }
+        int ind = 0;
+        for(int j = 0 ; j < numPositions ; j++){
+            if(isNodeAllowed(distances,u,j,maxLength)){
+                literals[ind] = getNodeVariable(ctx,i,j,ANY_LENGTH,u);
+                negLiterals[ind++] = getNegNodeVariable(ctx,i,j,ANY_LENGTH,u);
+            }
+        }
+        formulaAND[id++] = atMostOne(ctx,literals,negLiterals,ind,amoEncoding);
+    }
+    // ɸ6: two consecutive active positions are linked by an edge.
+    for(int j = 0 ; j < maxLength ; j++){
+        int ind = 0;
+        for(int u = 0 ; u < numNodes ; u++){
+            if(!isNodeAllowed(distances,u,j,maxLength)){
+                continue;
+            }
+            int *successors = getSuccessors(graphs[i],u);
+            for(int e = 0 ; e < getNumSuccessors(graphs[i],u) ; e++){
+                int v = successors[e];
+                if(isNodeAllowed(distances,v,j+1,maxLength)){
+                    Z3_ast formulaLittleAND[2] = {getNodeVariable(ctx,i,j,ANY_LENGTH,u),getNodeVariable(ctx,i,j+1,ANY_LENGTH,v)};
+                    formulaOR[ind++] = Z3_mk_and(ctx,2,formulaLittleAND);
                 }
             }
         }
-        // Display every edges with the ones in the path in 'blue'.
-        for(int u = 0 ; u < numNode ; u++ ){
-            for(int v = 0 ; v < numNode ; v++ ){
-                if(isEdge(graphs[graphNumber],u,v)){
-                    bool used = false;
-                    for(int j = 0 ; j < pathLength ; j++){
-                        if(valueOfVarInModel(ctx,model,getNodeVariable(ctx,graphNumber,j,pathLength,u)) && valueOfVarInModel(ctx,model,getNodeVariable(ctx,graphNumber,j+1,pathLength,v))){
-                            used = true;
-                            break;
-                        }
-                    }
-                    if(used){
-                        printf ("_%d_%s -> _%d_%s [color=blue];\n",graphNumber,getNodeName(graphs[graphNumber],u),graphNumber,getNodeName(graphs[graphNumber],v));
-                    }else{
-                        printf ("_%d_%s -> _%d_%s;\n",graphNumber,getNodeName(graphs[graphNumber],u),graphNumber,getNodeName(graphs[graphNumber],v));
-                    }
+        formulaAND[id++] = Z3_mk_implies(ctx,active[j+1],Z3_mk_or(ctx,ind,formulaOR));
+    }
+    Z3_ast finalAND = Z3_mk_and(ctx,id,formulaAND);
+    free(formulaAND);
+    free(literals);
+    free(negLiterals);
+    free(formulaOR);
+    return finalAND;
+}
+
+/**
+ * @brief A function building the block of graph @p i in the formula shared by all lengths, with the binary encoding. The bits of positions beyond
+ *        the selected length are left free.
+ * 
+ * @param ctx, The solver context.
+ * @param graphs, An array of graphs.
+ * @param i, The number of the graph in @p graphs.
+ * @param minLength, The smallest length.
+ * @param maxLength, The largest length.
+ * @param active, The formulae given by getActivePositions.
+ * @param distances, The distances of the graph, or NULL if the pruning is disabled.
+ * @return Z3_ast, The formula.
+ */
+Z3_ast graphToUnifiedBinaryFormula(Z3_context ctx, Graph *graphs, unsigned int i, int minLength, int maxLength, Z3_ast *active, Distances *distances){
+    int numNodes = orderG(graphs[i]);
+    int numBits = getNumNodeBits(numNodes);
+    int numPositions = maxLength+1;
+    int size = 3+(maxLength-minLength+1)+numPositions*maxLength/2+maxLength*numNodes;
+    Z3_ast* formulaAND = (Z3_ast*)malloc(sizeof(Z3_ast)*size);
+    Z3_ast* formulaOR = (Z3_ast*)malloc(sizeof(Z3_ast)*(numNodes+numBits+2));
+    if(formulaAND == NULL || formulaOR == NULL){
+        printf("Not enough memory to allocate formulaAND in graphToUnifiedBinaryFormula\n");
+        exit(EXIT_FAILURE);
+    }
+    int id = 0;
+    int source = -1, target = -1;
+    for(int u = numNodes-1 ; u >= 0 ; u--){
+        if(isSource(graphs[i],u)) source = u;
+        if(isTarget(graphs[i],u)) target = u;
+    }
+    // ɸ1: the path starts at the source.
+    bool sourceAllowed = source >= 0 && isNodeAllowed(distances,source,0,maxLength);
+    formulaAND[id++] = sourceAllowed ? binaryNodeAt(ctx,i,0,ANY_LENGTH,numBits,source) : Z3_mk_false(ctx);
+    // ɸ2: the path of length k ends at the target.
+    for(int k = minLength ; k <= maxLength ; k++){
+        bool targetAllowed = target >= 0 && isNodeAllowed(distances,target,k,maxLength);
+        Z3_ast end = targetAllowed ? binaryNodeAt(ctx,i,k,ANY_LENGTH,numBits,target) : Z3_mk_false(ctx);
+        formulaAND[id++] = Z3_mk_implies(ctx,getLengthSelector(ctx,k),end);
+    }
+    // ɸ3: every position holds a node identifier.
+    formulaAND[id++] = graphToBinaryPhi3Formula(ctx,graphs,i,ANY_LENGTH,maxLength);
+    if(distances != NULL){
+        formulaAND[id++] = graphToBinaryPruningFormula(ctx,graphs,i,ANY_LENGTH,minLength,maxLength,distances,active);
+    }
+    // ɸ5: two active positions hold different nodes.
+    for(int j = 0 ; j <= maxLength ; j++){
+        for(int j2 = j+1 ; j2 <= maxLength ; j2++){
+            for(int b = 0 ; b < numBits ; b++){
+                formulaOR[b] = Z3_mk_xor(ctx,getNodeBitVariable(ctx,i,j,ANY_LENGTH,b),getNodeBitVariable(ctx,i,j2,ANY_LENGTH,b));
+            }
+            formulaAND[id++] = Z3_mk_implies(ctx,active[j2],Z3_mk_or(ctx,numBits,formulaOR));
+        }
+    }
+    // ɸ6: if node u is at an active position followed by an active one, one of its successors is at the next position.
+    for(int j = 0 ; j < maxLength ; j++){
+        for(int u = 0 ; u < numNodes ; u++){
+            if(!isNodeAllowed(distances,u,j,maxLength)){
+                continue; // Excluded by graphToBinaryPruningFormula.
+            }
+            getBinaryNodeLiterals(ctx,i,j,ANY_LENGTH,numBits,u,true,formulaOR);
+            formulaOR[numBits] = Z3_mk_not(ctx,active[j+1]);
+            int ind = numBits+1;
+            int *successors = getSuccessors(graphs[i],u);
+            for(int e = 0 ; e < getNumSuccessors(graphs[i],u) ; e++){
+                int v = successors[e];
+                if(isNodeAllowed(distances,v,j+1,maxLength)){
+                    formulaOR[ind++] = binaryNodeAt(ctx,i,j+1,ANY_LENGTH,numBits,v);
                 }
             }
+            formulaAND[id++] = Z3_mk_or(ctx,ind,formulaOR);
         }
     }
-    printf ("}\n");
-    dup2(save_out, STDOUT_FILENO);
-    close(fp);
-    free(tmp);
+    Z3_ast finalAND = Z3_mk_and(ctx,id,formulaAND);
+    free(formulaAND);
+    free(formulaOR);
+    return finalAND;
+}
+
+/**
+ * @brief Builds the formula of graphsToUnifiedFormula over the lengths between @p minLength and @p maxLength which are true in @p lengths.
+ * 
+ * @param ctx, The solver context.
+ * @param graphs, An array of graphs.
+ * @param numGraphs, The number of graphs in @p graphs.
+ * @param minLength, The smallest length.
+ * @param maxLength, The largest length.
+ * @param lengths, The candidate lengths given by computeCandidateLengths, up to @p maxLength.
+ * @param distances, The distances of each graph given by computeGraphsDistances, or NULL without the pruning.
+ * @return Z3_ast, The formula.
+ */
+static Z3_ast buildUnifiedFormula(Z3_context ctx, Graph *graphs, unsigned int numGraphs, int minLength, int maxLength, bool *lengths, Distances *distances){
+    int numLengths = 0;
+    Z3_ast selectors[maxLength-minLength+1];
+    Z3_ast* formulaAND = (Z3_ast*)malloc(sizeof(Z3_ast)*(numGraphs+maxLength-minLength+3));
+    if(formulaAND == NULL){
+        printf("Not enough memory to allocate formulaAND in buildUnifiedFormula\n");
+        exit(EXIT_FAILURE);
+    }
+    int id = 2;
+    int shortest = maxLength+1, longest = minLength-1;
+    for(int k = minLength ; k <= maxLength ; k++){
+        if(lengths[k]){
+            selectors[numLengths++] = getLengthSelector(ctx,k);
+            shortest = min(shortest,k);
+            longest = k;
+            // The selected length is also written in binary, so that it is read from a model in a few lookups.
+            Z3_ast reg = getLengthRegisterFormula(ctx,k);
+            if(reg != NULL){
+                formulaAND[id++] = reg;
+            }
+        }else{
+            formulaAND[id++] = Z3_mk_not(ctx,getLengthSelector(ctx,k));
+        }
+    }
+    if(numLengths == 0){
+        free(formulaAND);
+        return Z3_mk_false(ctx);
+    }
+    // The positions are only needed up to the longest length selectable, which is within the bounds of every graph, and the ones up to the
+    // shortest are always active.
+    minLength = shortest;
+    maxLength = longest;
+    Z3_ast active[maxLength+1];
+    getActivePositions(ctx,minLength,maxLength,active);
+    // Exactly one length is selected.
+    formulaAND[0] = Z3_mk_or(ctx,numLengths,selectors);
+    formulaAND[1] = atMostOne(ctx,selectors,NULL,numLengths,amoEncoding);
+    for(unsigned int i = 0 ; i < numGraphs ; i++){
+        Distances *graphDistances = distances == NULL ? NULL : &distances[i];
+        if(nodeEncoding == NODE_BINARY){
+            formulaAND[id++] = graphToUnifiedBinaryFormula(ctx,graphs,i,minLength,maxLength,active,graphDistances);
+        }else{
+            formulaAND[id++] = graphToUnifiedFormula(ctx,graphs,i,minLength,maxLength,active,graphDistances);
+        }
+    }
+    Z3_ast x = Z3_mk_and(ctx,id,formulaAND);
+    free(formulaAND);
+    addFormulaStatistics(ctx, FORMULA_UNIFIED, x);
+    return x;
+}
+
+/**
+ * @brief Generates a SAT formula satisfiable if and only if all graphs of @p graphs contain an accepting path of a common length between
+ *        @p minLength and @p maxLength. The variables of a position are shared by all lengths, and the selected length is the one whose selector is true.
+ * 
+ * @param ctx, The solver context.
+ * @param graphs, An array of graphs.
+ * @param numGraphs, The number of graphs in @p graphs.
+ * @param minLength, The smallest length.
+ * @param maxLength, The largest length.
+ * @return Z3_ast, The formula.
+ */
+Z3_ast graphsToUnifiedFormula(Z3_context ctx, Graph *graphs, unsigned int numGraphs, int minLength, int maxLength){
+    if(maxLength < minLength){
+        return Z3_mk_false(ctx);
+    }
+    double start = getStatisticsClock();
+    // Only the lengths within the bounds of every graph, and with the pruning of a walk in every graph, can be selected. The bounds reuse the distances.
+    Distances* distances = getGraphsDistances(ctx,graphs,numGraphs);
+    bool* lengths = computeCandidateLengths(graphs,numGraphs,maxLength,pruning,distances);
+    Z3_ast x = buildUnifiedFormula(ctx,graphs,numGraphs,minLength,maxLength,lengths,distances);
+    free(lengths);
+    releaseGraphsDistances(distances,numGraphs);
+    addPhaseTime(PHASE_ENCODE, start);
+    return x;
+}
+
+/**
+ * @brief Adds the formula of graphsToUnifiedFormula to @p solver.
+ * 
+ * @param ctx, The solver context.
+ * @param solver, A solver created by makeSolver.
+ * @param graphs, An array of graphs.
+ * @param numGraphs, The number of graphs in @p graphs.
+ * @param minLength, The smallest length.
+ * @param maxLength, The largest length.
+ * @return Z3_ast, The formula added.
+ */
+Z3_ast addUnifiedFormulaToSolver(Z3_context ctx, Z3_solver solver, Graph *graphs, unsigned int numGraphs, int minLength, int maxLength){
+    Z3_ast formula = graphsToUnifiedFormula(ctx, graphs, numGraphs, minLength, maxLength);
+    Z3_solver_assert(ctx, solver, formula);
+    return formula;
+}
+
+/**
+ * @brief Tells if all graphs contain an accepting path of length @p pathLength, using the formula added to @p solver by addUnifiedFormulaToSolver.
+ * 
+ * @param ctx, The solver context.
+ * @param solver, A solver created by makeSolver.
+ * @param pathLength, The length of the path to check.
+ * @return Z3_lbool, The answer of the solver.
+ */
+Z3_lbool isPathLengthSat(Z3_context ctx, Z3_solver solver, int pathLength){
+    Z3_ast selector = getLengthSelector(ctx, pathLength);
+    return isSatUnderAssumptions(ctx, solver, 1, &selector);
+}
+
+/**
+ * @brief Definitely excludes the length @p pathLength from the next checks of @p solver.
+ * 
+ * @param ctx, The solver context.
+ * @param solver, A solver created by makeSolver.
+ * @param pathLength, The length whose formula is disabled.
+ */
+void retractPathFormulaFromSolver(Z3_context ctx, Z3_solver solver, int pathLength){
+    Z3_solver_assert(ctx, solver, Z3_mk_not(ctx, getLengthSelector(ctx, pathLength)));
+}
+
+void initLengthWindow(LengthWindow *window){
+    window->solver = NULL;
+    window->formula = NULL;
+    window->first = 0;
+    window->last = -1;
+    window->width = 1;
+}
+
+Z3_solver getLengthWindowSolver(Z3_context ctx, LengthWindow *window, Graph *graphs, unsigned int numGraphs, int pathLength, int minLength, int maxLength, bool decreasing){
+    if(window->solver != NULL && pathLength >= window->first && pathLength <= window->last){
+        return window->solver;
+    }
+    deleteLengthWindow(ctx, window);
+    // What is learned is only kept within a window, but the formula of each window is as small as the lengths it covers allow.
+    window->first = decreasing ? max(minLength, pathLength-window->width+1) : pathLength;
+    window->last = decreasing ? pathLength : min(maxLength, pathLength+window->width-1);
+    window->width *= 2;
+    window->solver = makeSolver(ctx);
+    window->formula = addUnifiedFormulaToSolver(ctx, window->solver, graphs, numGraphs, window->first, window->last);
+    return window->solver;
+}
+
+void deleteLengthWindow(Z3_context ctx, LengthWindow *window){
+    if(window->solver != NULL){
+        deleteSolver(ctx, window->solver);
+        window->solver = NULL;
+        window->formula = NULL;
+    }
+}
+
+/**
+ * @brief Small function returning the node at position @p position of a path of a graph described by @p model, in the encoding used by the current
+ *        thread. The values are read directly in @p model, without evaluating any formula.
+ * 
+ * @param ctx, The solver context.
+ * @param model, A variable assignment.
+ * @param graph, A graph.
+ * @param graphIndex, The index of the graph in the array.
+ * @param position, The position in the path.
+ * @param k, The length of the path, or ANY_LENGTH to read the variables shared by all lengths.
+ * @return The node identifier, or -1 if @p model puts no node at this position.
+ */
+int getNodeAtPosition(Z3_context ctx, Z3_model model, Graph graph, int graphIndex, int position, int k){
+    if(nodeEncoding == NODE_BINARY){
+        int node = 0;
+        int numBits = getNumNodeBits(orderG(graph));
+        for(int b = 0 ; b < numBits ; b++){
+            if(isVariableTrueInModel(ctx, model, getNodeBitVariable(ctx,graphIndex,position,k,b))){
+                node |= 1 << b;
+            }
+        }
+        return node < orderG(graph) ? node : -1;
+    }
+    for(int u = 0 ; u < orderG(graph) ; u++){
+        if(isVariableTrueInModel(ctx, model, getNodeVariable(ctx,graphIndex,position,k,u))){
+            return u;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Small function reading the path of a graph described by @p model.
+ * 
+ * @param ctx, The solver context.
+ * @param model, A variable assignment.
+ * @param graph, A graph.
+ * @param graphIndex, The index of the graph in the array.
+ * @param pathLength, The length of path.
+ * @param k, @p pathLength, or ANY_LENGTH if @p model comes from a formula shared by all lengths.
+ * @param path, The array of size @p pathLength+1 in which the node at each position is written.
+ * @return true if there is a node at every position, false otherwise.
+ */
+bool getPathFromModel(Z3_context ctx, Z3_model model, Graph graph, int graphIndex, int pathLength, int k, int *path){
+    for(int j = 0 ; j <= pathLength ; j++){
+        path[j] = getNodeAtPosition(ctx, model, graph, graphIndex, j, k);
+        if(path[j] < 0){
+            return false;
+        }
+    }
+    return true;
+}
+
+int getSolutionLengthFromModel(Z3_context ctx, Z3_model model, Graph *graphs){
+    double start = getStatisticsClock();
+    int length = -1;
+    if(getLengthBit(ctx,0) != NULL){
+        // The length is read in the bits of the register, then its selector confirms it: one lookup per bit instead of one per length.
+        length = 0;
+        for(int b = 0 ; b < nodeVariables->numLengthBits ; b++){
+            if(isVariableTrueInModel(ctx, model, getLengthBit(ctx,b))){
+                length |= 1 << b;
+            }
+        }
+        if(length > nodeVariables->maxK || !isVariableTrueInModel(ctx, model, getLengthSelector(ctx,length))){
+            length = -1;
+        }
+    }else{
+        // Without a table there is no register: the selectors are looked up until the true one.
+        int maxLength = orderG(graphs[0]);
+        for(int k = 0 ; k < maxLength && length < 0 ; k++ ){
+            if(isVariableTrueInModel(ctx, model, getLengthSelector(ctx,k))){
+                length = k;
+            }
+        }
+    }
+    addPhaseTime(PHASE_DECODE, start);
+    return length;
+}
+
+
+/**
+ * @brief Generates a SAT formula satisfiable if and only if all graphs of @p graphs contain an accepting path of common length.
+ * Génère une formule SAT satisfaisable si et seulement si tous les graphes de graphs contiennent un chemin acceptant de longueur commune.
+ * 
+ * @param ctx, The solver context.
+ * @param graphs, An array of graphs.
+ * @param numGraphs, The number of graphs in @p graphs. 
+ * @return Z3_ast, The formula, or NULL if the bounds or the pruning show that no length is possible.
+ */
+Z3_ast graphsToFullFormula(Z3_context ctx, Graph *graphs, unsigned int numGraphs){
+    int maxLength = getMaxK(graphs,numGraphs)-1;
+    if(maxLength < 1){
+        return NULL;
+    }
+    double start = getStatisticsClock();
+    Distances* distances = getGraphsDistances(ctx,graphs,numGraphs);
+    bool* lengths = computeCandidateLengths(graphs,numGraphs,maxLength,pruning,distances);
+    lengths[0] = false;
+    // No candidate length: the answer is known without building the formula.
+    Z3_ast x = NULL;
+    if(hasCandidateLength(lengths,maxLength)){
+        // A single formula for every length, whose variables are shared by all lengths: it is solved once, and the model tells the selected length.
+        x = buildUnifiedFormula(ctx,graphs,numGraphs,1,maxLength,lengths,distances);
+    }
+    free(lengths);
+    releaseGraphsDistances(distances,numGraphs);
+    addPhaseTime(PHASE_ENCODE, start);
+    return x;
+}
+
+
+
+
+/**
+ * @brief The state of the depth first search of the simple accepting paths of a graph, shared by the recursive calls.
+ */
+typedef struct {
+    int target;           ///< The target of the graph.
+    int maxLength;        ///< The largest length searched.
+    Graph graph;          ///< The graph searched.
+    Bitset visited;       ///< The nodes of the current path.
+    Bitset reached;       ///< Scratch set of the nodes reachable from the end of the current path.
+    Bitset coreached;     ///< Scratch set of the nodes reaching the target.
+    Bitset frontier;      ///< Scratch set of the last nodes reached.
+    Bitset next;          ///< Scratch set of the nodes reached next.
+    bool *wanted;         ///< The lengths still searched. A length is no longer wanted once a path of this length is found.
+    int numWanted;        ///< The number of lengths of @p wanted.
+    bool *found;          ///< The lengths of the paths found.
+    int *path;            ///< The current path.
+    int *solution;        ///< If not NULL, the path found is copied there (only meaningful when a single length is wanted).
+} PathSearch;
+
+/**
+ * @brief Small function telling if a length between @p low and @p high is still wanted by @p search.
+ * 
+ * @param search, The search.
+ * @param low, The smallest length.
+ * @param high, The largest length.
+ * @return true iff one of these lengths is wanted.
+ */
+bool isLengthWanted(PathSearch *search, int low, int high){
+    for(int k = low ; k <= high && k <= search->maxLength ; k++){
+        if(search->wanted[k]){
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief A function computing, with breadth first searches on bitsets avoiding the nodes of the current path, the set @p reached of the nodes
+ *        reachable from @p start (or reaching it if @p backwards).
+ * 
+ * @param search, The search.
+ * @param start, The node where the search starts.
+ * @param backwards, Tells if the edges are followed backwards.
+ * @param reached, The set in which the nodes reached are written.
+ * @param stop, A node whose distance is wanted, or -1.
+ * @return The distance from @p start to @p stop, or -1 if it is not reached.
+ */
+int reachAvoidingPath(PathSearch *search, int start, bool backwards, Bitset reached, int stop){
+    int distance = 0, stopDistance = start == stop ? 0 : -1;
+    clearBitset(reached);
+    clearBitset(search->frontier);
+    setBit(reached,start);
+    setBit(search->frontier,start);
+    while(!isBitsetEmpty(search->frontier)){
+        clearBitset(search->next);
+        for(int u = nextSetBit(search->frontier,0) ; u >= 0 ; u = nextSetBit(search->frontier,u+1)){
+            int numNeighbours = backwards ? getNumPredecessors(search->graph,u) : getNumSuccessors(search->graph,u);
+            int *neighbours = backwards ? getPredecessors(search->graph,u) : getSuccessors(search->graph,u);
+            for(int e = 0 ; e < numNeighbours ; e++){
+                setBit(search->next,neighbours[e]);
+            }
+        }
+        differenceBitset(search->next,search->visited);
+        differenceBitset(search->next,reached);
+        distance++;
+        if(stopDistance < 0 && stop >= 0 && testBit(search->next,stop)){
+            stopDistance = distance;
+        }
+        unionBitset(reached,search->next);
+        copyBitset(search->frontier,search->next);
+    }
+    return stopDistance;
+}
+
+/**
+ * @brief A function extending the current path of @p search, which ends at @p node after @p depth edges, in every way that can still reach a wanted
+ *        length. The rest of the path goes from @p node to the target through nodes reachable from @p node and reaching the target without going
+ *        through the path: their number and the distance from @p node to the target bound the lengths the path can still reach.
+ * 
+ * @param search, The search.
+ * @param node, The last node of the current path.
+ * @param depth, The length of the current path.
+ */
+void searchSimplePaths(PathSearch *search, int node, int depth){
+    search->path[depth] = node;
+    if(node == search->target){
+        // A simple path ending at the target cannot go through it before.
+        if(search->wanted[depth]){
+            search->wanted[depth] = false;
+            search->found[depth] = true;
+            search->numWanted--;
+            if(search->solution != NULL){
+                memcpy(search->solution,search->path,sizeof(int)*(depth+1));
+            }
+        }
+        return;
+    }
+    if(search->numWanted == 0 || depth >= search->maxLength){
+        return;
+    }
+    if(isQueryBudgetExhausted()){
+        search->numWanted = 0; // The whole search gives up: the lengths not found yet are unknown.
+        return;
+    }
+    int distance = reachAvoidingPath(search,node,false,search->reached,search->target);
+    if(distance < 0){
+        return; // The target is not reachable any more.
+    }
+    reachAvoidingPath(search,search->target,true,search->coreached,-1);
+    intersectBitset(search->coreached,search->reached);
+    if(!isLengthWanted(search,depth+distance,depth+countBitset(search->coreached))){
+        return;
+    }
+    // The scratch sets are overwritten by the recursive calls, so the successors to extend the path with are listed first.
+    int *successors = getSuccessors(search->graph,node);
+    int candidates[getNumSuccessors(search->graph,node)+1];
+    int numCandidates = 0;
+    for(int e = 0 ; e < getNumSuccessors(search->graph,node) ; e++){
+        if(testBit(search->coreached,successors[e])){
+            candidates[numCandidates++] = successors[e];
+        }
+    }
+    for(int c = 0 ; c < numCandidates && search->numWanted > 0 ; c++){
+        setBit(search->visited,candidates[c]);
+        searchSimplePaths(search,candidates[c],depth+1);
+        resetBit(search->visited,candidates[c]);
+    }
+}
+
+/**
+ * @brief A function searching the simple paths from the source to the target of @p graph whose length is true in @p wanted.
+ * 
+ * @param graph, A graph.
+ * @param maxLength, The largest length searched.
+ * @param wanted, The array of @p maxLength+1 lengths searched. The lengths found are set to false.
+ * @param found, The array of @p maxLength+1 booleans in which the lengths found are set to true.
+ * @param solution, If not NULL, the array of size @p maxLength+1 in which the last path found is written.
+ */
+void searchGraphSimplePaths(Graph graph, int maxLength, bool *wanted, bool *found, int *solution){
+    int numNodes = orderG(graph);
+    int source = -1, target = -1;
+    for(int u = numNodes-1 ; u >= 0 ; u--){
+        if(isSource(graph,u)) source = u;
+        if(isTarget(graph,u)) target = u;
+    }
+    PathSearch search;
+    search.numWanted = 0;
+    for(int k = 0 ; k <= maxLength ; k++){
+        if(wanted[k]) search.numWanted++;
+    }
+    if(source < 0 || target < 0 || search.numWanted == 0){
+        return;
+    }
+    search.target = target;
+    search.maxLength = maxLength;
+    search.wanted = wanted;
+    search.found = found;
+    search.solution = solution;
+    search.path = (int*)malloc(sizeof(int)*(maxLength+2));
+    search.graph = graph;
+    if(search.path == NULL){
+        printf("Not enough memory to allocate search in searchGraphSimplePaths\n");
+        exit(EXIT_FAILURE);
+    }
+    search.visited = makeBitset(numNodes);
+    search.reached = makeBitset(numNodes);
+    search.coreached = makeBitset(numNodes);
+    search.frontier = makeBitset(numNodes);
+    search.next = makeBitset(numNodes);
+    setBit(search.visited,source);
+    // The search stands for the solver of the native engine in the statistics.
+    double start = getStatisticsClock();
+    searchSimplePaths(&search,source,0);
+    addPhaseTime(PHASE_SOLVE, start);
+    addSolverCall();
+    deleteBitset(search.visited);
+    deleteBitset(search.reached);
+    deleteBitset(search.coreached);
+    deleteBitset(search.frontier);
+    deleteBitset(search.next);
+    free(search.path);
+}
+
+bool *graphsToSimplePathLengths(Graph *graphs, unsigned int numGraphs, int maxLength){
+    // The lengths within the bounds (and of a common walk with the pruning) are the only candidates, then each graph only searches the lengths
+    // found in the previous ones.
+    bool* lengths = computeCandidateLengths(graphs,numGraphs,maxLength,pruning,NULL);
+    bool* found = (bool*)malloc(sizeof(bool)*(maxLength+2));
+    if(found == NULL){
+        printf("Not enough memory to allocate found in graphsToSimplePathLengths\n");
+        exit(EXIT_FAILURE);
+    }
+    for(unsigned int i = 0 ; i < numGraphs ; i++){
+        for(int k = 0 ; k <= maxLength ; k++){
+            found[k] = false;
+        }
+        searchGraphSimplePaths(graphs[i],maxLength,lengths,found,NULL);
+        bool* tmp = lengths;
+        lengths = found;
+        found = tmp;
+    }
+    free(found);
+    return lengths;
+}
+
+bool graphsHaveSimplePath(Graph *graphs, unsigned int numGraphs, int pathLength, int *paths){
+    if(pathLength < 0){
+        return false;
+    }
+    bool* wanted = (bool*)malloc(sizeof(bool)*(pathLength+2));
+    bool* found = (bool*)malloc(sizeof(bool)*(pathLength+2));
+    if(wanted == NULL || found == NULL){
+        printf("Not enough memory to allocate wanted in graphsHaveSimplePath\n");
+        exit(EXIT_FAILURE);
+    }
+    bool res = true;
+    for(unsigned int i = 0 ; i < numGraphs && res ; i++){
+        for(int k = 0 ; k <= pathLength ; k++){
+            wanted[k] = false;
+            found[k] = false;
+        }
+        wanted[pathLength] = true;
+        searchGraphSimplePaths(graphs[i],pathLength,wanted,found,paths == NULL ? NULL : paths+i*(pathLength+1));
+        res = found[pathLength];
+    }
+    free(wanted);
+    free(found);
+    return res;
+}
+
+/**
+ * @brief A function reading in @p model the paths of length @p pathLength of every graph of @p graphs.
+ * 
+ * @param ctx, The solver context.
+ * @param model, A variable assignment.
+ * @param graphs, An array of graphs.
+ * @param numGraph, The number of graphs in @p graphs.
+ * @param pathLength, The length of the paths.
+ * @return int*, The array of size numGraph*(pathLength+1) whose block i holds the path of graph i, to be freed with free.
+ */
+int *getPathsFromModel(Z3_context ctx, Z3_model model, Graph *graphs, int numGraph, int pathLength){
+    int* paths = (int*)malloc(sizeof(int)*(numGraph*(pathLength+1)+1));
+    if(paths == NULL){
+        printf("Not enough memory to allocate paths in getPathsFromModel\n");
+        exit(EXIT_FAILURE);
+    }
+    double start = getStatisticsClock();
+    // A model of the formula shared by all lengths selects pathLength, and gives the path with the shared variables.
+    int k = isVariableTrueInModel(ctx, model, getLengthSelector(ctx,pathLength)) ? ANY_LENGTH : pathLength;
+    for(int i = 0 ; i < numGraph ; i++){
+        getPathFromModel(ctx, model, graphs[i], i, pathLength, k, paths+i*(pathLength+1));
+    }
+    addPhaseTime(PHASE_DECODE, start);
+    return paths;
+}
+
+/**
+ * @brief Displays the path @p path of length @p pathLength of @p graph.
+ * 
+ * @param graph, A graph.
+ * @param pathLength, The length of path.
+ * @param path, The nodes of the path.
+ */
+void oneGraphPrintPath(Graph graph, int pathLength, int *path){
+    for(int k = 0 ; k < pathLength ; k++){
+        printf("%s -> ",getNodeName(graph,path[k]));
+    }
+    printf("%s;\n",getNodeName(graph,path[pathLength]));
+}
+
+void printPaths(Graph *graphs, int numGraph, int pathLength, int *paths){
+    for(int i = 0 ; i < numGraph ; i++ ){
+        printf("Chemin valide pour le graphe %d\n",i);
+        oneGraphPrintPath(graphs[i], pathLength, paths+i*(pathLength+1));
+    }
+}
+
+/**
+ * @brief Displays the paths of length @p pathLength of each graphs in @p graphs described by @p model.
+ * Affiche les chemins de longueur pathLength pour tous les graphes décrits dans model.
+ * 
+ * @param ctx, The solver context. 
+ * @param model, A variable assignment. 
+ * @param graphs, An array of graphs. 
+ * @param numGraph, The number of graphs in @p graphs. 
+ * @param pathLength, The length of path.
+ */
+void printPathsFromModel(Z3_context ctx, Z3_model model, Graph *graphs, int numGraph, int pathLength){
+    int* paths = getPathsFromModel(ctx, model, graphs, numGraph, pathLength);
+    printPaths(graphs, numGraph, pathLength, paths);
+    free(paths);
+}
+
+void createDotFromPaths(Graph *graphs, int numGraph, int pathLength, int *paths, char* name){
+    // Each graph is formatted in its own buffer, by its own thread for large graphs, and the standard output is never redirected.
+    if(!writeDotFile(graphs, numGraph, pathLength, paths, name, numGraph)){
+        printf("Could not write %s/%s-l%d.dot.\n", DOT_FOLDER, name, pathLength);
+    }
+}
+
+/**
+ * @brief Creates the file ("%s-l%d.dot",name,pathLength) representing the solution to the problem described by @p model, or ("result-l%d.dot,pathLength") if name is NULL.
+ * Crée le fichier représentant la solution du problème décrit par model, ou ("result-l%d.dot,pathLength") si name == NULL
+ * 
+ * @param ctx, The solver context.
+ * @param model, A variable assignment. 
+ * @param graphs, An array of graphs.
+ * @param numGraph, The number of graphs in @p graphs. 
+ * @param pathLength, The length of path. 
+ * @param name, The name of the output file. 
+ */
+void createDotFromModel(Z3_context ctx, Z3_model model, Graph *graphs, int numGraph, int pathLength, char* name){
+    int* paths = getPathsFromModel(ctx, model, graphs, numGraph, pathLength);
+    createDotFromPaths(graphs, numGraph, pathLength, paths, name);
+    free(paths);
 }
 
-#endif
 
 /*
 Minimum syndical : implémenter les fonctions getNodeVariable, getPathFormula
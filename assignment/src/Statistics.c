@@ -0,0 +1,164 @@
+#include "Statistics.h"
+#include "Z3Tools.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/** @brief The largest number of distinct keys of the Z3 statistics kept. */
+#define MAX_SOLVER_KEYS 256
+
+/**
+ * @brief A value of the Z3 statistics, summed over the solvers, or the largest one for the memory.
+ */
+typedef struct {
+    char key[64];       ///< The name of the value.
+    double value;       ///< The value.
+    bool isInteger;     ///< Tells if the value is an integer.
+} SolverKey;
+
+/**
+ * @brief The statistics of the run. The fields after @p lock are protected by it.
+ */
+typedef struct {
+    bool enabled;                                   ///< Tells if the statistics are gathered.
+    pthread_mutex_t lock;                           ///< The lock of the following fields.
+    double phaseSeconds[NUM_PHASES];                ///< The time spent in each phase.
+    long numFormulae[NUM_FORMULA_KINDS];            ///< The number of formulae of each kind.
+    long formulaTerms[NUM_FORMULA_KINDS];           ///< The number of distinct terms of the formulae of each kind.
+    long formulaVariables[NUM_FORMULA_KINDS];       ///< The number of variables of the formulae of each kind.
+    long numSolverCalls;                            ///< The number of calls to the solver.
+    long numSolvers;                                ///< The number of solvers whose statistics were added.
+    SolverKey solverKeys[MAX_SOLVER_KEYS];          ///< The statistics of the solvers.
+    int numSolverKeys;                              ///< The number of keys in @p solverKeys.
+} Statistics;
+
+/** @brief The statistics of the run, all zero until enableStatistics, which also initialises the lock. */
+static Statistics statistics;
+
+static const char *phaseNames[NUM_PHASES] = {"parse", "encode", "solve", "decode"};
+
+static const char *formulaNames[NUM_FORMULA_KINDS] = {"phi1", "phi2", "phi3", "phi4", "phi5", "phi6", "pruning", "unified"};
+
+void enableStatistics(void){
+    if(!statistics.enabled){
+        pthread_mutex_init(&statistics.lock, NULL);
+    }
+    statistics.enabled = true;
+}
+
+bool areStatisticsEnabled(void){
+    return statistics.enabled;
+}
+
+double getStatisticsClock(void){
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec+now.tv_nsec/1e9;
+}
+
+void addPhaseTime(StatisticsPhase phase, double start){
+    if(!statistics.enabled){
+        return;
+    }
+    double seconds = getStatisticsClock()-start;
+    pthread_mutex_lock(&statistics.lock);
+    statistics.phaseSeconds[phase] += seconds;
+    pthread_mutex_unlock(&statistics.lock);
+}
+
+void addFormulaStatistics(Z3_context ctx, FormulaKind kind, Z3_ast formula){
+    if(!statistics.enabled){
+        return;
+    }
+    long numVariables;
+    long numTerms = countFormulaNodes(ctx, formula, &numVariables);
+    pthread_mutex_lock(&statistics.lock);
+    statistics.numFormulae[kind]++;
+    statistics.formulaTerms[kind] += numTerms;
+    statistics.formulaVariables[kind] += numVariables;
+    pthread_mutex_unlock(&statistics.lock);
+}
+
+void addSolverCall(void){
+    if(!statistics.enabled){
+        return;
+    }
+    pthread_mutex_lock(&statistics.lock);
+    statistics.numSolverCalls++;
+    pthread_mutex_unlock(&statistics.lock);
+}
+
+void addSolverStatistics(Z3_context ctx, Z3_solver solver){
+    if(!statistics.enabled){
+        return;
+    }
+    Z3_stats stats = Z3_solver_get_statistics(ctx, solver);
+    Z3_stats_inc_ref(ctx, stats);
+    pthread_mutex_lock(&statistics.lock);
+    statistics.numSolvers++;
+    for(unsigned int i = 0 ; i < Z3_stats_size(ctx, stats) ; i++){
+        const char *key = Z3_stats_get_key(ctx, stats, i);
+        bool isInteger = Z3_stats_is_uint(ctx, stats, i);
+        double value = isInteger ? (double)Z3_stats_get_uint_value(ctx, stats, i) : Z3_stats_get_double_value(ctx, stats, i);
+        int k = 0;
+        while(k < statistics.numSolverKeys && strcmp(statistics.solverKeys[k].key, key) != 0){
+            k++;
+        }
+        if(k == statistics.numSolverKeys){
+            if(k == MAX_SOLVER_KEYS){
+                continue;
+            }
+            strncpy(statistics.solverKeys[k].key, key, sizeof(statistics.solverKeys[k].key)-1);
+            statistics.solverKeys[k].key[sizeof(statistics.solverKeys[k].key)-1] = '\0';
+            statistics.solverKeys[k].value = 0;
+            statistics.solverKeys[k].isInteger = isInteger;
+            statistics.numSolverKeys++;
+        }
+        if(strstr(key, "memory") != NULL){
+            // The memory is the one of the process, not of the solver: only its peak is meaningful.
+            if(value > statistics.solverKeys[k].value){
+                statistics.solverKeys[k].value = value;
+            }
+        }else{
+            statistics.solverKeys[k].value += value;
+        }
+    }
+    pthread_mutex_unlock(&statistics.lock);
+    Z3_stats_dec_ref(ctx, stats);
+}
+
+void printStatistics(FILE *file){
+    pthread_mutex_lock(&statistics.lock);
+    fprintf(file, "{\"phases\": {");
+    for(int p = 0 ; p < NUM_PHASES ; p++){
+        fprintf(file, "%s\"%s\": %.6f", p == 0 ? "" : ", ", phaseNames[p], statistics.phaseSeconds[p]);
+    }
+    long numFormulae = 0, numTerms = 0, numVariables = 0;
+    for(int f = 0 ; f < NUM_FORMULA_KINDS ; f++){
+        numFormulae += statistics.numFormulae[f];
+        numTerms += statistics.formulaTerms[f];
+        numVariables += statistics.formulaVariables[f];
+    }
+    fprintf(file, "}, \"counters\": {\"solver_calls\": %ld, \"solvers\": %ld, \"formulae\": %ld, \"terms\": %ld, \"variables\": %ld}, \"formulae\": {",
+            statistics.numSolverCalls, statistics.numSolvers, numFormulae, numTerms, numVariables);
+    bool first = true;
+    for(int f = 0 ; f < NUM_FORMULA_KINDS ; f++){
+        if(statistics.numFormulae[f] == 0){
+            continue;
+        }
+        fprintf(file, "%s\"%s\": {\"count\": %ld, \"terms\": %ld, \"variables\": %ld}", first ? "" : ", ", formulaNames[f], statistics.numFormulae[f],
+                statistics.formulaTerms[f], statistics.formulaVariables[f]);
+        first = false;
+    }
+    fprintf(file, "}, \"z3\": {");
+    for(int k = 0 ; k < statistics.numSolverKeys ; k++){
+        fprintf(file, "%s\"", k == 0 ? "" : ", ");
+        for(const char *c = statistics.solverKeys[k].key ; *c != '\0' ; c++){
+            fputc(*c == '"' || *c == '\\' ? '_' : *c, file);
+        }
+        fprintf(file, statistics.solverKeys[k].isInteger ? "\": %.0f" : "\": %.6f", statistics.solverKeys[k].value);
+    }
+    fprintf(file, "}}\n");
+    pthread_mutex_unlock(&statistics.lock);
+}
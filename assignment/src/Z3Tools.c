@@ -1,8 +1,11 @@
 
 #include "Z3Tools.h"
+#include "Statistics.h"
+#include "Budget.h"
 #include <stdlib.h>
 #include <stdio.h>
 #include <stdbool.h>
+#include <string.h>
 
 Z3_context makeContext(void) {
     Z3_config config = Z3_mk_config();
@@ -24,27 +27,25 @@ Z3_ast mk_bool_var(Z3_context ctx, const char * name)
 }
 
 Z3_lbool isFormulaSat(Z3_context ctx, Z3_ast formula){
-    Z3_solver s = Z3_mk_solver(ctx);
-    Z3_solver_inc_ref(ctx, s);
+    Z3_solver s = makeSolver(ctx);
     Z3_solver_assert(ctx,s,formula);
 
-    Z3_lbool result =  Z3_solver_check(ctx, s);
-    Z3_solver_dec_ref(ctx, s);
+    Z3_lbool result =  checkSolver(ctx, s);
+    deleteSolver(ctx, s);
     return result;
 }
 
 Z3_model getModelFromSatFormula(Z3_context ctx, Z3_ast formula){
-    Z3_solver s = Z3_mk_solver(ctx);
-    Z3_solver_inc_ref(ctx, s);
+    Z3_solver s = makeSolver(ctx);
     Z3_solver_assert(ctx,s,formula);
 
     Z3_model m      = 0;
-    Z3_lbool result = Z3_solver_check(ctx, s);
+    Z3_lbool result = checkSolver(ctx, s);
 
     switch (result) {
     case Z3_L_FALSE:
         fprintf(stderr,"Error: Trying to get a model from an unsat formula.\n");
-        Z3_solver_dec_ref(ctx, s);
+        deleteSolver(ctx, s);
         exit(1);
     case Z3_L_UNDEF:
         printf("Warning: Getting a partial model from a formula of unknown satisfiability.\n");
@@ -55,7 +56,136 @@ Z3_model getModelFromSatFormula(Z3_context ctx, Z3_ast formula){
 
     m = Z3_solver_get_model(ctx, s);
     if (m) Z3_model_inc_ref(ctx, m);
-    Z3_solver_dec_ref(ctx, s);
+    deleteSolver(ctx, s);
+    return m;
+}
+
+/** @brief The limits of a check given by setSolverLimits, 0 for none: time in milliseconds, memory in megabytes and conflicts. They are shared by all
+ *         threads without a lock, so they are only written before the threads are started. */
+static unsigned int solverTimeout = 0, solverMaxMemory = 0, solverMaxConflicts = 0;
+
+/** @brief The reason of the last Z3_L_UNDEF answered in the current thread. */
+static __thread char unknownReason[128] = "unknown";
+
+void setSolverLimits(unsigned int timeout, unsigned int maxMemory, unsigned int maxConflicts){
+    solverTimeout = timeout;
+    solverMaxMemory = maxMemory;
+    solverMaxConflicts = maxConflicts;
+}
+
+/**
+ * @brief Gives to @p solver the limits set by setSolverLimits, if there are some, the time of the check being also bounded by @p remaining.
+ *
+ * @param ctx The context of the solver.
+ * @param solver A solver.
+ * @param remaining The time left in the budget of the query in milliseconds, 0 for no bound.
+ */
+static void setSolverParams(Z3_context ctx, Z3_solver solver, unsigned int remaining){
+    unsigned int timeout = solverTimeout;
+    if(remaining > 0 && (timeout == 0 || remaining < timeout)){
+        timeout = remaining;
+    }
+    if(timeout == 0 && solverMaxMemory == 0 && solverMaxConflicts == 0){
+        return;
+    }
+    Z3_params params = Z3_mk_params(ctx);
+    Z3_params_inc_ref(ctx, params);
+    if(timeout > 0){
+        Z3_params_set_uint(ctx, params, Z3_mk_string_symbol(ctx, "timeout"), timeout);
+    }
+    if(solverMaxMemory > 0){
+        Z3_params_set_uint(ctx, params, Z3_mk_string_symbol(ctx, "max_memory"), solverMaxMemory);
+    }
+    if(solverMaxConflicts > 0){
+        // The formulae are propositional: the check runs either in the SMT core or in the SAT solver, each with its own counter.
+        Z3_params_set_uint(ctx, params, Z3_mk_string_symbol(ctx, "max_conflicts"), solverMaxConflicts);
+        Z3_params_set_uint(ctx, params, Z3_mk_string_symbol(ctx, "sat.max_conflicts"), solverMaxConflicts);
+    }
+    Z3_solver_set_params(ctx, solver, params);
+    Z3_params_dec_ref(ctx, params);
+}
+
+/**
+ * @brief Keeps the reason given by @p solver for its last answer if it is Z3_L_UNDEF.
+ *
+ * @param ctx The context of the solver.
+ * @param solver A solver.
+ * @param result The answer of its last check.
+ */
+static void keepUnknownReason(Z3_context ctx, Z3_solver solver, Z3_lbool result){
+    if(result != Z3_L_UNDEF){
+        return;
+    }
+    strncpy(unknownReason, Z3_solver_get_reason_unknown(ctx, solver), sizeof(unknownReason)-1);
+    unknownReason[sizeof(unknownReason)-1] = '\0';
+}
+
+const char *getUnknownReason(void){
+    return unknownReason;
+}
+
+/**
+ * @brief Prepares @p solver for a check within the budget of the query, if there is one: its time is bounded by the time left, given again before
+ *        each check.
+ *
+ * @param ctx The context of the solver.
+ * @param solver A solver.
+ * @return bool false if the budget has run out, in which case the check answers Z3_L_UNDEF without solving.
+ */
+static bool prepareCheck(Z3_context ctx, Z3_solver solver){
+    if(!hasQueryBudget()){
+        return true;
+    }
+    // The clock is read once: a budget running out after a test would otherwise give a check without any bound.
+    unsigned int remaining = getRemainingQueryBudget();
+    if(remaining == 0){
+        strcpy(unknownReason, BUDGET_EXHAUSTED_REASON);
+        return false;
+    }
+    setSolverParams(ctx, solver, remaining);
+    return true;
+}
+
+Z3_solver makeSolver(Z3_context ctx){
+    Z3_solver s = Z3_mk_solver(ctx);
+    Z3_solver_inc_ref(ctx, s);
+    // The budget of the query, if any, is given by prepareCheck before each check.
+    setSolverParams(ctx, s, 0);
+    return s;
+}
+
+void deleteSolver(Z3_context ctx, Z3_solver solver){
+    addSolverStatistics(ctx, solver);
+    Z3_solver_dec_ref(ctx, solver);
+}
+
+Z3_lbool checkSolver(Z3_context ctx, Z3_solver solver){
+    if(!prepareCheck(ctx, solver)){
+        return Z3_L_UNDEF;
+    }
+    double start = getStatisticsClock();
+    Z3_lbool result = Z3_solver_check(ctx, solver);
+    addPhaseTime(PHASE_SOLVE, start);
+    addSolverCall();
+    keepUnknownReason(ctx, solver, result);
+    return result;
+}
+
+Z3_lbool isSatUnderAssumptions(Z3_context ctx, Z3_solver solver, unsigned int numAssumptions, Z3_ast *assumptions){
+    if(!prepareCheck(ctx, solver)){
+        return Z3_L_UNDEF;
+    }
+    double start = getStatisticsClock();
+    Z3_lbool result = Z3_solver_check_assumptions(ctx, solver, numAssumptions, assumptions);
+    addPhaseTime(PHASE_SOLVE, start);
+    addSolverCall();
+    keepUnknownReason(ctx, solver, result);
+    return result;
+}
+
+Z3_model getModelFromSolver(Z3_context ctx, Z3_solver solver){
+    Z3_model m = Z3_solver_get_model(ctx, solver);
+    if (m) Z3_model_inc_ref(ctx, m);
     return m;
 }
 
@@ -70,3 +200,69 @@ bool valueOfVarInModel(Z3_context ctx, Z3_model model, Z3_ast variable){
     exit(1);
 }
 
+bool isVariableTrueInModel(Z3_context ctx, Z3_model model, Z3_ast variable){
+    Z3_ast value = Z3_model_get_const_interp(ctx,model,Z3_get_app_decl(ctx,Z3_to_app(ctx,variable)));
+    return value != NULL && Z3_get_bool_value(ctx,value) == Z3_L_TRUE;
+}
+
+long countFormulaNodes(Z3_context ctx, Z3_ast formula, long *numVariables){
+    // The terms already counted, by identifier, and the terms still to visit.
+    unsigned int numSeen = 1024, numStack = 1024, stackSize = 0;
+    char *seen = (char*)calloc(numSeen,1);
+    Z3_ast *stack = (Z3_ast*)malloc(sizeof(Z3_ast)*numStack);
+    if(seen == NULL || stack == NULL){
+        printf("Not enough memory to allocate stack in countFormulaNodes\n");
+        exit(EXIT_FAILURE);
+    }
+    long count = 0, variables = 0;
+    stack[stackSize++] = formula;
+    while(stackSize > 0){
+        Z3_ast term = stack[--stackSize];
+        unsigned int id = Z3_get_ast_id(ctx,term);
+        if(id >= numSeen){
+            unsigned int size = numSeen;
+            while(id >= size){
+                size *= 2;
+            }
+            seen = (char*)realloc(seen,size);
+            if(seen == NULL){
+                printf("Not enough memory to allocate seen in countFormulaNodes\n");
+                exit(EXIT_FAILURE);
+            }
+            memset(seen+numSeen,0,size-numSeen);
+            numSeen = size;
+        }
+        if(seen[id]){
+            continue;
+        }
+        seen[id] = 1;
+        count++;
+        if(Z3_get_ast_kind(ctx,term) != Z3_APP_AST){
+            continue;
+        }
+        Z3_app app = Z3_to_app(ctx,term);
+        unsigned int numArgs = Z3_get_app_num_args(ctx,app);
+        if(numArgs == 0 && Z3_get_decl_kind(ctx,Z3_get_app_decl(ctx,app)) == Z3_OP_UNINTERPRETED){
+            variables++;
+        }
+        if(stackSize+numArgs > numStack){
+            while(stackSize+numArgs > numStack){
+                numStack *= 2;
+            }
+            stack = (Z3_ast*)realloc(stack,sizeof(Z3_ast)*numStack);
+            if(stack == NULL){
+                printf("Not enough memory to allocate stack in countFormulaNodes\n");
+                exit(EXIT_FAILURE);
+            }
+        }
+        for(unsigned int i = 0 ; i < numArgs ; i++){
+            stack[stackSize++] = Z3_get_app_arg(ctx,app,i);
+        }
+    }
+    free(seen);
+    free(stack);
+    if(numVariables != NULL){
+        *numVariables = variables;
+    }
+    return count;
+}
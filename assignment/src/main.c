@@ -9,6 +9,14 @@
 #include <string.h>
 #include <math.h>
 #include "Solving.h"
+#include "ParallelSolving.h"
+#include "GraphCache.h"
+#include "CdclSolving.h"
+#include "DotWriter.h"
+#include "Batch.h"
+#include "Statistics.h"
+#include "Bounds.h"
+#include "Budget.h"
 
 #define mini(a,b) (a<=b?a:b)
 #define MAX_NAME_LENGTH 50
@@ -20,10 +28,41 @@ bool DEFAULT_DISP_P = false;
 bool DEFAULT_DISP_s = false;
 bool DEFAULT_DISP_d = false;
 bool DEFAULT_DISP_a = false;
+bool DEFAULT_DISP_i = false;
 bool DEFAULT_DISP_o = false;
+bool DEFAULT_NATIVE = false;
+bool DEFAULT_CDCL = false;
+int DEFAULT_NUM_THREADS = 1;
+bool DEFAULT_PORTFOLIO = false;
+bool DEFAULT_SEPARATE = false;
+bool DEFAULT_COMPILE = false;
 char DEFAULT_FILE_NAME[MAX_NAME_LENGTH] = "result";
+char *DEFAULT_BATCH = NULL;
+char *DEFAULT_STATS_FILE = NULL;
+unsigned int DEFAULT_TIMEOUT = 0;
+unsigned int DEFAULT_MEMORY = 0;
+unsigned int DEFAULT_CONFLICTS = 0;
+unsigned int DEFAULT_BUDGET = 0;
 int numArg = 1;
 
+/**
+ * @brief A function displaying the paths described by a model according to the different option given.
+ * 
+ * @param ctx, The solver context.
+ * @param model, A variable assignment.
+ * @param graphs, An array of graphs.
+ * @param numGraph, The number of graphs in @p graphs.
+ * @param pathLength, The length of the paths described by @p model.
+ */
+void displayModel(Z3_context ctx, Z3_model model, Graph * graphs, int numGraph, int pathLength){
+    if(DEFAULT_DISP_P){
+        printPathsFromModel( ctx, model, graphs, numGraph, pathLength);
+    }
+    if(DEFAULT_DISP_f){
+        createDotFromModel(ctx, model, graphs, numGraph, pathLength, DEFAULT_FILE_NAME);
+    }
+}
+
 /**
  * @brief A function testing if the given formula is SAT and will apply the different option given.
  * 
@@ -31,22 +70,31 @@ int numArg = 1;
  * @param formula, A Z3_ast formula
  * @param graphs, An array of graphs.
  * @param numGraph, The number of graphs in @p graphs.
- * @return A boolean indicating if the formula was SAT or not.
+ * @param pathLength, The length checked by @p formula, or ANY_LENGTH if it is the formula of every length, whose model tells the length.
+ * @return The answer: LENGTH_SAT, LENGTH_UNSAT, or LENGTH_UNDEF if the solver could not decide, for instance when a limit ran out.
  */
-bool SAT(Z3_context ctx, Z3_ast formula, Graph * graphs, int numGraph){
+LengthResult SAT(Z3_context ctx, Z3_ast formula, Graph * graphs, int numGraph, int pathLength){
     if(formula==NULL){
         printf("Non\n");
-        return false;
+        return LENGTH_UNSAT;
     }
-    Z3_lbool isSat = isFormulaSat(ctx,formula);
-    switch (isSat){
+    // A single solver both decides the formula and gives the model of the paths.
+    Z3_solver solver = makeSolver(ctx);
+    Z3_solver_assert(ctx, solver, formula);
+    LengthResult res = LENGTH_UNSAT;
+    switch (checkSolver(ctx, solver)){
         case Z3_L_FALSE:
             printf("Non\n");
-            return false;
+            break;
 
         case Z3_L_UNDEF:
-            printf("We don't know if %s is satisfiable.\n",Z3_ast_to_string(ctx,formula));
-            return false;
+            if(pathLength == ANY_LENGTH){
+                printf("We don't know if the formula is satisfiable (%s).\n",getUnknownReason());
+            }else{
+                printf("We don't know if the formula of length %d is satisfiable (%s).\n",pathLength,getUnknownReason());
+            }
+            res = LENGTH_UNDEF;
+            break;
 
         case Z3_L_TRUE:
             if(DEFAULT_DISP_F){
@@ -54,18 +102,435 @@ bool SAT(Z3_context ctx, Z3_ast formula, Graph * graphs, int numGraph){
             }
             printf("Oui\n");
             
-            if(DEFAULT_DISP_P){
-                Z3_model model = getModelFromSatFormula(ctx, formula);
-                int k = getSolutionLengthFromModel(ctx,model,graphs);
-                printPathsFromModel( ctx, model, graphs, numGraph, k);
+            if(DEFAULT_DISP_P || DEFAULT_DISP_f){
+                Z3_model model = getModelFromSolver(ctx, solver);
+                int k = pathLength == ANY_LENGTH ? getSolutionLengthFromModel(ctx,model,graphs) : pathLength;
+                displayModel(ctx, model, graphs, numGraph, k);
+                Z3_model_dec_ref(ctx, model);
+            }
+            res = LENGTH_SAT;
+            break;
+    }
+    deleteSolver(ctx, solver);
+    return res;
+}
+
+/**
+ * @brief A function testing if all graphs contain a path of length @p pathLength with the incremental solver, and will apply the different option given.
+ *        This length is excluded afterwards, since each length is only checked once.
+ * 
+ * @param ctx, The solver context.
+ * @param solver, The solver of the current window of lengths.
+ * @param formula, The formula shared by the lengths of the window, added to @p solver.
+ * @param graphs, An array of graphs.
+ * @param numGraph, The number of graphs in @p graphs.
+ * @param pathLength, The length to check.
+ * @return The answer: LENGTH_SAT, LENGTH_UNSAT, or LENGTH_UNDEF if the solver could not decide.
+ */
+LengthResult incrementalSAT(Z3_context ctx, Z3_solver solver, Z3_ast formula, Graph * graphs, int numGraph, int pathLength){
+    LengthResult res = LENGTH_UNSAT;
+    switch (isPathLengthSat(ctx, solver, pathLength)){
+        case Z3_L_FALSE:
+            printf("Non\n");
+            break;
+
+        case Z3_L_UNDEF:
+            printf("We don't know if the formula of length %d is satisfiable (%s).\n",pathLength,getUnknownReason());
+            res = LENGTH_UNDEF;
+            break;
+
+        case Z3_L_TRUE:
+            if(DEFAULT_DISP_F){
+                printf("%s \n",Z3_ast_to_string(ctx,formula));
+            }
+            printf("Oui\n");
+
+            if(DEFAULT_DISP_P || DEFAULT_DISP_f){
+                Z3_model model = getModelFromSolver(ctx, solver);
+                displayModel(ctx, model, graphs, numGraph, pathLength);
+                Z3_model_dec_ref(ctx, model);
+            }
+            res = LENGTH_SAT;
+            break;
+    }
+    retractPathFormulaFromSolver(ctx, solver, pathLength);
+    return res;
+}
+
+/**
+ * @brief A function checking a single length of the exploration by depth, with the incremental solver if there is one.
+ * 
+ * @param ctx, The solver context.
+ * @param window, The window of the incremental solver kept for the exploration, or NULL to use a new formula and solver for each length.
+ * @param graphs, An array of graphs.
+ * @param numGraph, The number of graphs in @p graphs.
+ * @param pathLength, The length to check.
+ * @param maxK, The number of lengths.
+ * @param lengths, The candidate lengths given by computeCandidateLengths, or NULL. The other lengths are answered without solving.
+ * @return The answer: LENGTH_SAT, LENGTH_UNSAT, or LENGTH_UNDEF if the solver could not decide or the budget of the query has run out.
+ */
+LengthResult depthSAT(Z3_context ctx, LengthWindow *window, Graph * graphs, int numGraph, int pathLength, int maxK, bool *lengths){
+    if(lengths != NULL && !lengths[pathLength]){
+        printf("Pour k = %d : \n",pathLength);
+        printf("Non\n");
+        return LENGTH_UNSAT;
+    }
+    if(isQueryBudgetExhausted()){
+        // The formula of the length is not even built.
+        printf("Pour k = %d : \n",pathLength);
+        printf("We don't know if the formula of length %d is satisfiable (%s).\n",pathLength,BUDGET_EXHAUSTED_REASON);
+        return LENGTH_UNDEF;
+    }
+    if(window != NULL){
+        Z3_solver solver = getLengthWindowSolver(ctx,window,graphs,numGraph,pathLength,0,maxK-1,DEFAULT_DISP_d);
+        printf("Pour k = %d : \n",pathLength);
+        return incrementalSAT(ctx, solver, window->formula, graphs, numGraph, pathLength);
+    }
+    Z3_ast formula = graphsToPathFormula(ctx,graphs,numGraph,pathLength);
+    printf("Pour k = %d : \n",pathLength);
+    return SAT(ctx,formula,graphs,numGraph,pathLength);
+}
+
+/**
+ * @brief A function displaying the paths @p paths of length @p pathLength according to the different option given.
+ * 
+ * @param graphs, An array of graphs.
+ * @param numGraph, The number of graphs in @p graphs.
+ * @param pathLength, The length of the paths.
+ * @param paths, The paths, the one of graph i starting at index i*(@p pathLength+1).
+ */
+void displayPaths(Graph * graphs, int numGraph, int pathLength, int *paths){
+    if(DEFAULT_DISP_P){
+        printPaths(graphs, numGraph, pathLength, paths);
+    }
+    if(DEFAULT_DISP_f){
+        createDotFromPaths(graphs, numGraph, pathLength, paths, DEFAULT_FILE_NAME);
+    }
+}
+
+/**
+ * @brief A function displaying on a line the lengths up to @p maxK-1 whose answer in @p results is @p result, or @p other.
+ * 
+ * @param label, The beginning of the line.
+ * @param maxK, The number of lengths.
+ * @param results, The answer for each length.
+ * @param result, The answer of the lengths displayed.
+ * @param other, Another answer of the lengths displayed.
+ */
+void displayLengthsWithResult(const char *label, int maxK, LengthResult *results, LengthResult result, LengthResult other){
+    bool first = true;
+    printf("%s",label);
+    for(int k = 0 ; k < maxK ; k++){
+        if(results[k] == result || results[k] == other){
+            printf(first ? " %d" : ", %d",k);
+            first = false;
+        }
+    }
+    printf(first ? " none\n" : "\n");
+}
+
+/**
+ * @brief A function displaying, when the solver could not decide some lengths (for instance because a limit given by --timeout, --memory,
+ *        --conflicts or --budget ran out), the lengths proven and refuted so far. Nothing is displayed if every length checked was decided.
+ * 
+ * @param maxK, The number of lengths.
+ * @param results, The answer for each length.
+ */
+void displayPartialResults(int maxK, LengthResult *results){
+    bool undecided = false;
+    for(int k = 0 ; k < maxK ; k++){
+        undecided = undecided || results[k] == LENGTH_UNDEF;
+    }
+    if(!undecided){
+        return;
+    }
+    printf("Partial answer, some lengths could not be decided:\n");
+    displayLengthsWithResult("Oui for k =",maxK,results,LENGTH_SAT,LENGTH_SAT);
+    displayLengthsWithResult("Non for k =",maxK,results,LENGTH_UNSAT,LENGTH_UNSAT);
+    displayLengthsWithResult("Unknown for k =",maxK,results,LENGTH_UNDEF,LENGTH_UNDEF);
+    displayLengthsWithResult("Not checked for k =",maxK,results,LENGTH_UNKNOWN,LENGTH_CANCELLED);
+}
+
+/**
+ * @brief A function displaying the answers of an exploration by depth in the order of the exploration. The .dot files of the lengths found are
+ *        written at the end, several at the same time.
+ * 
+ * @param graphs, An array of graphs.
+ * @param numGraph, The number of graphs in @p graphs.
+ * @param maxK, The number of lengths.
+ * @param results, The answer for each length.
+ */
+void displaySweepResults(Graph * graphs, int numGraph, int maxK, SweepResults results){
+    int numFiles = 0;
+    int fileLengths[maxK+1];
+    int *filePaths[maxK+1];
+    for(int j = 0 ; j < maxK ; j++){
+        int i = DEFAULT_DISP_d ? maxK-1-j : j;
+        printf("Pour k = %d : \n",i);
+        if(results.results[i] == LENGTH_SAT){
+            printf("Oui\n");
+            if(results.paths[i] != NULL && DEFAULT_DISP_P){
+                printPaths(graphs, numGraph, i, results.paths[i]);
+            }
+            if(results.paths[i] != NULL && DEFAULT_DISP_f){
+                fileLengths[numFiles] = i;
+                filePaths[numFiles++] = results.paths[i];
             }
-            if(DEFAULT_DISP_f){
-                Z3_model model = getModelFromSatFormula(ctx, formula);
-                int k = getSolutionLengthFromModel(ctx,model,graphs);
-                createDotFromModel(ctx, model, graphs, numGraph, k, DEFAULT_FILE_NAME);
+            if(DEFAULT_DISP_a == false){
+                break;
+            }
+        }else if(results.results[i] == LENGTH_UNSAT){
+            printf("Non\n");
+        }else{
+            printf("We don't know if the formula of length %d is satisfiable.\n",i);
+        }
+    }
+    displayPartialResults(maxK, results.results);
+    if(numFiles > 0){
+        int numThreads = DEFAULT_NUM_THREADS > 0 ? DEFAULT_NUM_THREADS : getNumProcessors();
+        int numWritten = writeDotFiles(graphs, numGraph, numFiles, fileLengths, filePaths, DEFAULT_FILE_NAME, numThreads);
+        if(numWritten < numFiles){
+            printf("Could not write %d of the .dot files in %s.\n", numFiles-numWritten, DOT_FOLDER);
+        }
+    }
+}
+
+/**
+ * @brief A function running the exploration by depth with several threads, and displaying its answers in the order of the exploration.
+ * 
+ * @param graphs, An array of graphs.
+ * @param numGraph, The number of graphs in @p graphs.
+ * @param maxK, The number of lengths.
+ */
+void parallelDepthSAT(Graph * graphs, int numGraph, int maxK){
+    int numThreads = DEFAULT_NUM_THREADS > 0 ? DEFAULT_NUM_THREADS : getNumProcessors();
+    SweepResults results = parallelSweep(graphs, numGraph, maxK-1, DEFAULT_DISP_d, DEFAULT_DISP_a, DEFAULT_DISP_i, DEFAULT_DISP_P || DEFAULT_DISP_f, numThreads);
+    displaySweepResults(graphs, numGraph, maxK, results);
+    deleteSweepResults(results);
+}
+
+/**
+ * @brief A function computing the lengths of each graph separately before intersecting them, and will apply the different option given.
+ *        With -s, every length is displayed in the order of the exploration, otherwise the lengths are the ones of the global formula.
+ * 
+ * @param graphs, An array of graphs.
+ * @param numGraph, The number of graphs in @p graphs.
+ * @param maxK, The number of lengths.
+ * @return A boolean indicating if the graphs have a common path.
+ */
+bool separableSAT(Graph * graphs, int numGraph, int maxK){
+    int numThreads = DEFAULT_NUM_THREADS > 0 ? DEFAULT_NUM_THREADS : getNumProcessors();
+    int minLength = DEFAULT_DISP_s ? 0 : 1;
+    SweepResults results = separableSolve(graphs, numGraph, minLength, maxK-1, DEFAULT_DISP_s, DEFAULT_DISP_P || DEFAULT_DISP_f, numThreads);
+    bool found = false, unknown = false;
+    if(DEFAULT_DISP_s){
+        displaySweepResults(graphs, numGraph, maxK, results);
+    }
+    for(int k = minLength ; k < maxK && !found ; k++){
+        found = results.results[k] == LENGTH_SAT;
+        unknown = unknown || results.results[k] == LENGTH_UNDEF;
+        if(found && !DEFAULT_DISP_s){
+            printf("Oui\n");
+            if(results.paths[k] != NULL){
+                displayPaths(graphs, numGraph, k, results.paths[k]);
+            }
+        }
+    }
+    if(!found && !DEFAULT_DISP_s){
+        printf(unknown ? "We don't know if the formula is satisfiable.\n" : "Non\n");
+        displayPartialResults(maxK, results.results);
+    }
+    deleteSweepResults(results);
+    return found;
+}
+
+/**
+ * @brief A function displaying what is known when the global formula could not be decided: the lengths outside the bounds, or without a walk in
+ *        some graph with the pruning, are refuted without solving, the other ones are unknown.
+ * 
+ * @param graphs, An array of graphs.
+ * @param numGraph, The number of graphs in @p graphs.
+ * @param maxK, The number of lengths.
+ */
+void displayGlobalPartialResults(Graph * graphs, int numGraph, int maxK){
+    bool *lengths = computeCandidateLengths(graphs,numGraph,maxK-1,getPruning(),NULL);
+    LengthResult results[maxK];
+    results[0] = LENGTH_UNKNOWN;
+    for(int k = 1 ; k < maxK ; k++){
+        results[k] = lengths[k] ? LENGTH_UNDEF : LENGTH_UNSAT;
+    }
+    free(lengths);
+    displayPartialResults(maxK, results);
+}
+
+/**
+ * @brief A function answering with the portfolio, and will apply the different option given.
+ * 
+ * @param graphs, An array of graphs.
+ * @param numGraph, The number of graphs in @p graphs.
+ * @return A boolean indicating if the graphs have a common path.
+ */
+bool portfolioSAT(Graph * graphs, int numGraph){
+    PortfolioResult result = portfolioSolve(graphs, numGraph, DEFAULT_DISP_P || DEFAULT_DISP_f);
+    switch(result.result){
+        case LENGTH_SAT:
+            printf("Oui\n");
+            if(result.paths != NULL){
+                displayPaths(graphs, numGraph, result.pathLength, result.paths);
             }
-            return true;
+            break;
+
+        case LENGTH_UNSAT:
+            printf("Non\n");
+            break;
+
+        default:
+            printf("We don't know if the formula is satisfiable.\n");
+            break;
+    }
+    if(result.winner >= 0){
+        printf("Answered by the configuration %s.\n",getPortfolioConfigurationName(result.winner));
+    }
+    free(result.paths);
+    return result.result == LENGTH_SAT;
+}
+
+/**
+ * @brief A function deciding without Z3 if every graph has a path of length @p pathLength, with the engine chosen by --engine.
+ * 
+ * @param graphs, An array of graphs.
+ * @param numGraph, The number of graphs in @p graphs.
+ * @param pathLength, The length to check.
+ * @param paths, If not NULL, the array receiving the paths.
+ * @return A boolean indicating if all graphs have a path of this length, false if the budget of the query ran out first.
+ */
+bool engineHasPath(Graph * graphs, int numGraph, int pathLength, int *paths){
+    if(DEFAULT_CDCL){
+        return cdclGraphsHavePath(graphs, numGraph, pathLength, paths);
+    }
+    return graphsHaveSimplePath(graphs, numGraph, pathLength, paths);
+}
+
+/**
+ * @brief A function searching without Z3 a path of length @p pathLength in every graph, and will apply the different option given.
+ * 
+ * @param graphs, An array of graphs.
+ * @param numGraph, The number of graphs in @p graphs.
+ * @param lengths, The only lengths which may have a path in every graph, or NULL.
+ * @param pathLength, The length to check.
+ * @return The answer: LENGTH_SAT, LENGTH_UNSAT, or LENGTH_UNDEF if the budget of the query has run out.
+ */
+LengthResult nativeSAT(Graph * graphs, int numGraph, bool *lengths, int pathLength){
+    if(lengths != NULL && !lengths[pathLength]){
+        printf("Non\n");
+        return LENGTH_UNSAT;
+    }
+    if(isQueryBudgetExhausted()){
+        printf("We don't know if the formula of length %d is satisfiable (%s).\n",pathLength,BUDGET_EXHAUSTED_REASON);
+        return LENGTH_UNDEF;
+    }
+    int* paths = (int*)malloc(sizeof(int)*(numGraph*(pathLength+1)+1));
+    if(paths == NULL){
+        printf("Not enough memory to allocate paths in nativeSAT\n");
+        exit(EXIT_FAILURE);
+    }
+    LengthResult res = LENGTH_UNSAT;
+    if(engineHasPath(graphs, numGraph, pathLength, paths)){
+        printf("Oui\n");
+        displayPaths(graphs, numGraph, pathLength, paths);
+        res = LENGTH_SAT;
+    }else if(isQueryBudgetExhausted()){
+        // The engine gave up: its negative answer is not a proof.
+        printf("We don't know if the formula of length %d is satisfiable (%s).\n",pathLength,BUDGET_EXHAUSTED_REASON);
+        res = LENGTH_UNDEF;
+    }else{
+        printf("Non\n");
+    }
+    free(paths);
+    return res;
+}
+
+/**
+ * @brief A function loading a graph from a graph file, or from its compiled file when it is not older than the graph file. A compiled file can also be
+ *        given directly.
+ * 
+ * @param fileName, The name of the file.
+ * @return The graph.
+ */
+Graph loadGraph(char *fileName){
+    Graph graph;
+    if(isGraphCacheName(fileName)){
+        if(!loadGraphCache(fileName,&graph)){
+            printf("file %s is not a compiled graph of version %d. Exiting.\n",fileName,GRAPH_CACHE_VERSION);
+            exit(EXIT_FAILURE);
+        }
+        return graph;
+    }
+    if(isGraphCacheFresh(fileName)){
+        char *cacheName = getGraphCacheName(fileName);
+        bool loaded = loadGraphCache(cacheName,&graph);
+        free(cacheName);
+        if(loaded){
+            return graph;
+        }
+    }
+    return getGraphFromFile(fileName);
+}
+
+/**
+ * @brief A function compiling each graph file into a binary file next to it, read instead of the graph file by the next runs.
+ * 
+ * @param fileNames, The names of the graph files.
+ * @param numFiles, The number of files.
+ */
+void compileGraphs(char **fileNames, int numFiles){
+    for(int i = 0 ; i < numFiles ; i++){
+        Graph graph = getGraphFromFile(fileNames[i]);
+        char *cacheName = getGraphCacheName(fileNames[i]);
+        if(writeGraphCache(graph,cacheName)){
+            printf("Compiled %s into %s.\n",fileNames[i],cacheName);
+        }else{
+            printf("Could not write %s.\n",cacheName);
+        }
+        free(cacheName);
+        deleteGraph(graph);
+    }
+}
+
+/**
+ * @brief A function answering every instance under @p folder with the engine chosen by --engine, and displaying how many got each answer.
+ * 
+ * @param folder, The root of the instances.
+ */
+void batchSAT(char *folder){
+    int numThreads = DEFAULT_NUM_THREADS > 0 ? DEFAULT_NUM_THREADS : getNumProcessors();
+    BatchEngine engine = DEFAULT_CDCL ? BATCH_CDCL : DEFAULT_NATIVE ? BATCH_NATIVE : BATCH_Z3;
+    BatchSummary summary = solveBatch(folder, engine, numThreads);
+    if(summary.numInstances == 0){
+        printf("No instance found in %s.\n",folder);
+        return;
+    }
+    printf("%d instances: %d Oui, %d Non, %d unknown.\n",summary.numInstances,summary.numSat,summary.numUnsat,summary.numUnknown);
+}
+
+/**
+ * @brief A function writing the statistics gathered with --stats, in the file given by --stats=FILE or on the terminal.
+ */
+void displayStatistics(void){
+    if(!areStatisticsEnabled()){
+        return;
+    }
+    if(DEFAULT_STATS_FILE == NULL){
+        printStatistics(stdout);
+        return;
     }
+    FILE *file = fopen(DEFAULT_STATS_FILE,"w");
+    if(file == NULL){
+        printf("Could not write %s.\n",DEFAULT_STATS_FILE);
+        return;
+    }
+    printStatistics(file);
+    fclose(file);
 }
 
 int main(int argc, char* argv[]){
@@ -80,6 +545,21 @@ int main(int argc, char* argv[]){
             printf("-s  Tests separately all formula by depth [if not present: uses the global formula].\n");
             printf("-d  Only if -s is present. Explore the length in decreasing order. [if not present: in increasing order].\n");
             printf("-a  Only if -s is present. Computes a result for every length instead of stopping at the first positive result (default behaviour).\n");
+            printf("-i  Only if -s is present. Keeps an incremental solver and a formula shared by a window of lengths, so that what is learned on a length is reused for the next ones. Each window is twice as wide as the previous one.\n");
+            printf("-j N Only if -s or --separate is present. Checks N lengths (N graphs with --separate) at the same time, each in its own thread and context (0: one thread per processor) [if not present: 1].\n");
+            printf("--compile Compiles each graph file into a binary file next to it (\"G.dot\" into \"G%s\"), loaded instead of the graph file by the next runs as long as it is not older. Nothing is solved.\n",GRAPH_CACHE_EXTENSION);
+            printf("--batch DIR Answers like the global formula every instance under DIR (each folder holding .dot files, whose graphs are these files), one line per instance, in a single process. With -j N, solves N instances at the same time, the largest first, each thread keeping its own context.\n");
+            printf("--separate Computes the lengths of the paths of each graph alone, each graph in its own context, then keeps the common ones. Stops as soon as no length is common. With -j N, solves N graphs at the same time.\n");
+            printf("--portfolio Races several configurations (global formula or lengths one by one in increasing or decreasing order, with different encodings) in parallel threads, keeps the first answer and tells which configuration gave it. Replaces -s.\n");
+            printf("--amo=ENC Encodes the \"at most one\" constraints with ENC: pairwise, sequential (default), commander or product.\n");
+            printf("--encoding=ENC Encodes the node at each position of a path with ENC: onehot (default, one variable per node) or binary (ceil(log2(n)) variables).\n");
+            printf("--engine=ENG Decides with ENG: z3 (default, a SAT formula), native (a depth first search of the simple paths of each graph, without solver) or cdcl (the clauses of the formula given to an embedded solver, without Z3, one graph at a time).\n");
+            printf("--stats Displays at the end, as a JSON object on a single line, the time spent parsing, encoding, solving and reading the models, the size of each part of the formulae, the number of solver calls and the statistics of Z3. --stats=FILE writes it in FILE instead.\n");
+            printf("--timeout=MS Stops each check of Z3 (a length with -s, the whole formula otherwise) after MS milliseconds. An undecided check is reported as unknown, with the lengths proven and refuted so far. Only for Z3: the native and cdcl engines ignore it, see --budget.\n");
+            printf("--memory=MB Stops each check of Z3 once its solver uses more than MB megabytes, like --timeout. Only for Z3.\n");
+            printf("--conflicts=N Stops each check of Z3 after N conflicts, like --timeout. Only for Z3.\n");
+            printf("--budget=MS Gives up the whole query (every check, thread and instance with --batch) MS milliseconds after the start, whatever the engine: each check of Z3 gets at most the time left, and the lengths not decided when it runs out are reported as unknown, with the lengths proven and refuted so far.\n");
+            printf("--no-prune Keeps the variables of every node at every position, instead of skipping the pairs ruled out by the distances from the source and to the target.\n");
             printf("-o NAME Writes the output in \"NAME-lLENGTH.dot\" where LENGTH is the length of the solution. Writes several files in this format if both -s and -a are present. [if not present: \"result-lLENGTH.dot\".\n");
             numArg ++;
         }
@@ -107,6 +587,93 @@ int main(int argc, char* argv[]){
                 }
             }
         }
+        if(strncmp(argv[i],"--encoding=",11) == 0){
+            if(strcmp(argv[i]+11,"onehot") == 0){
+                setNodeEncoding(NODE_ONEHOT);
+            }else if(strcmp(argv[i]+11,"binary") == 0){
+                setNodeEncoding(NODE_BINARY);
+            }else{
+                printf("Unknown encoding %s, see -h for the available ones.\n",argv[i]+11);
+                return EXIT_FAILURE;
+            }
+            numArg ++;
+        }
+        if(strncmp(argv[i],"--amo=",6) == 0){
+            AmoEncoding encoding;
+            if(!getAmoEncodingFromName(argv[i]+6,&encoding)){
+                printf("Unknown encoding %s, see -h for the available ones.\n",argv[i]+6);
+                return EXIT_FAILURE;
+            }
+            setAmoEncoding(encoding);
+            numArg ++;
+        }
+        if(strcmp(argv[i],"-j") == 0 && i+1 < argc){
+            DEFAULT_NUM_THREADS = atoi(argv[i+1]);
+            numArg += 2;
+            i++;
+            continue;
+        }
+        if(strncmp(argv[i],"--engine=",9) == 0){
+            if(strcmp(argv[i]+9,"z3") == 0){
+                DEFAULT_NATIVE = false;
+                DEFAULT_CDCL = false;
+            }else if(strcmp(argv[i]+9,"native") == 0){
+                DEFAULT_NATIVE = true;
+                DEFAULT_CDCL = false;
+            }else if(strcmp(argv[i]+9,"cdcl") == 0){
+                DEFAULT_NATIVE = false;
+                DEFAULT_CDCL = true;
+            }else{
+                printf("Unknown engine %s, see -h for the available ones.\n",argv[i]+9);
+                return EXIT_FAILURE;
+            }
+            numArg ++;
+        }
+        if(strcmp(argv[i],"--portfolio") == 0){
+            DEFAULT_PORTFOLIO = true;
+            numArg ++;
+        }
+        if(strcmp(argv[i],"--compile") == 0){
+            DEFAULT_COMPILE = true;
+            numArg ++;
+        }
+        if(strcmp(argv[i],"--batch") == 0 && i+1 < argc){
+            DEFAULT_BATCH = argv[i+1];
+            numArg += 2;
+            i++;
+            continue;
+        }
+        if(strcmp(argv[i],"--separate") == 0){
+            DEFAULT_SEPARATE = true;
+            numArg ++;
+        }
+        if(strcmp(argv[i],"--stats") == 0 || strncmp(argv[i],"--stats=",8) == 0){
+            enableStatistics();
+            if(argv[i][7] == '='){
+                DEFAULT_STATS_FILE = argv[i]+8;
+            }
+            numArg ++;
+        }
+        if(strncmp(argv[i],"--timeout=",10) == 0){
+            DEFAULT_TIMEOUT = (unsigned int)strtoul(argv[i]+10,NULL,10);
+            numArg ++;
+        }
+        if(strncmp(argv[i],"--memory=",9) == 0){
+            DEFAULT_MEMORY = (unsigned int)strtoul(argv[i]+9,NULL,10);
+            numArg ++;
+        }
+        if(strncmp(argv[i],"--conflicts=",12) == 0){
+            DEFAULT_CONFLICTS = (unsigned int)strtoul(argv[i]+12,NULL,10);
+            numArg ++;
+        }
+        if(strncmp(argv[i],"--budget=",9) == 0){
+            DEFAULT_BUDGET = (unsigned int)strtoul(argv[i]+9,NULL,10);
+            numArg ++;
+        }
+        if(strcmp(argv[i],"--no-prune") == 0){
+            setPruning(false);
+            numArg ++;
+        }
         if(strcmp(argv[i],"-s") == 0){
             for(int j = 0 ; j < argc ; j++ ){
                 if( strcmp(argv[j],"-d") == 0){
@@ -117,57 +684,161 @@ int main(int argc, char* argv[]){
                     DEFAULT_DISP_a = true;
                     numArg ++;
                 }
+                if( strcmp(argv[j],"-i") == 0){
+                    DEFAULT_DISP_i = true;
+                    numArg ++;
+                }
             }
             DEFAULT_DISP_s = true;
             numArg ++;
         }
     }
+    setSolverLimits(DEFAULT_TIMEOUT, DEFAULT_MEMORY, DEFAULT_CONFLICTS);
+    startQueryBudget(DEFAULT_BUDGET);
+    if(DEFAULT_BATCH != NULL){
+        batchSAT(DEFAULT_BATCH);
+        displayStatistics();
+        return EXIT_SUCCESS;
+    }
     int numGraph = argc-numArg;
     if (numGraph < 1){
         printf("Please enter at least one graph, for example: ./equalPath -h graphs/assignment-instance/G1.dot graphs/assignment-instance/triangle.dot\n");
         return EXIT_SUCCESS;
     }
+    if(DEFAULT_COMPILE){
+        compileGraphs(argv+numArg,numGraph);
+        return EXIT_SUCCESS;
+    }
     Graph graph[numGraph];
     for(int i = 0 ; i < numGraph ; i++){
-        graph[i] = getGraphFromFile(argv[i+numArg]);
+        double start = getStatisticsClock();
+        graph[i] = loadGraph(argv[i+numArg]);
+        addPhaseTime(PHASE_PARSE, start);
         if(DEFAULT_DISP_G){
             printGraph(graph[i]);
         }
     }
-    Z3_context ctx = makeContext();
-    //Z3_ast formula = graphsToFullFormula(ctx,graph,numGraph);
-    if(DEFAULT_DISP_s){
-        int maxK = orderG(graph[0]); //vérifier si ça ne commence pas à l'indice 1
-        for(int i = 1; i < numGraph; i++){
-            maxK = mini(maxK,orderG(graph[i]));
+    int maxK = orderG(graph[0]); //vérifier si ça ne commence pas à l'indice 1
+    for(int i = 1; i < numGraph; i++){
+        maxK = mini(maxK,orderG(graph[i]));
+    }
+    Z3_context ctx = NULL;
+    if(DEFAULT_NATIVE || DEFAULT_CDCL){
+        // Every length at once when all are displayed, otherwise the candidate lengths are checked one by one.
+        bool *lengths = NULL;
+        if(DEFAULT_NATIVE && DEFAULT_DISP_s && DEFAULT_DISP_a){
+            lengths = graphsToSimplePathLengths(graph,numGraph,maxK-1);
+        }
+        if(lengths == NULL || isQueryBudgetExhausted()){
+            // The candidates are checked one by one, also when the search of every length was given up by the budget: it only tells the lengths found.
+            free(lengths);
+            lengths = computeCandidateLengths(graph,numGraph,maxK-1,getPruning(),NULL);
         }
+        if(DEFAULT_DISP_s){
+            LengthResult results[maxK];
+            for(int i = 0 ; i < maxK ; i++){
+                results[i] = LENGTH_UNKNOWN;
+            }
+            for(int j = 0 ; j < maxK ; j++){
+                int i = DEFAULT_DISP_d ? maxK-1-j : j;
+                printf("Pour k = %d : \n",i);
+                results[i] = nativeSAT(graph,numGraph,lengths,i);
+                if(results[i] == LENGTH_SAT && DEFAULT_DISP_a == false){
+                    break;
+                }
+            }
+            displayPartialResults(maxK, results);
+        }else{
+            // Same lengths as the global formula. The paths of the length found are kept by the search itself, which is only run once.
+            bool found = false, unknown = false;
+            LengthResult results[maxK];
+            results[0] = LENGTH_UNKNOWN;
+            for(int k = 1 ; k < maxK ; k++){
+                results[k] = lengths[k] ? LENGTH_UNDEF : LENGTH_UNSAT;
+            }
+            int* paths = NULL;
+            if(DEFAULT_DISP_P || DEFAULT_DISP_f){
+                paths = (int*)malloc(sizeof(int)*(numGraph*maxK+1));
+                if(paths == NULL){
+                    printf("Not enough memory to allocate paths in main\n");
+                    exit(EXIT_FAILURE);
+                }
+            }
+            for(int k = 1 ; k < maxK && !found && !unknown ; k++){
+                if(lengths[k]){
+                    found = engineHasPath(graph,numGraph,k,paths);
+                    unknown = !found && isQueryBudgetExhausted();
+                    results[k] = found ? LENGTH_SAT : unknown ? LENGTH_UNDEF : LENGTH_UNSAT;
+                    if(found){
+                        printf("Oui\n");
+                        if(paths != NULL){
+                            displayPaths(graph,numGraph,k,paths);
+                        }
+                    }
+                }
+            }
+            if(unknown){
+                printf("We don't know if the formula is satisfiable (%s).\n",BUDGET_EXHAUSTED_REASON);
+                displayPartialResults(maxK, results);
+            }else if(!found){
+                printf("Non\n");
+            }
+            free(paths);
+        }
+        free(lengths);
+    }else if(DEFAULT_PORTFOLIO){
+        portfolioSAT(graph,numGraph);
+    }else if(DEFAULT_SEPARATE){
+        separableSAT(graph,numGraph,maxK);
+    }else if(DEFAULT_DISP_s && DEFAULT_NUM_THREADS != 1){
+        parallelDepthSAT(graph,numGraph,maxK);
+    }else if(DEFAULT_DISP_s){
+        ctx = makeContext();
+        initNodeVariables(ctx,graph,numGraph);
+        LengthWindow window;
+        initLengthWindow(&window);
+        bool *lengths = computeCandidateLengths(graph,numGraph,maxK-1,getPruning(),NULL);
+        LengthResult results[maxK];
+        for(int i = 0 ; i < maxK ; i++){
+            results[i] = LENGTH_UNKNOWN;
+        }
+        LengthWindow *incremental = DEFAULT_DISP_i ? &window : NULL;
         if(DEFAULT_DISP_d){
             for(int i = maxK -1 ; i >= 0 ; i--){
-                Z3_ast formula = graphsToPathFormula(ctx,graph,numGraph,i);
-                printf("Pour k = %d : \n",i);
-                if(SAT(ctx,formula,graph,numGraph) && DEFAULT_DISP_a == false){
+                results[i] = depthSAT(ctx,incremental,graph,numGraph,i,maxK,lengths);
+                if(results[i] == LENGTH_SAT && DEFAULT_DISP_a == false){
                     break;
                 }
             }
         }else{
             for(int i = 0 ; i < maxK ; i++){
-                Z3_ast formula = graphsToPathFormula(ctx,graph,numGraph,i);
-                printf("Pour k = %d : \n",i);
-                if(SAT(ctx,formula,graph,numGraph) && DEFAULT_DISP_a == false){
+                results[i] = depthSAT(ctx,incremental,graph,numGraph,i,maxK,lengths);
+                if(results[i] == LENGTH_SAT && DEFAULT_DISP_a == false){
                     break;
                 }
             }
         }
+        displayPartialResults(maxK, results);
+        deleteLengthWindow(ctx, &window);
+        free(lengths);
     }else{
+        ctx = makeContext();
+        initNodeVariables(ctx,graph,numGraph);
         Z3_ast formula = graphsToFullFormula(ctx,graph,numGraph);
-        SAT(ctx,formula,graph,numGraph);
+        if(SAT(ctx,formula,graph,numGraph,ANY_LENGTH) == LENGTH_UNDEF){
+            displayGlobalPartialResults(graph,numGraph,maxK);
+        }
     }
     for(int i = 0 ; i < numGraph ; i++){
         deleteGraph(graph[i]);
     }
     printf("All graphs deleted.\n");
 
-    Z3_del_context(ctx);
-    printf("Context deleted, memory is now clean.\n");
+    if(ctx != NULL){
+        deleteNodeVariables();
+        Z3_del_context(ctx);
+        printf("Context deleted, memory is now clean.\n");
+    }
+    displayStatistics();
     return EXIT_SUCCESS;
 }
\ No newline at end of file